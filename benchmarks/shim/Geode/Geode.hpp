@@ -0,0 +1,6 @@
+#pragma once
+
+#include "loader/Mod.hpp"
+#include "loader/Log.hpp"
+#include "utils/Result.hpp"
+#include "utils/cocos.hpp"
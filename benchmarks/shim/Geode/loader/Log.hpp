@@ -0,0 +1,33 @@
+#pragma once
+
+#include <fmt/format.h>
+#include <cstdio>
+
+// Minimal stand-in for the geode logger, writes to stderr so it doesn't mix with benchmark output.
+
+namespace geode::log {
+    template <typename... Args>
+    void log(const char* level, fmt::format_string<Args...> str, Args&&... args) {
+        fmt::print(stderr, "[{}] {}\n", level, fmt::format(str, std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    void debug(fmt::format_string<Args...> str, Args&&... args) {
+        log("DEBUG", str, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void info(fmt::format_string<Args...> str, Args&&... args) {
+        log("INFO", str, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void warn(fmt::format_string<Args...> str, Args&&... args) {
+        log("WARN", str, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void error(fmt::format_string<Args...> str, Args&&... args) {
+        log("ERROR", str, std::forward<Args>(args)...);
+    }
+}
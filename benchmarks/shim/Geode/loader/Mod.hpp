@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cocos2d.h>
+#include "Log.hpp"
+#include "../utils/Result.hpp"
+
+namespace geode {
+    // only ever used by name in the benchmarked code
+    class Mod;
+    class Patch;
+    class Loader;
+
+    namespace prelude {
+        using namespace ::geode;
+        using namespace ::cocos2d;
+    }
+}
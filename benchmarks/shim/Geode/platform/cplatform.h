@@ -0,0 +1,6 @@
+#pragma once
+
+// Standalone builds define no GEODE_IS_* platform, see GLOBED_STANDALONE in defs/platform.hpp
+
+#define GEODE_CONCAT_IMPL(x, y) x##y
+#define GEODE_CONCAT(x, y) GEODE_CONCAT_IMPL(x, y)
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <stdexcept>
+
+#include <Geode/platform/cplatform.h>
+
+// Minimal stand-in for geode::Result, only implements what the benchmarked code uses.
+
+namespace geode {
+    namespace impl {
+        using DefaultValue = std::monostate;
+        using DefaultError = std::string;
+
+        template <typename T>
+        struct Success {
+            T value;
+        };
+
+        template <typename E>
+        struct Failure {
+            E error;
+        };
+    }
+
+    template <typename T = impl::DefaultValue, typename E = impl::DefaultError>
+    class Result {
+    public:
+        template <typename T2>
+        Result(impl::Success<T2>&& s) : m_data(std::in_place_index<0>, std::move(s.value)) {}
+
+        template <typename E2>
+        Result(impl::Failure<E2>&& f) : m_data(std::in_place_index<1>, std::move(f.error)) {}
+
+        bool isOk() const {
+            return m_data.index() == 0;
+        }
+
+        bool isErr() const {
+            return m_data.index() == 1;
+        }
+
+        explicit operator bool() const {
+            return this->isOk();
+        }
+
+        T& unwrap() & {
+            if (this->isErr()) throw std::runtime_error("called unwrap on an error Result");
+            return std::get<0>(m_data);
+        }
+
+        T&& unwrap() && {
+            if (this->isErr()) throw std::runtime_error("called unwrap on an error Result");
+            return std::get<0>(std::move(m_data));
+        }
+
+        E& unwrapErr() & {
+            if (this->isOk()) throw std::runtime_error("called unwrapErr on an ok Result");
+            return std::get<1>(m_data);
+        }
+
+        E&& unwrapErr() && {
+            if (this->isOk()) throw std::runtime_error("called unwrapErr on an ok Result");
+            return std::get<1>(std::move(m_data));
+        }
+
+        T unwrapOr(T other) const {
+            return this->isOk() ? std::get<0>(m_data) : std::move(other);
+        }
+
+        T value_or(T other) const {
+            return this->unwrapOr(std::move(other));
+        }
+
+    private:
+        std::variant<T, E> m_data;
+    };
+
+    inline impl::Success<impl::DefaultValue> Ok() {
+        return {};
+    }
+
+    template <typename T>
+    impl::Success<std::decay_t<T>> Ok(T&& value) {
+        return { std::forward<T>(value) };
+    }
+
+    template <typename E>
+    impl::Failure<std::decay_t<E>> Err(E&& error) {
+        return { std::forward<E>(error) };
+    }
+}
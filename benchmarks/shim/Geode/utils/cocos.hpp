@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cocos2d.h>
+
+namespace geode {
+    // only named in headers that the benchmarked code pulls in, never used
+    template <typename T>
+    class Ref;
+
+    namespace cocos {
+        template <typename T, bool Retain = false>
+        class CCArrayExt;
+    }
+
+    namespace cast {
+        template <typename Target, typename Original>
+        Target typeinfo_cast(Original obj) {
+            return dynamic_cast<Target>(obj);
+        }
+    }
+}
+
+// fields of GJUserScore that are read by data/types/gd.hpp
+class GJUserScore {
+public:
+    int m_playerCube = 0;
+    int m_color1 = 0;
+    int m_color2 = 0;
+    int m_color3 = 0;
+    bool m_glowEnabled = false;
+};
+
+enum class IconType {
+    Cube = 0,
+    Ship = 1,
+    Ball = 2,
+    Ufo = 3,
+    Wave = 4,
+    Robot = 5,
+    Spider = 6,
+    Swing = 7,
+    Jetpack = 8,
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+// UIBuilder is not used by any of the benchmarked code
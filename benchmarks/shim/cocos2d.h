@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+// Plain data versions of the cocos2d types that are serialized or interpolated.
+
+namespace cocos2d {
+    class CCPoint {
+    public:
+        CCPoint() : x(0.f), y(0.f) {}
+        CCPoint(float x, float y) : x(x), y(y) {}
+
+        CCPoint operator+(const CCPoint& other) const {
+            return CCPoint(x + other.x, y + other.y);
+        }
+
+        CCPoint operator-(const CCPoint& other) const {
+            return CCPoint(x - other.x, y - other.y);
+        }
+
+        CCPoint operator*(float a) const {
+            return CCPoint(x * a, y * a);
+        }
+
+        bool operator==(const CCPoint& other) const {
+            return x == other.x && y == other.y;
+        }
+
+        CCPoint lerp(const CCPoint& other, float alpha) const {
+            return *this * (1.f - alpha) + other * alpha;
+        }
+
+        float x, y;
+    };
+
+    class CCSize {
+    public:
+        CCSize() : width(0.f), height(0.f) {}
+        CCSize(float width, float height) : width(width), height(height) {}
+
+        bool operator==(const CCSize& other) const {
+            return width == other.width && height == other.height;
+        }
+
+        float width, height;
+    };
+
+    struct ccColor3B {
+        uint8_t r, g, b;
+
+        bool operator==(const ccColor3B& other) const = default;
+    };
+
+    struct ccColor4B {
+        uint8_t r, g, b, a;
+
+        bool operator==(const ccColor4B& other) const = default;
+    };
+
+    inline ccColor3B ccc3(uint8_t r, uint8_t g, uint8_t b) {
+        return ccColor3B { r, g, b };
+    }
+
+    inline ccColor4B ccc4(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+        return ccColor4B { r, g, b, a };
+    }
+
+    class CCObject;
+    class CCNode;
+    class CCLabelBMFont;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+    using clock = std::chrono::steady_clock;
+
+    struct Result {
+        std::string group;
+        std::string name;
+        size_t iterations;      // iterations per sample
+        size_t samples;
+        double medianNs;        // per iteration
+        double minNs;
+        double maxNs;
+        size_t bytesPerIter;    // 0 if throughput doesn't make sense for this benchmark
+    };
+
+    struct Options {
+        std::string filter;
+        size_t samples = 20;
+        std::chrono::milliseconds sampleTime { 10 };
+        std::chrono::milliseconds warmupTime { 50 };
+    };
+
+    // Prevents the compiler from optimizing away a value or the computation that produced it
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    class Runner {
+    public:
+        Runner(const Options& options) : options(options) {}
+
+        // Runs `func` repeatedly and records the time it takes per call.
+        template <typename F>
+        void run(std::string_view group, std::string_view name, F&& func, size_t bytesPerIter = 0) {
+            if (!this->matches(group, name)) return;
+
+            // warm up and figure out how many iterations fit in one sample
+            size_t iterations = 1;
+            auto warmupStart = clock::now();
+
+            while (true) {
+                auto start = clock::now();
+                for (size_t i = 0; i < iterations; i++) {
+                    func();
+                }
+                auto took = clock::now() - start;
+
+                if (took >= options.sampleTime) {
+                    if (clock::now() - warmupStart >= options.warmupTime) break;
+                } else {
+                    iterations *= 2;
+                }
+            }
+
+            std::vector<double> perIter;
+            perIter.reserve(options.samples);
+
+            for (size_t s = 0; s < options.samples; s++) {
+                auto start = clock::now();
+                for (size_t i = 0; i < iterations; i++) {
+                    func();
+                }
+                auto took = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+                perIter.push_back(took / iterations);
+            }
+
+            std::sort(perIter.begin(), perIter.end());
+
+            this->record(Result {
+                .group = std::string(group),
+                .name = std::string(name),
+                .iterations = iterations,
+                .samples = options.samples,
+                .medianNs = perIter[perIter.size() / 2],
+                .minNs = perIter.front(),
+                .maxNs = perIter.back(),
+                .bytesPerIter = bytesPerIter,
+            });
+        }
+
+        const std::vector<Result>& getResults() const {
+            return results;
+        }
+
+    private:
+        Options options;
+        std::vector<Result> results;
+
+        bool matches(std::string_view group, std::string_view name) const;
+        void record(Result&& result);
+    };
+
+    void registerDataBenchmarks(Runner& runner);
+    void registerCryptoBenchmarks(Runner& runner);
+    void registerInterpolatorBenchmarks(Runner& runner);
+    void registerSimdBenchmarks(Runner& runner);
+    void registerQueueBenchmarks(Runner& runner);
+}
@@ -0,0 +1,59 @@
+#include "bench.hpp"
+
+#include <fmt/format.h>
+
+#include <crypto/box.hpp>
+#include <crypto/chacha_secret_box.hpp>
+#include <crypto/secret_box.hpp>
+
+using namespace util::data;
+
+namespace {
+    // ping sized, a typical level data packet, and something close to the biggest packets we send
+    constexpr size_t PAYLOAD_SIZES[] = {64, 1024, 16384};
+
+    template <typename Box>
+    void benchBox(bench::Runner& runner, const char* name, Box& box) {
+        for (size_t size : PAYLOAD_SIZES) {
+            bytevector buffer(size + Box::PREFIX_LEN, 0x42);
+
+            runner.run("crypto", fmt::format("{}/encrypt/{}", name, size), [&] {
+                bench::doNotOptimize(box.encryptInPlace(buffer.data(), size));
+            }, size);
+
+            // decrypting in place destroys the ciphertext, so decrypt from a pristine copy every time
+            auto ciphertext = buffer;
+            box.encryptInPlace(ciphertext.data(), size);
+
+            bytevector plaintext(size + Box::PREFIX_LEN);
+            runner.run("crypto", fmt::format("{}/decrypt/{}", name, size), [&] {
+                bench::doNotOptimize(box.decryptInto(ciphertext.data(), plaintext.data(), ciphertext.size()));
+            }, size);
+        }
+    }
+}
+
+void bench::registerCryptoBenchmarks(Runner& runner) {
+    // talk to ourselves, the shared key is computed the same way
+    CryptoBox box;
+    box.setPeerKey(box.getPublicKey());
+
+    benchBox(runner, "CryptoBox", box);
+
+    // the path GameSocket uses for outgoing packets
+    for (size_t size : PAYLOAD_SIZES) {
+        bytevector buffer(size + CryptoBox::PREFIX_LEN, 0x42);
+
+        runner.run("crypto", fmt::format("CryptoBox/encryptWithHeadroom/{}", size), [&] {
+            bench::doNotOptimize(box.encryptWithHeadroom(buffer.data(), size));
+        }, size);
+    }
+
+    bytevector key(SecretBox::KEY_LEN, 0x13);
+
+    SecretBox secretBox(key);
+    benchBox(runner, "SecretBox", secretBox);
+
+    ChaChaSecretBox chachaBox(key);
+    benchBox(runner, "ChaChaSecretBox", chachaBox);
+}
@@ -0,0 +1,281 @@
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <fmt/format.h>
+
+#include <data/packets/all.hpp>
+#include <game/player_data_stream.hpp>
+
+using namespace cocos2d;
+
+namespace {
+    // roughly a full level
+    constexpr size_t PLAYER_COUNT = 64;
+
+    SpecificIconData makeIconData(int seed) {
+        SpecificIconData data {};
+        data.position = CCPoint(seed * 30.f, 105.f + seed);
+        data.rotation = seed * 3.f;
+        data.iconType = PlayerIconType::Cube;
+        data.isVisible = true;
+        data.isGrounded = seed % 2 == 0;
+
+        return data;
+    }
+
+    PlayerData makePlayerData(int seed) {
+        PlayerData data {};
+        data.timestamp = seed * 0.033f;
+        data.player1 = makeIconData(seed);
+        data.player2 = makeIconData(seed + 1);
+        data.currentPercentage = 0.5f;
+        data.isDualMode = seed % 4 == 0;
+
+        return data;
+    }
+
+    PlayerAccountData makeAccountData(int seed) {
+        return PlayerAccountData(100000 + seed, 200000 + seed, fmt::format("player{}", seed), PlayerIconData::DEFAULT_ICONS);
+    }
+
+    template <typename P>
+    void benchPacket(bench::Runner& runner, const P& packet, std::string_view variant = "") {
+        std::string name = variant.empty() ? std::string(P::PACKET_NAME) : fmt::format("{}/{}", P::PACKET_NAME, variant);
+
+        ByteBuffer buf;
+        packet.encode(buf);
+        auto encoded = buf.data();
+
+        runner.run("packets", fmt::format("encode/{}", name), [&] {
+            buf.clear();
+            packet.encode(buf);
+            bench::doNotOptimize(buf.size());
+        }, encoded.size());
+
+        // decode the same way GameSocket does, from a borrowed buffer into a reused instance
+        P decoded;
+        auto check = ByteBuffer::borrow(encoded.data(), encoded.size());
+        if (decoded.decode(check).isErr()) {
+            fmt::print(stderr, "skipping decode/{}: packet does not survive a round trip\n", name);
+            return;
+        }
+
+        runner.run("packets", fmt::format("decode/{}", name), [&] {
+            auto in = ByteBuffer::borrow(encoded.data(), encoded.size());
+            bench::doNotOptimize(decoded.decode(in).isOk());
+        }, encoded.size());
+    }
+
+    template <typename P>
+    void benchPacket(bench::Runner& runner) {
+        if constexpr (std::is_default_constructible_v<P>) {
+            P packet;
+            benchPacket(runner, packet);
+        }
+    }
+
+    void failStream(const char* message) {
+        fmt::print(stderr, "player data stream check failed: {}\n", message);
+        std::abort();
+    }
+
+    // Runs a stream through a lost baseline: after `requestKeyframe`, no delta may be sent until a new state is acknowledged.
+    // Any deviation aborts the run.
+    void keyframeRequestOnce(PlayerDataStream& stream) {
+        stream.reset();
+
+        auto first = stream.makePacket(makePlayerData(1));
+        stream.acknowledge(first->seq);
+
+        if (stream.makePacket(makePlayerData(2))->data.isFirst()) {
+            failStream("no delta sent against an acknowledged state");
+        }
+
+        stream.requestKeyframe();
+
+        std::shared_ptr<PlayerDataDeltaPacket> last;
+        for (int i = 0; i < 4; i++) {
+            last = stream.makePacket(makePlayerData(3 + i));
+            if (!last->data.isFirst()) {
+                failStream("delta sent after a keyframe request");
+            }
+        }
+
+        // a late ack of a state from before the request must not bring back the old baseline
+        stream.acknowledge(first->seq);
+        if (!stream.makePacket(makePlayerData(7))->data.isFirst()) {
+            failStream("delta sent against a state from before the keyframe request");
+        }
+
+        stream.acknowledge(last->seq);
+        if (stream.makePacket(makePlayerData(8))->data.isFirst()) {
+            failStream("no delta sent after the keyframe was acknowledged");
+        }
+    }
+
+    // the generic reflection encoder is measured by the globed2-bench-generic build, which has the fixed-size fast path compiled out
+    template <typename T>
+    void benchValue(bench::Runner& runner, const char* name, const T& value) {
+        const char* path = ByteBuffer::FIXED_SIZE_FAST_PATH ? "fixed" : "generic";
+
+        ByteBuffer buf;
+        buf.writeValue(value);
+        auto encoded = buf.data();
+
+        runner.run("values", fmt::format("encode/{}/{}", name, path), [&] {
+            buf.clear();
+            buf.writeValue(value);
+            bench::doNotOptimize(buf.size());
+        }, encoded.size());
+
+        runner.run("values", fmt::format("decode/{}/{}", name, path), [&] {
+            auto in = ByteBuffer::borrow(encoded.data(), encoded.size());
+            bench::doNotOptimize(in.readValue<T>().isOk());
+        }, encoded.size());
+    }
+}
+
+void bench::registerDataBenchmarks(Runner& runner) {
+    benchValue(runner, "PlayerData", makePlayerData(1));
+    benchValue(runner, "PlayerAccountData", makeAccountData(1));
+    benchValue(runner, "PlayerIconData", PlayerIconData::DEFAULT_ICONS);
+
+    // packets with realistic contents
+    {
+        PlayerDataPacket packet(makePlayerData(1));
+        benchPacket(runner, packet);
+    }
+
+    {
+        LevelDataPacket packet;
+        for (size_t i = 0; i < PLAYER_COUNT; i++) {
+            packet.players.emplace_back(i, makePlayerData(i));
+        }
+
+        benchPacket(runner, packet);
+    }
+
+    {
+        PlayerDataStream stream;
+        runner.run("stream", "keyframe-request", [&] {
+            keyframeRequestOnce(stream);
+        });
+    }
+
+    {
+        PlayerDataDeltaPacket keyframe(0, makePlayerData(1));
+        benchPacket(runner, keyframe, "keyframe");
+
+        PlayerDataDeltaPacket delta(1, PlayerDataDelta::diff(0, makePlayerData(1), makePlayerData(2)));
+        benchPacket(runner, delta, "delta");
+    }
+
+    {
+        AckedLevelDataPacket packet;
+        packet.ack = 1;
+        for (size_t i = 0; i < PLAYER_COUNT; i++) {
+            packet.data.players.emplace_back(i, makePlayerData(i));
+        }
+
+        benchPacket(runner, packet, "exact");
+
+        packet.data.codec.precision = 4;
+        packet.data.codec.origin = packet.data.players[PLAYER_COUNT / 2].data.player1.position;
+        benchPacket(runner, packet, "quantized");
+    }
+
+    {
+        LevelPlayerMetadataPacket packet;
+        for (size_t i = 0; i < PLAYER_COUNT; i++) {
+            packet.players.emplace_back(i, PlayerMetadata { .localBest = 50, .attempts = (int32_t) i });
+        }
+
+        benchPacket(runner, packet);
+    }
+
+    {
+        PlayerProfilesPacket packet;
+        for (size_t i = 0; i < PLAYER_COUNT; i++) {
+            packet.players.push_back(makeAccountData(i));
+        }
+
+        benchPacket(runner, packet);
+    }
+
+    // everything else, default constructed
+
+    // client
+    benchPacket<AdminAuthPacket>(runner);
+    benchPacket<AdminSendNoticePacket>(runner);
+    benchPacket<AdminDisconnectPacket>(runner);
+    benchPacket<AdminGetUserStatePacket>(runner);
+    benchPacket<AdminUpdateUserPacket>(runner);
+
+    benchPacket<PingPacket>(runner);
+    benchPacket<CryptoHandshakeStartPacket>(runner);
+    benchPacket<KeepalivePacket>(runner);
+    benchPacket<LoginPacket>(runner);
+    benchPacket<ClaimThreadPacket>(runner);
+    benchPacket<DisconnectPacket>(runner);
+    benchPacket<KeepaliveTCPPacket>(runner);
+    benchPacket<ConnectionTestPacket>(runner);
+
+    benchPacket<RequestPlayerProfilesPacket>(runner);
+    benchPacket<LevelJoinPacket>(runner);
+    benchPacket<LevelLeavePacket>(runner);
+    benchPacket<PlayerMetadataPacket>(runner);
+    benchPacket<ChatMessagePacket>(runner);
+
+    benchPacket<SyncIconsPacket>(runner);
+    benchPacket<RequestGlobalPlayerListPacket>(runner);
+    benchPacket<RequestLevelListPacket>(runner);
+    benchPacket<RequestPlayerCountPacket>(runner);
+    benchPacket<UpdatePlayerStatusPacket>(runner);
+
+    benchPacket<CreateRoomPacket>(runner);
+    benchPacket<JoinRoomPacket>(runner);
+    benchPacket<LeaveRoomPacket>(runner);
+    benchPacket<RequestRoomPlayerListPacket>(runner);
+    benchPacket<UpdateRoomSettingsPacket>(runner);
+    benchPacket<RoomSendInvitePacket>(runner);
+    benchPacket<RequestRoomListPacket>(runner);
+
+    // server
+    benchPacket<AdminAuthSuccessPacket>(runner);
+    benchPacket<AdminErrorPacket>(runner);
+    benchPacket<AdminUserDataPacket>(runner);
+    benchPacket<AdminSuccessMessagePacket>(runner);
+    benchPacket<AdminAuthFailedPacket>(runner);
+
+    benchPacket<PingResponsePacket>(runner);
+    benchPacket<CryptoHandshakeResponsePacket>(runner);
+    benchPacket<KeepaliveResponsePacket>(runner);
+    benchPacket<ServerDisconnectPacket>(runner);
+    benchPacket<LoggedInPacket>(runner);
+    benchPacket<LoginFailedPacket>(runner);
+    benchPacket<ProtocolMismatchPacket>(runner);
+    benchPacket<KeepaliveTCPResponsePacket>(runner);
+    benchPacket<ClaimThreadFailedPacket>(runner);
+    benchPacket<LoginRecoveryFailecPacket>(runner);
+    benchPacket<ServerNoticePacket>(runner);
+    benchPacket<ServerBannedPacket>(runner);
+    benchPacket<ServerMutedPacket>(runner);
+    benchPacket<ConnectionTestResponsePacket>(runner);
+
+    benchPacket<VoiceBroadcastPacket>(runner);
+    benchPacket<ChatMessageBroadcastPacket>(runner);
+
+    benchPacket<GlobalPlayerListPacket>(runner);
+    benchPacket<LevelListPacket>(runner);
+    benchPacket<LevelPlayerCountPacket>(runner);
+    benchPacket<RolesUpdatedPacket>(runner);
+
+    benchPacket<RoomCreatedPacket>(runner);
+    benchPacket<RoomJoinedPacket>(runner);
+    benchPacket<RoomJoinFailedPacket>(runner);
+    benchPacket<RoomPlayerListPacket>(runner);
+    benchPacket<RoomInfoPacket>(runner);
+    benchPacket<RoomInvitePacket>(runner);
+    benchPacket<RoomListPacket>(runner);
+    benchPacket<RoomCreateFailedPacket>(runner);
+}
@@ -0,0 +1,75 @@
+#include "bench.hpp"
+
+#include <fmt/format.h>
+
+#include <game/interpolator.hpp>
+
+using namespace cocos2d;
+
+namespace {
+    constexpr size_t PLAYER_COUNTS[] = {1, 10, 50, 100, 250, 1000};
+
+    // the server sends data at 30tps, the game renders at 240fps
+    constexpr float SERVER_DELTA = 1.f / 30.f;
+    constexpr float FRAME_DELTA = 1.f / 240.f;
+
+    PlayerData makePlayerData(int id, float timestamp) {
+        PlayerData data {};
+        data.timestamp = timestamp;
+        data.player1.position = CCPoint(timestamp * 311.f, 105.f + id);
+        data.player1.rotation = timestamp * 90.f;
+        data.player1.iconType = PlayerIconType::Cube;
+        data.player1.isVisible = true;
+        data.player2 = data.player1;
+
+        return data;
+    }
+}
+
+void bench::registerInterpolatorBenchmarks(Runner& runner) {
+    for (bool platformer : {false, true}) {
+        for (size_t count : PLAYER_COUNTS) {
+            PlayerInterpolator interpolator(InterpolatorSettings {
+                .realtime = false,
+                .isPlatformer = platformer,
+                .expectedDelta = SERVER_DELTA,
+            });
+
+            for (size_t i = 0; i < count; i++) {
+                interpolator.addPlayer(i);
+            }
+
+            float timestamp = 0.f;
+            float updateCounter = 0.f;
+            size_t frame = 0;
+
+            // one iteration is one rendered frame, every 8th frame brings new data for every player
+            auto nextFrame = [&] {
+                if (frame++ % 8 == 0) {
+                    timestamp += SERVER_DELTA;
+                    updateCounter += 1.f;
+
+                    for (size_t i = 0; i < count; i++) {
+                        interpolator.updatePlayer(i, makePlayerData(i, timestamp), updateCounter);
+                    }
+                }
+
+                interpolator.tick(FRAME_DELTA);
+            };
+
+            runner.run("interpolator", fmt::format("tick/{}/{}", platformer ? "platformer" : "classic", count), [&] {
+                nextFrame();
+                bench::doNotOptimize(interpolator.getPlayerState(0));
+            });
+
+            // what the game actually does every frame, tick and then read the state of every player
+            runner.run("interpolator", fmt::format("frame/{}/{}", platformer ? "platformer" : "classic", count), [&] {
+                nextFrame();
+
+                for (size_t i = 0; i < count; i++) {
+                    bench::doNotOptimize(interpolator.getPlayerState(i).player1.position);
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <fmt/format.h>
+
+#include <crypto/box.hpp>
+
+using namespace bench;
+
+bool Runner::matches(std::string_view group, std::string_view name) const {
+    if (options.filter.empty()) return true;
+
+    auto full = fmt::format("{}/{}", group, name);
+    return full.find(options.filter) != std::string::npos;
+}
+
+void Runner::record(Result&& result) {
+    if (result.bytesPerIter > 0) {
+        double mbps = (double)result.bytesPerIter / result.medianNs * 1e9 / (1024.0 * 1024.0);
+        fmt::print("{:<10} {:<50} {:>12.1f} ns/iter {:>10.1f} MiB/s\n", result.group, result.name, result.medianNs, mbps);
+    } else {
+        fmt::print("{:<10} {:<50} {:>12.1f} ns/iter\n", result.group, result.name, result.medianNs);
+    }
+
+    results.push_back(std::move(result));
+}
+
+static std::string escapeJson(std::string_view in) {
+    std::string out;
+    for (char c : in) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+
+    return out;
+}
+
+static std::string toJson(const std::vector<Result>& results) {
+    std::string out = "{\n  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        auto& r = results[i];
+
+        out += fmt::format(
+            "    {{\"group\": \"{}\", \"name\": \"{}\", \"iterations\": {}, \"samples\": {}, \"median_ns\": {:.3f}, \"min_ns\": {:.3f}, \"max_ns\": {:.3f}, \"bytes_per_iter\": {}}}{}\n",
+            escapeJson(r.group), escapeJson(r.name), r.iterations, r.samples, r.medianNs, r.minNs, r.maxNs, r.bytesPerIter,
+            i + 1 == results.size() ? "" : ","
+        );
+    }
+
+    out += "  ]\n}\n";
+    return out;
+}
+
+static void printUsage(const char* argv0) {
+    fmt::print(
+        "usage: {} [--filter <substring>] [--samples <n>] [--json <path>]\n"
+        "  --filter   only run benchmarks whose group/name contains the substring\n"
+        "  --samples  amount of samples per benchmark (default 20)\n"
+        "  --json     also write the results to the given file as json\n",
+        argv0
+    );
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--samples") == 0 && hasValue) {
+            options.samples = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    CryptoBox::initLibrary();
+
+    Runner runner(options);
+    registerDataBenchmarks(runner);
+    registerCryptoBenchmarks(runner);
+    registerInterpolatorBenchmarks(runner);
+    registerSimdBenchmarks(runner);
+    registerQueueBenchmarks(runner);
+
+    if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        file << toJson(runner.getResults());
+    }
+
+    return 0;
+}
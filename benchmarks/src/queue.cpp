@@ -0,0 +1,89 @@
+#include "bench.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+
+#include <util/collections.hpp>
+
+using util::collections::SpscQueue;
+
+namespace {
+    // 20ms of 48khz mono audio, what a single opus frame decodes into
+    constexpr size_t FRAME_SAMPLES = 960;
+    // how many elements pass through the queue in one iteration of the stress test
+    constexpr uint32_t STRESS_ELEMENTS = 1 << 20;
+
+    // One thread pushes an increasing sequence in uneven chunks while the other pops it in differently sized chunks,
+    // so the positions wrap around at every possible offset. Any lost, duplicated or reordered element aborts the run.
+    void stressOnce(SpscQueue<uint32_t>& queue) {
+        std::thread producer([&queue] {
+            uint32_t chunk[97];
+            uint32_t next = 0;
+
+            while (next < STRESS_ELEMENTS) {
+                size_t count = std::min<uint32_t>(1 + next % 97, STRESS_ELEMENTS - next);
+                for (size_t i = 0; i < count; i++) {
+                    chunk[i] = next + i;
+                }
+
+                size_t pushed = queue.push(chunk, count);
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+
+                next += pushed;
+            }
+        });
+
+        uint32_t chunk[131];
+        uint32_t expected = 0;
+
+        while (expected < STRESS_ELEMENTS) {
+            size_t popped = queue.pop(chunk, 1 + expected % 131);
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+
+            for (size_t i = 0; i < popped; i++) {
+                if (chunk[i] != expected) {
+                    fmt::print(stderr, "spsc stress test failed: expected {}, got {}\n", expected, chunk[i]);
+                    std::abort();
+                }
+
+                expected++;
+            }
+        }
+
+        producer.join();
+
+        if (!queue.empty()) {
+            fmt::print(stderr, "spsc stress test failed: {} elements left over\n", queue.size());
+            std::abort();
+        }
+    }
+}
+
+void bench::registerQueueBenchmarks(Runner& runner) {
+    // uncontended, how the record queue is used
+    {
+        SpscQueue<float> queue(1 << 16);
+        std::vector<float> frame(FRAME_SAMPLES, 0.5f);
+
+        runner.run("queue", fmt::format("spsc/push+pop/{}", FRAME_SAMPLES), [&] {
+            queue.push(frame.data(), frame.size());
+            bench::doNotOptimize(queue.pop(frame.data(), frame.size()));
+        }, FRAME_SAMPLES * sizeof(float));
+    }
+
+    // contended, with the capacity small enough that both sides keep running into each other
+    for (size_t capacity : {64, 4096}) {
+        SpscQueue<uint32_t> queue(capacity);
+
+        runner.run("queue", fmt::format("spsc/stress/{}", capacity), [&] {
+            stressOnce(queue);
+        }, STRESS_ELEMENTS * sizeof(uint32_t));
+    }
+}
@@ -0,0 +1,106 @@
+#include "bench.hpp"
+
+#include <fmt/format.h>
+#include <cmath>
+#include <random>
+
+#include <platform/arch/x86/x86simd.hpp>
+#include <util/simd.hpp>
+
+using namespace globed::simd::x86;
+
+namespace {
+    // 20ms of 48khz mono audio, what a single opus frame decodes into
+    constexpr size_t FRAME_SAMPLES = 960;
+    constexpr size_t SAMPLE_COUNTS[] = {FRAME_SAMPLES, FRAME_SAMPLES * 10};
+
+    float pcmVolumeScalar(const float* pcm, size_t samples) {
+        double sum = 0.0;
+        for (size_t i = 0; i < samples; i++) {
+            sum += std::abs(pcm[i]);
+        }
+
+        return static_cast<float>(sum / samples);
+    }
+
+    void pcmMixScalar(float* dest, const float* src, size_t samples, float gain) {
+        for (size_t i = 0; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    // one value per player, the interpolator evaluates 6 of these every frame
+    constexpr size_t CURVE_COUNTS[] = {100, 1000};
+
+    void evalCubicScalar(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = ((c3[i] * t[i] + c2[i]) * t[i] + c1[i]) * t[i] + c0[i];
+        }
+    }
+}
+
+void bench::registerSimdBenchmarks(Runner& runner) {
+    const auto& features = getFeatures();
+
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    for (size_t samples : SAMPLE_COUNTS) {
+        std::vector<float> pcm(samples);
+        for (auto& s : pcm) s = dist(rng);
+
+        size_t bytes = samples * sizeof(float);
+
+        auto benchKernel = [&](const char* name, auto kernel) {
+            runner.run("simd", fmt::format("pcmVolume/{}/{}", name, samples), [&] {
+                bench::doNotOptimize(kernel(pcm.data(), samples));
+            }, bytes);
+        };
+
+        benchKernel("scalar", pcmVolumeScalar);
+        benchKernel("SSE", pcmVolumeSSE);
+        if (features.avx2) benchKernel("AVX2", pcmVolumeAVX2);
+        if (features.avx512dq) benchKernel("AVX512", pcmVolumeAVX512);
+        benchKernel("auto", util::simd::calcPcmVolume);
+
+        // mixing one speaker into the output buffer
+        std::vector<float> out(samples, 0.f);
+
+        auto benchMix = [&](const char* name, auto kernel) {
+            runner.run("simd", fmt::format("pcmMix/{}/{}", name, samples), [&] {
+                kernel(out.data(), pcm.data(), samples, 0.5f);
+                bench::doNotOptimize(out[0]);
+            }, bytes);
+        };
+
+        benchMix("scalar", pcmMixScalar);
+        benchMix("SSE", pcmMixSSE);
+        if (features.avx2) benchMix("AVX2", pcmMixAVX2);
+        if (features.avx512) benchMix("AVX512", pcmMixAVX512);
+        benchMix("auto", util::simd::mixPcm);
+    }
+
+    for (size_t count : CURVE_COUNTS) {
+        std::vector<float> c0(count), c1(count), c2(count), c3(count), t(count), out(count);
+        for (size_t i = 0; i < count; i++) {
+            c0[i] = dist(rng) * 1000.f;
+            c1[i] = dist(rng) * 10.f;
+            c2[i] = dist(rng);
+            c3[i] = dist(rng);
+            t[i] = std::abs(dist(rng));
+        }
+
+        auto benchCurve = [&](const char* name, auto kernel) {
+            runner.run("simd", fmt::format("evalCubic/{}/{}", name, count), [&] {
+                kernel(out.data(), c0.data(), c1.data(), c2.data(), c3.data(), t.data(), count);
+                bench::doNotOptimize(out[0]);
+            }, count * sizeof(float) * 6);
+        };
+
+        benchCurve("scalar", evalCubicScalar);
+        benchCurve("SSE", evalCubicSSE);
+        if (features.avx2) benchCurve("AVX2", evalCubicAVX2);
+        if (features.avx512) benchCurve("AVX512", evalCubicAVX512);
+        benchCurve("auto", util::simd::evalCubic);
+    }
+}
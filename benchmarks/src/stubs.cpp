@@ -0,0 +1,29 @@
+// Definitions that normally live in translation units the benchmarks don't build, because they depend on Geode.
+
+#include <cstdlib>
+
+#include <platform/arch/x86/x86simd.hpp>
+#include <util/debug.hpp>
+#include <util/simd.hpp>
+
+#if GLOBED_CAN_USE_SOURCE_LOCATION
+[[noreturn]] void util::debug::suicide(const std::source_location loc) {
+    std::abort();
+}
+#else
+[[noreturn]] void util::debug::suicide() {
+    std::abort();
+}
+#endif
+
+float util::simd::calcPcmVolume(const float* pcm, size_t samples) {
+    return globed::simd::x86::pcmVolume(pcm, samples);
+}
+
+void util::simd::mixPcm(float* dest, const float* src, size_t samples, float gain) {
+    globed::simd::x86::pcmMix(dest, src, samples, gain);
+}
+
+void util::simd::evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+    globed::simd::x86::evalCubic(out, c0, c1, c2, c3, t, count);
+}
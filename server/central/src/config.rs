@@ -68,6 +68,10 @@ const fn default_tps() -> u32 {
     30
 }
 
+const fn default_player_data_precision() -> u8 {
+    4 // 1/16 of a unit
+}
+
 const fn default_chat_burst_limit() -> u32 {
     2
 }
@@ -155,6 +159,8 @@ pub struct ServerConfig {
     // game stuff
     #[serde(default = "default_tps")]
     pub tps: u32,
+    #[serde(default = "default_player_data_precision")]
+    pub player_data_precision: u8,
 
     #[serde(default = "default_string")]
     pub admin_webhook_url: String,
@@ -29,6 +29,7 @@ pub async fn boot(
     let bdata = GameServerBootData {
         protocol: PROTOCOL_VERSION,
         tps: config.tps,
+        player_data_precision: config.player_data_precision,
         maintenance: config.maintenance,
         secret_key2: config.secret_key2.clone(),
         token_expiry: config.token_expiry,
@@ -3,6 +3,19 @@ use crate::*;
 #[derive(Copy, Clone, Default, Debug)]
 pub struct FiniteF32(f32);
 
+impl FiniteF32 {
+    /// returns `None` if the value is NaN or infinite
+    #[inline]
+    pub fn new(val: f32) -> Option<Self> {
+        val.is_finite().then_some(Self(val))
+    }
+
+    #[inline]
+    pub const fn get(self) -> f32 {
+        self.0
+    }
+}
+
 impl Encodable for FiniteF32 {
     fn encode(&self, buf: &mut ByteBuffer) {
         buf.write_f32(self.0);
@@ -63,6 +63,7 @@ pub struct ClientThread {
     pub user_role: SyncMutex<ComputedRole>,
 
     pub fragmentation_limit: AtomicU16,
+    pub player_data_precision: u8,
 
     pub is_authorized_admin: AtomicBool,
 
@@ -73,6 +74,7 @@ pub struct ClientThread {
     rate_limiter: LockfreeMutCell<SimpleRateLimiter>,
     voice_rate_limiter: LockfreeMutCell<SimpleRateLimiter>,
     chat_rate_limiter: Option<LockfreeMutCell<SimpleRateLimiter>>,
+    player_data_history: LockfreeMutCell<PlayerDataHistory>,
 
     pub destruction_notify: Arc<Notify>,
 }
@@ -86,7 +88,7 @@ impl ClientThread {
     pub fn from_unauthorized(thread: UnauthorizedThread) -> Self {
         let game_server = thread.game_server;
 
-        let (rate_limiter, voice_rate_limiter, chat_rate_limiter) = {
+        let (rate_limiter, voice_rate_limiter, chat_rate_limiter, player_data_precision) = {
             let conf = game_server.bridge.central_conf.lock();
 
             (
@@ -100,6 +102,7 @@ impl ClientThread {
                 } else {
                     None
                 },
+                conf.player_data_precision,
             )
         };
 
@@ -123,6 +126,7 @@ impl ClientThread {
             user_role: SyncMutex::new(user_role),
 
             fragmentation_limit: thread.fragmentation_limit,
+            player_data_precision,
 
             is_authorized_admin: AtomicBool::new(false),
 
@@ -133,6 +137,7 @@ impl ClientThread {
             rate_limiter: LockfreeMutCell::new(rate_limiter),
             voice_rate_limiter: LockfreeMutCell::new(voice_rate_limiter),
             chat_rate_limiter: chat_rate_limiter.map(LockfreeMutCell::new),
+            player_data_history: LockfreeMutCell::new(PlayerDataHistory::default()),
 
             destruction_notify: thread.destruction_notify
         }
@@ -399,6 +404,10 @@ impl ClientThread {
         let header = data.read_packet_header()?;
 
         // by far the most common packet, so we try it early
+        if header.packet_id == PlayerDataDeltaPacket::PACKET_ID {
+            return self.handle_player_data_delta(&mut data).await;
+        }
+
         if header.packet_id == PlayerDataPacket::PACKET_ID {
             return self.handle_player_data(&mut data).await;
         }
@@ -437,6 +446,7 @@ impl ClientThread {
             LevelJoinPacket::PACKET_ID => self.handle_level_join(&mut data).await,
             LevelLeavePacket::PACKET_ID => self.handle_level_leave(&mut data).await,
             PlayerDataPacket::PACKET_ID => self.handle_player_data(&mut data).await,
+            PlayerDataDeltaPacket::PACKET_ID => self.handle_player_data_delta(&mut data).await,
             PlayerMetadataPacket::PACKET_ID => self.handle_player_metadata(&mut data).await,
 
             VoicePacket::PACKET_ID => self.handle_voice(&mut data).await,
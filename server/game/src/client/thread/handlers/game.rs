@@ -12,6 +12,9 @@ impl ClientThread {
         let old_level = self.level_id.swap(packet.level_id, Ordering::Relaxed);
         let room_id = self.room_id.load(Ordering::Relaxed);
 
+        // safety: only we can use the history.
+        unsafe { self.player_data_history.get_mut() }.clear();
+
         self.game_server.state.room_manager.with_any(room_id, |pm| {
             if old_level != 0 {
                 pm.manager.remove_from_level(old_level, account_id);
@@ -29,6 +32,10 @@ impl ClientThread {
         let account_id = gs_needauth!(self);
 
         let level_id = self.level_id.swap(0, Ordering::Relaxed);
+
+        // safety: only we can use the history.
+        unsafe { self.player_data_history.get_mut() }.clear();
+
         if level_id != 0 {
             let room_id = self.room_id.load(Ordering::Relaxed);
 
@@ -41,6 +48,31 @@ impl ClientThread {
     });
 
     gs_handler!(self, handle_player_data, PlayerDataPacket, packet, {
+        self.on_player_data(Some(&packet.data), None).await
+    });
+
+    gs_handler!(self, handle_player_data_delta, PlayerDataDeltaPacket, packet, {
+        // safety: only we can use the history.
+        let history = unsafe { self.player_data_history.get_mut() };
+
+        let data = match packet.data {
+            Either::First(keyframe) => keyframe,
+            Either::Second(delta) => match history.get(delta.baseline) {
+                Some(base) => delta.apply(base)?,
+                // we don't have the baseline anymore, still send the level data but ask the client for a keyframe
+                None => return self.on_player_data(None, Some(packet.seq)).await,
+            },
+        };
+
+        history.insert(packet.seq, &data);
+
+        self.on_player_data(Some(&data), Some(packet.seq)).await
+    });
+
+    /// store the player data and respond with the data of everyone else on the level.
+    /// if `ack` is set, the response is an `AckedLevelDataPacket` instead of a `LevelDataPacket`.
+    /// `data` is `None` if the client sent a delta we couldn't apply, in which case the response asks for a keyframe.
+    async fn on_player_data(&self, data: Option<&PlayerData>, ack: Option<u16>) -> Result<()> {
         let account_id = gs_needauth!(self);
 
         let level_id = self.level_id.load(Ordering::Relaxed);
@@ -50,30 +82,63 @@ impl ClientThread {
 
         let room_id = self.room_id.load(Ordering::Relaxed);
 
-        let written_players = self.game_server.state.room_manager.with_any(room_id, |pm| {
-            pm.manager.set_player_data(account_id, &packet.data);
+        let request_keyframe = data.is_none();
+
+        let (written_players, precise_positions, origin) = self.game_server.state.room_manager.with_any(room_id, |pm| {
+            // without new data, quantize relative to the last position we know
+            let origin = match data {
+                Some(data) => {
+                    pm.manager.set_player_data(account_id, data);
+                    data.player1.position
+                }
+                None => pm.manager.get_player_data(account_id).map(|p| p.data.player1.position).unwrap_or_default(),
+            };
+
             // this unwrap should be safe and > 0 given that self.level_id != 0, but we leave a default just in case
-            pm.manager.get_player_count_on_level(level_id).unwrap_or(1) - 1
+            let count = pm.manager.get_player_count_on_level(level_id).unwrap_or(1) - 1;
+            (count, pm.settings.flags.precise_positions, origin)
         });
 
-        // no one else on the level, no need to send a response packet
-        if written_players == 0 {
+        // no one else on the level, no need to send a response packet, unless we have to ask for a keyframe
+        if written_players == 0 && !request_keyframe {
             return Ok(());
         }
 
-        let calc_size = size_of_types!(u32) + size_of_types!(AssociatedPlayerData) * written_players;
+        // acked level data is quantized relative to our own position, unless the room asks for exact positions
+        let codec = ack.map(|_| PlayerDataCodec::new(if precise_positions { 0 } else { self.player_data_precision }, origin));
+
+        let (header_size, player_size) = if codec.is_some() {
+            (
+                size_of_types!(u16, bool, PlayerDataCodec),
+                size_of_types!(AssociatedPlayerData).max(size_of_types!(QuantizedAssociatedPlayerData)),
+            )
+        } else {
+            (0, size_of_types!(AssociatedPlayerData))
+        };
+
+        let calc_size = header_size + size_of_types!(u32) + player_size * written_players;
         let fragmentation_limit = self.fragmentation_limit.load(Ordering::Relaxed) as usize;
 
         // if we can fit in one packet, then just send it as-is
         if calc_size <= fragmentation_limit {
-            self.send_packet_alloca_with::<LevelDataPacket, _>(calc_size, |buf| {
+            let encode_fn = |buf: &mut FastByteBuffer| {
+                if let (Some(ack), Some(codec)) = (ack, &codec) {
+                    buf.write_u16(ack);
+                    buf.write_bool(request_keyframe);
+                    buf.write_value(codec);
+                }
+
                 self.game_server.state.room_manager.with_any(room_id, |pm| {
                     buf.write_list_with(written_players, |buf| {
                         pm.manager.for_each_player_on_level(
                             level_id,
                             |player, count, buf| {
                                 if count < written_players && player.account_id != account_id {
-                                    buf.write_value(&player.to_borrowed_associated_data());
+                                    let data = player.to_borrowed_associated_data();
+                                    match &codec {
+                                        Some(codec) => codec.write_player(buf, &data),
+                                        None => buf.write_value(&data),
+                                    }
                                     true
                                 } else {
                                     false
@@ -83,8 +148,13 @@ impl ClientThread {
                         )
                     });
                 });
-            })
-            .await?;
+            };
+
+            if codec.is_some() {
+                self.send_packet_alloca_with::<AckedLevelDataPacket, _>(calc_size, encode_fn).await?;
+            } else {
+                self.send_packet_alloca_with::<LevelDataPacket, _>(calc_size, encode_fn).await?;
+            }
 
             return Ok(());
         }
@@ -110,19 +180,35 @@ impl ClientThread {
         });
 
         let players_per_fragment = (players.len() + total_fragments - 1) / total_fragments;
-        let calc_size = size_of_types!(u32) + size_of_types!(AssociatedPlayerData) * players_per_fragment;
+        let calc_size = header_size + size_of_types!(u32) + player_size * players_per_fragment;
 
         debug!(
             "sending a fragmented packet (lim: {fragmentation_limit}, per: {players_per_fragment}, frags: {total_fragments}, fragsize: {calc_size})"
         );
 
         for chunk in players.chunks(players_per_fragment) {
-            self.send_packet_alloca_with::<LevelDataPacket, _>(calc_size, |buf| buf.write_value(chunk))
+            if let (Some(ack), Some(codec)) = (ack, &codec) {
+                self.send_packet_alloca_with::<AckedLevelDataPacket, _>(calc_size, |buf| {
+                    buf.write_u16(ack);
+                    buf.write_bool(request_keyframe);
+                    buf.write_value(codec);
+                    buf.write_list_with(chunk.len(), |buf| {
+                        for player in chunk {
+                            codec.write_player(buf, &player.to_borrowed());
+                        }
+
+                        chunk.len()
+                    });
+                })
                 .await?;
+            } else {
+                self.send_packet_alloca_with::<LevelDataPacket, _>(calc_size, |buf| buf.write_value(chunk))
+                    .await?;
+            }
         }
 
         Ok(())
-    });
+    }
 
     gs_handler!(self, handle_player_metadata, PlayerMetadataPacket, packet, {
         let account_id = gs_needauth!(self);
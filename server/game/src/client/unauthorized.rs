@@ -9,7 +9,7 @@ use std::{
 
 #[allow(unused_imports)]
 use globed_shared::{
-    debug, info,
+    debug, info, is_supported_protocol,
     rand::{self, Rng},
     warn, SyncMutex, UserEntry, MIN_CLIENT_VERSION, PROTOCOL_VERSION,
 };
@@ -278,7 +278,7 @@ impl UnauthorizedThread {
     gs_handler!(self, handle_crypto_handshake, CryptoHandshakeStartPacket, packet, {
         let socket = self.get_socket();
 
-        if packet.protocol != PROTOCOL_VERSION && packet.protocol != 0xffff {
+        if !is_supported_protocol(packet.protocol) {
             self.terminate();
 
             socket
@@ -295,6 +295,7 @@ impl UnauthorizedThread {
         socket
             .send_packet_static(&CryptoHandshakeResponsePacket {
                 key: self.game_server.public_key.clone().into(),
+                protocol: PROTOCOL_VERSION,
             })
             .await
     });
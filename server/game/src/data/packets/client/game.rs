@@ -28,6 +28,13 @@ pub struct PlayerMetadataPacket {
     pub data: PlayerMetadata,
 }
 
+#[derive(Packet, Decodable)]
+#[packet(id = 12005)]
+pub struct PlayerDataDeltaPacket {
+    pub seq: u16,
+    pub data: Either<PlayerData, PlayerDataDelta>, // full data (keyframe) or a delta
+}
+
 #[derive(Packet, Decodable)]
 #[packet(id = 12010, encrypted = true)]
 pub struct VoicePacket {
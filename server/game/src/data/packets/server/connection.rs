@@ -11,6 +11,8 @@ pub struct PingResponsePacket {
 #[packet(id = 20001, tcp = true)]
 pub struct CryptoHandshakeResponsePacket {
     pub key: CryptoPublicKey,
+    /// protocol version of this server, clients use it to tell which packets they can send
+    pub protocol: u16,
 }
 
 #[derive(Packet, Encodable, StaticSize)]
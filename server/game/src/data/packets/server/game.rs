@@ -18,6 +18,29 @@ pub struct LevelPlayerMetadataPacket {
     pub players: Vec<AssociatedPlayerMetadata>,
 }
 
+#[derive(Packet)]
+#[packet(id = 22003, tcp = false)]
+pub struct AckedLevelDataPacket {
+    pub ack: u16,
+    /// set if the server couldn't apply the delta (its baseline is gone), `ack` must be ignored and the next packet must be a keyframe
+    pub request_keyframe: bool,
+    pub codec: PlayerDataCodec,
+    pub players: Vec<AssociatedPlayerData>,
+}
+
+encode_impl!(AckedLevelDataPacket, buf, self, {
+    buf.write_u16(self.ack);
+    buf.write_bool(self.request_keyframe);
+    buf.write_value(&self.codec);
+    buf.write_list_with(self.players.len(), |buf| {
+        for player in &self.players {
+            self.codec.write_player(buf, &player.to_borrowed());
+        }
+
+        self.players.len()
+    });
+});
+
 #[derive(Packet, Encodable, DynamicSize)]
 #[packet(id = 22010, encrypted = true, tcp = false)]
 pub struct VoiceBroadcastPacket {
@@ -64,3 +64,414 @@ pub struct PlayerData {
 
     pub flags: Bits<1>, // also a bit-field
 }
+
+/* PlayerDataDelta (changes relative to a PlayerData that we already acknowledged) */
+// see the client-side structures for more info. every field is only present if its bit in `fields` is set.
+// positions and rotations are either quantized differences or absolute values.
+
+pub const DELTA_POSITION_QUANTUM: f32 = 1.0 / 64.0;
+pub const DELTA_ROTATION_QUANTUM: f32 = 1.0 / 32.0;
+
+// the quantums are powers of two, so this gives the exact same result as on the client
+#[inline]
+fn dequantize_delta(base: FiniteF32, delta: i16, quantum: f32) -> DecodeResult<FiniteF32> {
+    FiniteF32::new(base.get() + f32::from(delta) * quantum).ok_or(DecodeError::NonFiniteValue)
+}
+
+#[derive(Clone, Debug, Default)]
+pub struct SpecificIconDataDelta {
+    pub fields: u8,
+    pub position_delta: (i16, i16),
+    pub position: Point,
+    pub rotation_delta: i16,
+    pub rotation: FiniteF32,
+    pub icon_type: PlayerIconType,
+    pub flags: Bits<2>,
+    pub spider_teleport_data: Option<SpiderTeleportData>,
+}
+
+impl SpecificIconDataDelta {
+    pub const POSITION_DELTA: u8 = 1 << 0;
+    pub const POSITION_ABSOLUTE: u8 = 1 << 1;
+    pub const ROTATION_DELTA: u8 = 1 << 2;
+    pub const ROTATION_ABSOLUTE: u8 = 1 << 3;
+    pub const ICON_TYPE: u8 = 1 << 4;
+    pub const FLAGS: u8 = 1 << 5;
+    pub const SPIDER_TELEPORT: u8 = 1 << 6;
+
+    /// reconstruct the full state. spider teleports are events, so they are never carried over from `base`.
+    pub fn apply(&self, base: &SpecificIconData) -> DecodeResult<SpecificIconData> {
+        let mut data = base.clone();
+
+        if self.fields & Self::POSITION_DELTA != 0 {
+            data.position = Point {
+                x: dequantize_delta(base.position.x, self.position_delta.0, DELTA_POSITION_QUANTUM)?,
+                y: dequantize_delta(base.position.y, self.position_delta.1, DELTA_POSITION_QUANTUM)?,
+            };
+        } else if self.fields & Self::POSITION_ABSOLUTE != 0 {
+            data.position = self.position;
+        }
+
+        if self.fields & Self::ROTATION_DELTA != 0 {
+            data.rotation = dequantize_delta(base.rotation, self.rotation_delta, DELTA_ROTATION_QUANTUM)?;
+        } else if self.fields & Self::ROTATION_ABSOLUTE != 0 {
+            data.rotation = self.rotation;
+        }
+
+        if self.fields & Self::ICON_TYPE != 0 {
+            data.icon_type = self.icon_type;
+        }
+
+        if self.fields & Self::FLAGS != 0 {
+            data.flags = self.flags;
+        }
+
+        data.spider_teleport_data.clone_from(&self.spider_teleport_data);
+
+        Ok(data)
+    }
+}
+
+decode_impl!(SpecificIconDataDelta, buf, {
+    let mut delta = Self {
+        fields: buf.read_u8()?,
+        ..Default::default()
+    };
+
+    if delta.fields & Self::POSITION_DELTA != 0 {
+        delta.position_delta = (buf.read_i16()?, buf.read_i16()?);
+    }
+
+    if delta.fields & Self::POSITION_ABSOLUTE != 0 {
+        delta.position = buf.read_value()?;
+    }
+
+    if delta.fields & Self::ROTATION_DELTA != 0 {
+        delta.rotation_delta = buf.read_i16()?;
+    }
+
+    if delta.fields & Self::ROTATION_ABSOLUTE != 0 {
+        delta.rotation = buf.read_value()?;
+    }
+
+    if delta.fields & Self::ICON_TYPE != 0 {
+        delta.icon_type = buf.read_value()?;
+    }
+
+    if delta.fields & Self::FLAGS != 0 {
+        delta.flags = buf.read_value()?;
+    }
+
+    if delta.fields & Self::SPIDER_TELEPORT != 0 {
+        delta.spider_teleport_data = Some(buf.read_value()?);
+    }
+
+    Ok(delta)
+});
+
+#[derive(Clone, Debug, Default)]
+pub struct PlayerDataDelta {
+    pub baseline: u16, // sequence number of the state this delta is relative to
+    pub timestamp: FiniteF32,
+    pub fields: u8,
+
+    pub player1: SpecificIconDataDelta,
+    pub player2: SpecificIconDataDelta,
+
+    pub last_death_timestamp: FiniteF32,
+    pub current_percentage: FiniteF32,
+    pub flags: Bits<1>,
+}
+
+impl PlayerDataDelta {
+    pub const PLAYER1: u8 = 1 << 0;
+    pub const PLAYER2: u8 = 1 << 1;
+    pub const LAST_DEATH_TIMESTAMP: u8 = 1 << 2;
+    pub const CURRENT_PERCENTAGE: u8 = 1 << 3;
+    pub const FLAGS: u8 = 1 << 4;
+
+    pub fn apply(&self, base: &PlayerData) -> DecodeResult<PlayerData> {
+        Ok(PlayerData {
+            timestamp: self.timestamp,
+
+            // applied even if unchanged, to clear the spider teleports of the baseline
+            player1: self.player1.apply(&base.player1)?,
+            player2: self.player2.apply(&base.player2)?,
+
+            last_death_timestamp: if self.fields & Self::LAST_DEATH_TIMESTAMP != 0 {
+                self.last_death_timestamp
+            } else {
+                base.last_death_timestamp
+            },
+
+            current_percentage: if self.fields & Self::CURRENT_PERCENTAGE != 0 {
+                self.current_percentage
+            } else {
+                base.current_percentage
+            },
+
+            flags: if self.fields & Self::FLAGS != 0 { self.flags } else { base.flags },
+        })
+    }
+}
+
+decode_impl!(PlayerDataDelta, buf, {
+    let mut delta = Self {
+        baseline: buf.read_u16()?,
+        timestamp: buf.read_value()?,
+        fields: buf.read_u8()?,
+        ..Default::default()
+    };
+
+    if delta.fields & Self::PLAYER1 != 0 {
+        delta.player1 = buf.read_value()?;
+    }
+
+    if delta.fields & Self::PLAYER2 != 0 {
+        delta.player2 = buf.read_value()?;
+    }
+
+    if delta.fields & Self::LAST_DEATH_TIMESTAMP != 0 {
+        delta.last_death_timestamp = buf.read_value()?;
+    }
+
+    if delta.fields & Self::CURRENT_PERCENTAGE != 0 {
+        delta.current_percentage = buf.read_value()?;
+    }
+
+    if delta.fields & Self::FLAGS != 0 {
+        delta.flags = buf.read_value()?;
+    }
+
+    Ok(delta)
+});
+
+/* PlayerDataHistory (last few states received from a client, used as baselines for deltas) */
+
+pub const PLAYER_DATA_HISTORY_SIZE: usize = 16;
+
+#[derive(Default)]
+pub struct PlayerDataHistory {
+    entries: [Option<(u16, PlayerData)>; PLAYER_DATA_HISTORY_SIZE],
+}
+
+impl PlayerDataHistory {
+    pub fn get(&self, seq: u16) -> Option<&PlayerData> {
+        match &self.entries[seq as usize % PLAYER_DATA_HISTORY_SIZE] {
+            Some((entry_seq, data)) if *entry_seq == seq => Some(data),
+            _ => None,
+        }
+    }
+
+    /// store the state, unless the slot already holds a newer one (i.e. the packet arrived out of order)
+    pub fn insert(&mut self, seq: u16, data: &PlayerData) {
+        let slot = &mut self.entries[seq as usize % PLAYER_DATA_HISTORY_SIZE];
+
+        if let Some((entry_seq, _)) = slot {
+            if (entry_seq.wrapping_sub(seq) as i16) > 0 {
+                return;
+            }
+        }
+
+        *slot = Some((seq, data.clone()));
+    }
+
+    pub fn clear(&mut self) {
+        self.entries = Default::default();
+    }
+}
+
+/* PlayerDataCodec (quantized PlayerData, used for the level data sent in AckedLevelDataPacket) */
+// positions are encoded as 16-bit fixed point relative to `origin` (the position of the receiving player),
+// rotations as absolute 16-bit fixed point. values that don't fit are escaped and sent as a raw f32 instead.
+
+pub const QUANTIZED_MAX_PRECISION: u8 = 8;
+pub const QUANTIZED_ROTATION_QUANTUM: f32 = 1.0 / 32.0;
+pub const QUANTIZED_ESCAPE: i16 = i16::MIN;
+
+#[derive(Clone, Copy, Debug)]
+pub enum QuantizedValue {
+    Fixed(i16),
+    Raw(FiniteF32),
+}
+
+impl QuantizedValue {
+    #[inline]
+    pub fn quantize(value: FiniteF32, origin: f32, quantum: f32) -> Self {
+        let steps = ((value.get() - origin) / quantum).round();
+
+        // the escape value itself is excluded from the range
+        if steps.is_finite() && steps > f32::from(QUANTIZED_ESCAPE) && steps <= f32::from(i16::MAX) {
+            Self::Fixed(steps as i16)
+        } else {
+            Self::Raw(value)
+        }
+    }
+
+    #[inline]
+    pub fn dequantize(self, origin: f32, quantum: f32) -> DecodeResult<FiniteF32> {
+        match self {
+            Self::Fixed(steps) => FiniteF32::new(origin + f32::from(steps) * quantum).ok_or(DecodeError::NonFiniteValue),
+            Self::Raw(value) => Ok(value),
+        }
+    }
+}
+
+encode_impl!(QuantizedValue, buf, self, {
+    match self {
+        Self::Fixed(steps) => buf.write_i16(*steps),
+        Self::Raw(value) => {
+            buf.write_i16(QUANTIZED_ESCAPE);
+            buf.write_value(value);
+        }
+    }
+});
+
+decode_impl!(QuantizedValue, buf, {
+    let steps = buf.read_i16()?;
+    if steps == QUANTIZED_ESCAPE {
+        Ok(Self::Raw(buf.read_value()?))
+    } else {
+        Ok(Self::Fixed(steps))
+    }
+});
+
+static_size_calc_impl!(QuantizedValue, size_of_types!(i16, FiniteF32));
+
+#[derive(Clone, Debug, Encodable, Decodable, StaticSize)]
+pub struct QuantizedSpecificIconData {
+    pub x: QuantizedValue,
+    pub y: QuantizedValue,
+    pub rotation: QuantizedValue,
+    pub icon_type: PlayerIconType,
+    pub flags: Bits<2>,
+    pub spider_teleport_data: Option<SpiderTeleportData>,
+}
+
+#[derive(Clone, Debug, Encodable, Decodable, StaticSize)]
+pub struct QuantizedPlayerData {
+    pub timestamp: FiniteF32,
+    pub player1: QuantizedSpecificIconData,
+    pub player2: QuantizedSpecificIconData,
+    pub last_death_timestamp: FiniteF32,
+    pub current_percentage: FiniteF32,
+    pub flags: Bits<1>,
+}
+
+#[derive(Clone, Debug, Encodable, Decodable, StaticSize)]
+pub struct QuantizedAssociatedPlayerData {
+    pub account_id: i32,
+    pub data: QuantizedPlayerData,
+}
+
+#[derive(Clone, Copy, Debug, Default)]
+pub struct PlayerDataCodec {
+    pub precision: u8, // amount of fractional bits in positions, 0 means that quantization is disabled
+    pub origin: Point,
+}
+
+impl PlayerDataCodec {
+    pub fn new(precision: u8, origin: Point) -> Self {
+        Self {
+            precision: precision.min(QUANTIZED_MAX_PRECISION),
+            origin,
+        }
+    }
+
+    #[inline]
+    pub const fn is_quantized(&self) -> bool {
+        self.precision != 0
+    }
+
+    #[inline]
+    fn position_quantum(&self) -> f32 {
+        1.0 / f32::from(1u16 << self.precision)
+    }
+
+    pub fn quantize_icon(&self, data: &SpecificIconData) -> QuantizedSpecificIconData {
+        let quantum = self.position_quantum();
+
+        QuantizedSpecificIconData {
+            x: QuantizedValue::quantize(data.position.x, self.origin.x.get(), quantum),
+            y: QuantizedValue::quantize(data.position.y, self.origin.y.get(), quantum),
+            rotation: QuantizedValue::quantize(data.rotation, 0.0, QUANTIZED_ROTATION_QUANTUM),
+            icon_type: data.icon_type,
+            flags: data.flags,
+            spider_teleport_data: data.spider_teleport_data.clone(),
+        }
+    }
+
+    pub fn dequantize_icon(&self, data: &QuantizedSpecificIconData) -> DecodeResult<SpecificIconData> {
+        let quantum = self.position_quantum();
+
+        Ok(SpecificIconData {
+            position: Point {
+                x: data.x.dequantize(self.origin.x.get(), quantum)?,
+                y: data.y.dequantize(self.origin.y.get(), quantum)?,
+            },
+            rotation: data.rotation.dequantize(0.0, QUANTIZED_ROTATION_QUANTUM)?,
+            icon_type: data.icon_type,
+            flags: data.flags,
+            spider_teleport_data: data.spider_teleport_data.clone(),
+        })
+    }
+
+    pub fn quantize(&self, data: &BorrowedAssociatedPlayerData) -> QuantizedAssociatedPlayerData {
+        QuantizedAssociatedPlayerData {
+            account_id: data.account_id,
+            data: QuantizedPlayerData {
+                timestamp: data.data.timestamp,
+                player1: self.quantize_icon(&data.data.player1),
+                player2: self.quantize_icon(&data.data.player2),
+                last_death_timestamp: data.data.last_death_timestamp,
+                current_percentage: data.data.current_percentage,
+                flags: data.data.flags,
+            },
+        }
+    }
+
+    /// write the data of a player, quantized if enabled
+    #[inline]
+    pub fn write_player<B: ByteBufferExtWrite>(&self, buf: &mut B, data: &BorrowedAssociatedPlayerData) {
+        if self.is_quantized() {
+            buf.write_value(&self.quantize(data));
+        } else {
+            buf.write_value(data);
+        }
+    }
+
+    pub fn dequantize(&self, data: &QuantizedAssociatedPlayerData) -> DecodeResult<AssociatedPlayerData> {
+        Ok(AssociatedPlayerData {
+            account_id: data.account_id,
+            data: PlayerData {
+                timestamp: data.data.timestamp,
+                player1: self.dequantize_icon(&data.data.player1)?,
+                player2: self.dequantize_icon(&data.data.player2)?,
+                last_death_timestamp: data.data.last_death_timestamp,
+                current_percentage: data.data.current_percentage,
+                flags: data.data.flags,
+            },
+        })
+    }
+}
+
+// the origin is only sent if it's going to be used
+encode_impl!(PlayerDataCodec, buf, self, {
+    buf.write_u8(self.precision);
+    if self.is_quantized() {
+        buf.write_value(&self.origin);
+    }
+});
+
+decode_impl!(PlayerDataCodec, buf, {
+    let precision = buf.read_u8()?;
+    if precision > QUANTIZED_MAX_PRECISION {
+        return Err(DecodeError::InvalidEnumValue);
+    }
+
+    let origin = if precision == 0 { Point::default() } else { buf.read_value()? };
+
+    Ok(Self { precision, origin })
+});
+
+static_size_calc_impl!(PlayerDataCodec, size_of_types!(u8, Point));
@@ -165,6 +165,15 @@ pub struct AssociatedPlayerData {
     pub data: PlayerData,
 }
 
+impl AssociatedPlayerData {
+    pub fn to_borrowed(&self) -> BorrowedAssociatedPlayerData {
+        BorrowedAssociatedPlayerData {
+            account_id: self.account_id,
+            data: &self.data,
+        }
+    }
+}
+
 /* AssociatedPlayerMetadata */
 
 #[derive(Clone, Default, Encodable, Decodable, StaticSize, DynamicSize)]
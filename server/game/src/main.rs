@@ -296,6 +296,12 @@ async fn main() -> Result<(), Box<dyn Error>> {
 
         debug!("Configuration:");
         debug!("* TPS: {}", gsbd.tps);
+        if gsbd.player_data_precision == 0 {
+            debug!("* Player data quantization: disabled");
+        } else {
+            let precision = gsbd.player_data_precision.min(data::QUANTIZED_MAX_PRECISION);
+            debug!("* Player data quantization: 1/{} units", 1u32 << precision);
+        }
         debug!("* Token expiry: {} seconds", gsbd.token_expiry);
         debug!("* Maintenance: {}", if gsbd.maintenance { "yes" } else { "no" });
 
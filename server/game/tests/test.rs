@@ -133,3 +133,90 @@ fn test_player_manager() {
         }
     }
 }
+
+#[test]
+fn test_player_data_delta() {
+    let mut base = PlayerData::default();
+    base.player1.position = Point {
+        x: FiniteF32::new(100.0).unwrap(),
+        y: FiniteF32::new(200.0).unwrap(),
+    };
+    base.player1.spider_teleport_data = Some(SpiderTeleportData::default());
+
+    let mut history = PlayerDataHistory::default();
+    history.insert(3, &base);
+
+    // a delta against seq 3 that only moves player 1 and changes the percentage
+    let mut buf = ByteBuffer::new();
+    buf.write_u16(3); // baseline
+    buf.write_f32(1.5); // timestamp
+    buf.write_u8(PlayerDataDelta::PLAYER1 | PlayerDataDelta::CURRENT_PERCENTAGE);
+    buf.write_u8(SpecificIconDataDelta::POSITION_DELTA | SpecificIconDataDelta::ROTATION_ABSOLUTE);
+    buf.write_i16(64); // +1.0
+    buf.write_i16(-32); // -0.5
+    buf.write_f32(90.0);
+    buf.write_f32(0.25);
+
+    let mut reader = ByteReader::from_bytes(buf.as_bytes());
+    let delta = reader.read_value::<PlayerDataDelta>().unwrap();
+    let data = delta.apply(history.get(delta.baseline).unwrap()).unwrap();
+
+    assert_eq!(data.timestamp.get(), 1.5);
+    assert_eq!(data.player1.position.x.get(), 101.0);
+    assert_eq!(data.player1.position.y.get(), 199.5);
+    assert_eq!(data.player1.rotation.get(), 90.0);
+    assert!(data.player1.spider_teleport_data.is_none());
+    assert_eq!(data.current_percentage.get(), 0.25);
+
+    // a slot is only reused by a newer sequence number
+    history.insert(3 + PLAYER_DATA_HISTORY_SIZE as u16, &data);
+    assert!(history.get(3).is_none());
+    history.insert(3, &base);
+    assert!(history.get(3).is_none());
+}
+
+#[test]
+fn test_quantized_player_data() {
+    let origin = Point {
+        x: FiniteF32::new(1000.0).unwrap(),
+        y: FiniteF32::new(300.0).unwrap(),
+    };
+
+    for precision in 1..=QUANTIZED_MAX_PRECISION {
+        let codec = PlayerDataCodec::new(precision, origin);
+        // half a quantum, plus rounding of the final f32 addition
+        let max_error = |v: f32| 0.5 / f32::from(1u16 << precision) + v.abs() * f32::EPSILON;
+
+        for i in 0..1000 {
+            let mut data = PlayerData::default();
+            // some of these are far enough from the origin that they have to be sent as raw floats
+            data.player1.position = Point {
+                x: FiniteF32::new(origin.x.get() + (i as f32 - 500.0) * 13.37).unwrap(),
+                y: FiniteF32::new(origin.y.get() - i as f32 * 0.731).unwrap(),
+            };
+            data.player1.rotation = FiniteF32::new(i as f32 * 7.77 - 3000.0).unwrap();
+
+            let player = AssociatedPlayerData { account_id: i, data };
+
+            let mut buf = ByteBuffer::new();
+            buf.write_value(&codec);
+            codec.write_player(&mut buf, &player.to_borrowed());
+
+            let mut reader = ByteReader::from_bytes(buf.as_bytes());
+            let decoded_codec = reader.read_value::<PlayerDataCodec>().unwrap();
+            let quantized = reader.read_value::<QuantizedAssociatedPlayerData>().unwrap();
+            let decoded = decoded_codec.dequantize(&quantized).unwrap();
+
+            let (orig, dec) = (&player.data.player1, &decoded.data.player1);
+            assert_eq!(decoded.account_id, i);
+            assert!((orig.position.x.get() - dec.position.x.get()).abs() <= max_error(orig.position.x.get()));
+            assert!((orig.position.y.get() - dec.position.y.get()).abs() <= max_error(orig.position.y.get()));
+            assert!((orig.rotation.get() - dec.rotation.get()).abs() <= QUANTIZED_ROTATION_QUANTUM / 2.0 + orig.rotation.get().abs() * f32::EPSILON);
+        }
+    }
+
+    // precision 0 only writes the precision byte
+    let mut buf = ByteBuffer::new();
+    buf.write_value(&PlayerDataCodec::new(0, origin));
+    assert_eq!(buf.len(), 1);
+}
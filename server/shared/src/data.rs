@@ -6,6 +6,7 @@ use serde::{Deserialize, Serialize};
 pub struct GameServerBootData {
     pub protocol: u16,
     pub tps: u32,
+    pub player_data_precision: u8,
     pub maintenance: bool,
     pub secret_key2: String,
     pub token_expiry: u64,
@@ -28,6 +29,7 @@ impl Default for GameServerBootData {
         Self {
             protocol: PROTOCOL_VERSION,
             tps: 30,
+            player_data_precision: 4,
             maintenance: false,
             secret_key2: String::new(),
             token_expiry: 0,
@@ -34,9 +34,17 @@ pub mod data;
 pub mod logger;
 pub mod token_issuer;
 
-pub const PROTOCOL_VERSION: u16 = 6;
+pub const PROTOCOL_VERSION: u16 = 7;
+// oldest client protocol that is still accepted. v6 clients simply don't use delta compressed player data.
+pub const MIN_PROTOCOL_VERSION: u16 = 6;
 // used for communicating to the user the minimum required mod version for this protocol
 pub const MIN_CLIENT_VERSION: &str = "v1.4.0";
+
+/// whether a client on the given protocol is allowed to connect. 0xffff bypasses the check.
+pub const fn is_supported_protocol(protocol: u16) -> bool {
+    protocol == 0xffff || (protocol >= MIN_PROTOCOL_VERSION && protocol <= PROTOCOL_VERSION)
+}
+
 pub const SERVER_MAGIC: &[u8] = b"\xdd\xeeglobed\xda\xee";
 pub const SERVER_MAGIC_LEN: usize = SERVER_MAGIC.len();
 /// amount of chars in an admin key (32)
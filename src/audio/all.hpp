@@ -3,7 +3,9 @@
 #include "decoder.hpp"
 #include "encoder.hpp"
 #include "frame.hpp"
+#include "jitter_buffer.hpp"
 #include "manager.hpp"
+#include "mixer.hpp"
 #include "sample_queue.hpp"
 #include "stream.hpp"
 #include "voice_playback_manager.hpp"
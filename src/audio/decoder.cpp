@@ -77,6 +77,23 @@ Result<DecodedOpusData> AudioDecoder::decode(const EncodedOpusData& data) {
     return this->decode(data.ptr, data.length);
 }
 
+Result<DecodedOpusData> AudioDecoder::decodeLost(const byte* next, size_t nextLength) {
+    DecodedOpusData out;
+
+    out.length = frameSize * channels;
+    out.ptr = new float[out.length];
+
+    // with no data, opus does plc. with the next packet and decode_fec set, it decodes the fec data of the lost frame from it
+    _res = opus_decode_float(decoder, next, next ? nextLength : 0, out.ptr, frameSize, next ? 1 : 0);
+
+    if (_res < 0) {
+        delete[] out.ptr;
+        GLOBED_UNWRAP(this->errcheck("opus_decode_float"));
+    }
+
+    return Ok(out);
+}
+
 Result<> AudioDecoder::setSampleRate(int sampleRate) {
     this->sampleRate = sampleRate;
     return this->remakeDecoder();
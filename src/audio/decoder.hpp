@@ -37,6 +37,11 @@ public:
     // After you no longer need the decoded data, you must call `data.freeData()`, or (preferrably, for explicitness) `AudioDecoder::freeData(data)`
     [[nodiscard]] Result<DecodedOpusData> decode(const EncodedOpusData& data);
 
+    // Produces audio in place of a frame that was lost. If the frame after it is available, pass it as `next`,
+    // its forward error correction data will then be used to reconstruct the lost frame.
+    // Otherwise opus packet loss concealment extrapolates from the previously decoded audio.
+    [[nodiscard]] Result<DecodedOpusData> decodeLost(const util::data::byte* next = nullptr, size_t nextLength = 0);
+
     static void freeData(DecodedOpusData& data) {
         data.freeData();
     }
@@ -133,6 +133,14 @@ Result<> AudioEncoder::setVariableBitrate(bool variablebr) {
     return this->errcheck("AudioEncoder::setVariableBitrate");
 }
 
+Result<> AudioEncoder::setInbandFec(bool enabled, int expectedLoss) {
+    _res = opus_encoder_ctl(encoder, OPUS_SET_INBAND_FEC(enabled ? 1 : 0));
+    GLOBED_UNWRAP(this->errcheck("AudioEncoder::setInbandFec"));
+
+    _res = opus_encoder_ctl(encoder, OPUS_SET_PACKET_LOSS_PERC(enabled ? expectedLoss : 0));
+    return this->errcheck("AudioEncoder::setInbandFec");
+}
+
 Result<> AudioEncoder::remakeEncoder() {
     // if we are reinitializing, free the previous encoder
     if (encoder) {
@@ -146,7 +154,10 @@ Result<> AudioEncoder::remakeEncoder() {
     }
 
     encoder = opus_encoder_create(sampleRate, channels, OPUS_APPLICATION_VOIP, &_res);
-    return this->errcheck("opus_encoder_create");
+    GLOBED_UNWRAP(this->errcheck("opus_encoder_create"));
+
+    // lets the receiving jitter buffer recover a lost frame from the one after it
+    return this->setInbandFec(true);
 }
 
 Result<> AudioEncoder::errcheck(const char* where) {
@@ -7,6 +7,8 @@
 #include <data/bytebuffer.hpp>
 
 constexpr size_t VOICE_MAX_BYTES_IN_FRAME = 1000;
+// packet loss the encoder adds forward error correction data for, in percent
+constexpr int VOICE_EXPECTED_PACKET_LOSS = 10;
 
 struct OpusEncoder;
 
@@ -65,6 +67,9 @@ private:
     // sets whether to use VBR or CBR (if false)
     Result<> setVariableBitrate(bool variablebr = true);
 
+    // enables or disables inband forward error correction, tuned for the given packet loss percentage
+    Result<> setInbandFec(bool enabled, int expectedLoss = VOICE_EXPECTED_PACKET_LOSS);
+
 protected:
     OpusEncoder* encoder = nullptr;
 
@@ -34,6 +34,7 @@ void EncodedAudioFrame::clear() {
     }
 
     frames.clear();
+    sequence.reset();
 }
 
 size_t EncodedAudioFrame::size() const {
@@ -48,6 +49,14 @@ const std::vector<EncodedOpusData>& EncodedAudioFrame::getFrames() const {
     return frames;
 }
 
+void EncodedAudioFrame::setSequence(uint16_t seq) {
+    sequence = seq;
+}
+
+std::optional<uint16_t> EncodedAudioFrame::getSequence() const {
+    return sequence;
+}
+
 template<> void ByteBuffer::customEncode(const EncodedAudioFrame& frame) {
     GLOBED_REQUIRE(
         frame.frames.size() <= frame._capacity,
@@ -64,6 +73,11 @@ template<> void ByteBuffer::customEncode(const EncodedAudioFrame& frame) {
     for (size_t i = frame.frames.size(); i < EncodedAudioFrame::VOICE_MAX_FRAMES_IN_AUDIO_FRAME; i++) {
         this->writeValue<std::optional<EncodedOpusData>>(std::nullopt);
     }
+
+    // the sequence number is appended at the very end, where older clients (and the server, which doesn't decode voice frames) ignore it
+    if (frame.sequence) {
+        this->writeU16(frame.sequence.value());
+    }
 }
 
 template<> ByteBuffer::DecodeResult<EncodedAudioFrame> ByteBuffer::customDecode() {
@@ -80,6 +94,17 @@ template<> ByteBuffer::DecodeResult<EncodedAudioFrame> ByteBuffer::customDecode(
         if (frame) eframe.frames.push_back(frame.value());
     }
 
+    // frames without a sequence number are sent by older clients
+    if (this->size() - this->getPosition() >= sizeof(uint16_t)) {
+        auto seq = this->readU16();
+        if (seq.isErr()) {
+            eframe.clear();
+            return Err(seq.unwrapErr());
+        }
+
+        eframe.sequence = seq.unwrap();
+    }
+
     return Ok(std::move(eframe));
 }
 
@@ -44,9 +44,15 @@ public:
     // extract all frames
     const std::vector<EncodedOpusData>& getFrames() const;
 
+    // set the sequence number of the first opus frame, the following ones are numbered consecutively
+    void setSequence(uint16_t seq);
+    // nullopt if the frame was sent by an older client that does not number its frames
+    std::optional<uint16_t> getSequence() const;
+
 protected:
     mutable std::vector<EncodedOpusData> frames;
     size_t _capacity;
+    std::optional<uint16_t> sequence;
 };
 
 
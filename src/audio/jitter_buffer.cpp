@@ -0,0 +1,179 @@
+#include "jitter_buffer.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include "manager.hpp"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace util::data;
+
+// signed distance between two sequence numbers, handles wrapping around
+static int seqDiff(uint16_t a, uint16_t b) {
+    return static_cast<int16_t>(static_cast<uint16_t>(a - b));
+}
+
+void VoiceJitterBuffer::push(const EncodedAudioFrame& frame, util::time::time_point now) {
+    const auto& frames = frame.getFrames();
+    if (frames.empty()) return;
+
+    // older clients don't number their frames, assume those arrive in order
+    uint16_t first = frame.getSequence().value_or(initialized ? static_cast<uint16_t>(newestSeq + 1) : 0);
+
+    // a sequence number this far off means the sender restarted
+    if (initialized && std::abs(seqDiff(first, nextSeq)) >= (int) CAPACITY) {
+        this->reset();
+    }
+
+    if (!initialized) {
+        initialized = true;
+        nextSeq = first;
+        newestSeq = static_cast<uint16_t>(first - 1);
+    }
+
+    this->updateJitter(first, now);
+
+    for (size_t i = 0; i < frames.size(); i++) {
+        this->insert(static_cast<uint16_t>(first + i), frames[i], now);
+    }
+}
+
+VoiceJitterBuffer::Playout VoiceJitterBuffer::pull(util::time::time_point now) {
+    if (count == 0) {
+        // ran dry, wait for the target delay again once new frames arrive
+        playing = false;
+        return {};
+    }
+
+    if (!playing) {
+        if (std::chrono::duration<float>(now - bufferingSince).count() < stats.targetDelay) {
+            return {};
+        }
+
+        playing = true;
+    }
+
+    auto& slot = this->slotFor(nextSeq);
+    if (this->has(nextSeq)) {
+        slot.present = false;
+        count--;
+        nextSeq++;
+        concealedInRow = 0;
+
+        return Playout { PlayoutKind::Frame, &slot.data };
+    }
+
+    // the frame is missing, but there is something after it (otherwise count would be 0)
+    stats.lost++;
+    nextSeq++;
+
+    if (concealedInRow < MAX_CONCEALED_FRAMES) {
+        concealedInRow++;
+        stats.concealed++;
+
+        if (this->has(nextSeq)) {
+            return Playout { PlayoutKind::Fec, &this->slotFor(nextSeq).data };
+        }
+
+        return Playout { PlayoutKind::Plc, nullptr };
+    }
+
+    // concealing for too long sounds worse than a jump, skip to the next frame we have
+    while (!this->has(nextSeq)) {
+        stats.lost++;
+        nextSeq++;
+    }
+
+    return this->pull(now);
+}
+
+void VoiceJitterBuffer::reset() {
+    for (auto& slot : slots) {
+        slot.present = false;
+    }
+
+    count = 0;
+    initialized = false;
+    playing = false;
+    concealedInRow = 0;
+    hasLastArrival = false;
+}
+
+const VoiceJitterStats& VoiceJitterBuffer::getStats() const {
+    return stats;
+}
+
+void VoiceJitterBuffer::insert(uint16_t seq, const EncodedOpusData& data, util::time::time_point now) {
+    int offset = seqDiff(seq, nextSeq);
+    if (offset < 0) {
+        stats.late++;
+        return;
+    }
+
+    // make room by moving the playout position forward, this keeps the delay bounded
+    while (offset >= (int) MAX_BUFFERED_FRAMES) {
+        this->discardOldest();
+        offset--;
+    }
+
+    // duplicate
+    if (this->has(seq)) return;
+
+    if (count == 0 && !playing) {
+        bufferingSince = now;
+    }
+
+    auto& slot = this->slotFor(seq);
+    slot.present = true;
+    slot.seq = seq;
+    slot.data.assign(data.ptr, data.ptr + data.length);
+
+    count++;
+    stats.received++;
+
+    if (seqDiff(seq, newestSeq) > 0) {
+        newestSeq = seq;
+    }
+}
+
+void VoiceJitterBuffer::discardOldest() {
+    if (this->has(nextSeq)) {
+        this->slotFor(nextSeq).present = false;
+        count--;
+        stats.dropped++;
+    }
+
+    nextSeq++;
+}
+
+void VoiceJitterBuffer::updateJitter(uint16_t seq, util::time::time_point now) {
+    // interarrival jitter as described in RFC 3550: the difference between how far apart two frames were sent
+    // and how far apart they arrived, smoothed over roughly 16 packets
+    if (hasLastArrival) {
+        float arrivalGap = std::chrono::duration<float>(now - lastArrival).count();
+        float sendGap = seqDiff(seq, lastArrivalSeq) * VOICE_CHUNK_RECORD_TIME;
+        float deviation = std::abs(arrivalGap - sendGap);
+
+        // deviations this large are pauses in speech or hitches the buffer can't absorb anyway, they'd only inflate the estimate
+        if (deviation < MAX_TARGET_DELAY) {
+            stats.jitter += (deviation - stats.jitter) / 16.f;
+            stats.targetDelay = std::min(stats.jitter * JITTER_MULTIPLIER, MAX_TARGET_DELAY);
+        }
+    }
+
+    hasLastArrival = true;
+    lastArrivalSeq = seq;
+    lastArrival = now;
+}
+
+VoiceJitterBuffer::Slot& VoiceJitterBuffer::slotFor(uint16_t seq) {
+    return slots[seq & (CAPACITY - 1)];
+}
+
+bool VoiceJitterBuffer::has(uint16_t seq) {
+    auto& slot = this->slotFor(seq);
+    return slot.present && slot.seq == seq;
+}
+
+#endif // GLOBED_VOICE_SUPPORT
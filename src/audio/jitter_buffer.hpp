@@ -0,0 +1,96 @@
+#pragma once
+#include <defs/platform.hpp>
+
+#include <array>
+#include <util/data.hpp>
+#include <util/time.hpp>
+
+// Playback statistics of a single voice stream, counted in opus frames
+struct VoiceJitterStats {
+    size_t received = 0;    // frames that arrived in time to be played
+    size_t late = 0;        // frames that arrived after their playout time had already passed
+    size_t lost = 0;        // frames that were missing at their playout time
+    size_t concealed = 0;   // lost frames that were replaced by audio reconstructed with fec or plc
+    size_t dropped = 0;     // frames thrown away because too much audio was buffered
+    float jitter = 0.f;     // smoothed inter-arrival jitter, in seconds
+    float targetDelay = 0.f; // playout delay the buffer currently aims for, in seconds
+};
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include "frame.hpp"
+
+/*
+* VoiceJitterBuffer reorders incoming opus frames by their sequence number and decides what should be played next.
+* The playout delay adapts to the measured inter-arrival jitter. It is only applied when playback (re)starts after the buffer ran dry,
+* so a steady stream is never interrupted just to change the delay.
+* Not thread safe.
+*/
+class VoiceJitterBuffer {
+public:
+    // amount of frame slots, must be a power of two
+    static constexpr size_t CAPACITY = 64;
+    // frames further ahead of the playout position than this push the oldest ones out
+    static constexpr size_t MAX_BUFFERED_FRAMES = CAPACITY / 2;
+    // after this many concealed frames in a row, playback skips straight to the next frame that arrived
+    static constexpr size_t MAX_CONCEALED_FRAMES = 3;
+    // the target delay is this many times the measured jitter
+    static constexpr float JITTER_MULTIPLIER = 2.5f;
+    static constexpr float MAX_TARGET_DELAY = 1.0f;
+
+    enum class PlayoutKind {
+        Empty,  // nothing to play right now
+        Frame,  // `data` is the frame that should be decoded
+        Fec,    // the frame was lost, `data` is the frame after it, decode the lost one from its fec data
+        Plc,    // the frame was lost with nothing to recover it from, use packet loss concealment
+    };
+
+    struct Playout {
+        PlayoutKind kind = PlayoutKind::Empty;
+        // only valid until the next call to `push`
+        const std::vector<util::data::byte>* data = nullptr;
+    };
+
+    // Adds all opus frames from the given audio frame. `now` should be the time the frame was received.
+    void push(const EncodedAudioFrame& frame, util::time::time_point now);
+
+    // Takes the frame that should be played next.
+    Playout pull(util::time::time_point now);
+
+    // Discards all buffered frames and starts over with the next pushed frame. Stats are kept.
+    void reset();
+
+    const VoiceJitterStats& getStats() const;
+
+private:
+    struct Slot {
+        bool present = false;
+        uint16_t seq = 0;
+        std::vector<util::data::byte> data;
+    };
+
+    std::array<Slot, CAPACITY> slots;
+    size_t count = 0;
+
+    bool initialized = false;
+    bool playing = false;
+    uint16_t nextSeq = 0;   // sequence number of the frame that is going to be played next
+    uint16_t newestSeq = 0; // highest sequence number that was received
+    size_t concealedInRow = 0;
+    util::time::time_point bufferingSince;
+
+    bool hasLastArrival = false;
+    uint16_t lastArrivalSeq = 0;
+    util::time::time_point lastArrival;
+
+    VoiceJitterStats stats;
+
+    void insert(uint16_t seq, const EncodedOpusData& data, util::time::time_point now);
+    void discardOldest();
+    void updateJitter(uint16_t seq, util::time::time_point now);
+
+    Slot& slotFor(uint16_t seq);
+    bool has(uint16_t seq);
+};
+
+#endif // GLOBED_VOICE_SUPPORT
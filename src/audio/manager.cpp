@@ -453,6 +453,9 @@ void GlobedAudioManager::toggleLoopbacksAllowed(bool allowed) {
 void GlobedAudioManager::recordInvokeCallback() {
     if (recordFrame.size() == 0) return;
 
+    recordFrame.setSequence(recordSequence);
+    recordSequence += recordFrame.size();
+
     try {
         recordCallback(recordFrame);
     } catch (const std::exception& e) {
@@ -542,10 +545,13 @@ Result<> GlobedAudioManager::audioThreadWork() {
 
     if (recordingRaw) {
         // raw recording, call the raw callback with the pcm data directly.
-        float* pcm = recordQueue.data();
         size_t samples = recordQueue.size();
-        this->recordInvokeRawCallback(pcm, samples);
-        recordQueue.clear();
+        if (recordRawBuffer.size() < samples) {
+            recordRawBuffer.resize(samples);
+        }
+
+        samples = recordQueue.copyTo(recordRawBuffer.data(), samples);
+        this->recordInvokeRawCallback(recordRawBuffer.data(), samples);
     } else {
         // encoded recording, encode the data and push to the frame.
         if (recordQueue.size() >= VOICE_TARGET_FRAMESIZE) {
@@ -139,8 +139,10 @@ private:
     std::function<void(const EncodedAudioFrame&)> recordCallback;
     std::function<void(const float*, size_t)> recordRawCallback;
     AudioSampleQueue recordQueue;
+    std::vector<float> recordRawBuffer; // samples are copied here from `recordQueue` before calling the raw callback
     unsigned int recordLastPosition = 0;
     EncodedAudioFrame recordFrame;
+    uint16_t recordSequence = 0; // sequence number of the next recorded opus frame, lets receivers reorder and detect loss
 
     Result<> startRecordingInternal(bool passive = false);
     void recordContinueStream();
@@ -0,0 +1,174 @@
+#include "mixer.hpp"
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include "manager.hpp"
+#include "stream.hpp"
+#include <util/simd.hpp>
+
+#include <thread>
+
+VoiceMixer::VoiceMixer(size_t maxSpeakers) : maxSpeakers(std::max<size_t>(maxSpeakers, 1)) {
+    auto initial = std::make_unique<Snapshot>(Snapshot { .version = 0 });
+    current = initial.get();
+    *snapshot.lock() = std::move(initial);
+
+    FMOD_CREATESOUNDEXINFO exinfo = {};
+
+    exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
+    exinfo.numchannels = 1;
+    exinfo.format = FMOD_SOUND_FORMAT_PCMFLOAT;
+    exinfo.defaultfrequency = VOICE_TARGET_SAMPLERATE;
+    exinfo.userdata = this;
+    exinfo.length = sizeof(float) * exinfo.numchannels * exinfo.defaultfrequency * VOICE_CHUNK_RECORD_TIME;
+
+    exinfo.pcmreadcallback = [](FMOD_SOUND* sound_, void* data, unsigned int len) -> FMOD_RESULT {
+        FMOD::Sound* sound = reinterpret_cast<FMOD::Sound*>(sound_);
+        VoiceMixer* mixer = nullptr;
+        sound->getUserData((void**)&mixer);
+
+        if (!mixer || !data) {
+            log::warn("voice mixer is nullptr in cb, ignoring");
+            return FMOD_OK;
+        }
+
+        mixer->mix(reinterpret_cast<float*>(data), len / sizeof(float));
+
+        return FMOD_OK;
+    };
+
+    // fmod asks for at most the whole sound at once, allocate that upfront so the callback never has to
+    scratch.resize(exinfo.length / sizeof(float));
+
+    auto& vm = GlobedAudioManager::get();
+
+    FMOD_RESULT res;
+    auto system = vm.getSystem();
+    res = system->createStream(nullptr, FMOD_OPENUSER | FMOD_2D | FMOD_LOOP_NORMAL, &exinfo, &sound);
+
+    GLOBED_REQUIRE(res == FMOD_OK, GlobedAudioManager::formatFmodError(res, "System::createStream"))
+}
+
+VoiceMixer::~VoiceMixer() {
+    if (sound) {
+        sound->setUserData(nullptr);
+    }
+
+    if (channel) {
+        channel->stop();
+    }
+
+    if (sound) {
+        sound->release();
+    }
+}
+
+void VoiceMixer::start() {
+    if (this->channel) {
+        return;
+    }
+
+    this->channel = GlobedAudioManager::get().playSound(sound);
+}
+
+void VoiceMixer::attach(AudioStream* stream) {
+    auto owned = snapshot.lock();
+
+    auto next = std::make_unique<Snapshot>(Snapshot {
+        .version = (*owned)->version + 1,
+        .streams = (*owned)->streams,
+    });
+    next->streams.push_back(stream);
+
+    this->publish(*owned, std::move(next));
+}
+
+void VoiceMixer::detach(AudioStream* stream) {
+    auto owned = snapshot.lock();
+
+    auto next = std::make_unique<Snapshot>(Snapshot {
+        .version = (*owned)->version + 1,
+        .streams = (*owned)->streams,
+    });
+    std::erase(next->streams, stream);
+
+    this->publish(*owned, std::move(next));
+}
+
+void VoiceMixer::publish(std::unique_ptr<Snapshot>& owned, std::unique_ptr<Snapshot> next) {
+    // allocate the mixer's next source list here rather than in the audio callback
+    next->sources.resize(next->streams.size());
+
+    // both this and `mix` use seq_cst, so if the mixer started a chunk after we read the sequence, it sees the new snapshot
+    current.store(next.get());
+
+    // otherwise wait for the chunk to finish, it might still be using the old one
+    size_t seq = mixSequence.load();
+    if (seq % 2 == 1) {
+        while (mixSequence.load() == seq) {
+            std::this_thread::yield();
+        }
+    }
+
+    owned = std::move(next);
+}
+
+void VoiceMixer::syncSources(Snapshot& latest) {
+    // keep the loudness of streams that stay attached
+    for (size_t i = 0; i < latest.streams.size(); i++) {
+        auto* stream = latest.streams[i];
+        auto it = std::find_if(sources.begin(), sources.end(), [stream](const Source& source) {
+            return source.stream == stream;
+        });
+
+        latest.sources[i] = Source {
+            .stream = stream,
+            .loudness = it == sources.end() ? 0.f : it->loudness,
+        };
+    }
+
+    // the old list goes to the snapshot, and is freed along with it by the next writer
+    std::swap(sources, latest.sources);
+    sourcesVersion = latest.version;
+}
+
+void VoiceMixer::mix(float* out, size_t samples) {
+    std::fill_n(out, samples, 0.f);
+
+    if (scratch.size() < samples) {
+        scratch.resize(samples);
+    }
+
+    mixSequence.fetch_add(1);
+
+    Snapshot* latest = current.load();
+    if (latest->version != sourcesVersion) {
+        this->syncSources(*latest);
+    }
+
+    // rank by the loudness of the previous chunks, the order of sources doesn't matter otherwise
+    size_t mixed = std::min(maxSpeakers, sources.size());
+    if (mixed < sources.size()) {
+        std::nth_element(sources.begin(), sources.begin() + mixed, sources.end(), [](const Source& a, const Source& b) {
+            return a.loudness > b.loudness;
+        });
+    }
+
+    for (size_t i = 0; i < sources.size(); i++) {
+        auto& source = sources[i];
+
+        size_t read = source.stream->readData(scratch.data(), samples);
+        float gain = source.stream->getVolume();
+
+        float level = read > 0 ? util::simd::calcPcmVolume(scratch.data(), read) * gain : 0.f;
+        source.loudness += (level - source.loudness) * LOUDNESS_SMOOTHING;
+
+        if (i < mixed && read > 0 && gain > 0.f) {
+            util::simd::mixPcm(out, scratch.data(), read, gain);
+        }
+    }
+
+    mixSequence.fetch_add(1);
+}
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -0,0 +1,70 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#ifdef GLOBED_VOICE_SUPPORT
+
+#include <asp/sync.hpp>
+
+class AudioStream;
+
+/*
+* VoiceMixer plays any amount of voice streams through a single FMOD stream, instead of each one having its own.
+* The FMOD read callback sums the queued audio of all attached streams scaled by their volume,
+* mixing only the `maxSpeakers` loudest ones. Streams that don't make the cut are still drained so they stay in sync.
+*
+* The mixer never locks: the list of attached streams is an immutable snapshot published through an atomic pointer (RCU-style).
+* Attaching or detaching copies the list, swaps the pointer, and frees the old list once the mixer can no longer be using it.
+* The mixer also never allocates: each snapshot comes with a preallocated source list that the mixer swaps with its own.
+*/
+class VoiceMixer {
+public:
+    // how fast the loudness used for ranking speakers follows the actual loudness, per mixed chunk
+    static constexpr float LOUDNESS_SMOOTHING = 0.2f;
+
+    VoiceMixer(size_t maxSpeakers);
+    ~VoiceMixer();
+
+    // FMOD holds a pointer to the mixer, so it can't be copied or moved
+    VoiceMixer(const VoiceMixer&) = delete;
+    VoiceMixer& operator=(const VoiceMixer&) = delete;
+
+    void start();
+
+    // Streams must be detached before they are destroyed. Both wait for the mixer to finish the chunk it's currently mixing.
+    void attach(AudioStream* stream);
+    void detach(AudioStream* stream);
+
+private:
+    struct Source {
+        AudioStream* stream = nullptr;
+        float loudness = 0.f;
+    };
+
+    struct Snapshot {
+        size_t version;
+        std::vector<AudioStream*> streams;
+        // sized by the writer, owned by the mixer once published
+        std::vector<Source> sources;
+    };
+
+    FMOD::Sound* sound = nullptr;
+    FMOD::Channel* channel = nullptr;
+    size_t maxSpeakers;
+
+    std::atomic<Snapshot*> current;
+    // writers are serialized, this owns the snapshot in `current`
+    asp::Mutex<std::unique_ptr<Snapshot>> snapshot;
+    // odd while the mixer is mixing a chunk
+    std::atomic<size_t> mixSequence = 0;
+
+    // only used by the mixer thread
+    std::vector<Source> sources;
+    size_t sourcesVersion = 0;
+    std::vector<float> scratch;
+
+    void publish(std::unique_ptr<Snapshot>& owned, std::unique_ptr<Snapshot> next);
+    void syncSources(Snapshot& latest);
+    void mix(float* out, size_t samples);
+};
+
+#endif // GLOBED_VOICE_SUPPORT
@@ -2,39 +2,34 @@
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-void AudioSampleQueue::writeData(const DecodedOpusData& data) {
-    this->writeData(data.ptr, data.length);
+AudioSampleQueue::AudioSampleQueue(size_t capacity) : buf(capacity) {}
+
+size_t AudioSampleQueue::writeData(const DecodedOpusData& data) {
+    return this->writeData(data.ptr, data.length);
 }
 
-void AudioSampleQueue::writeData(const float* pcm, size_t length) {
-    buf.insert(buf.end(), pcm, pcm + length);
+size_t AudioSampleQueue::writeData(const float* pcm, size_t length) {
+    return buf.push(pcm, length);
 }
 
 size_t AudioSampleQueue::copyTo(float* dest, size_t samples) {
-    if (buf.size() < samples) {
-        size_t total = buf.size();
-
-        std::copy(buf.data(), buf.data() + total, dest);
-        buf.clear();
-        return total;
-    }
-
-    std::copy(buf.data(), buf.data() + samples, dest);
-    buf.erase(buf.begin(), buf.begin() + samples);
-
-    return samples;
+    return buf.pop(dest, samples);
 }
 
-size_t AudioSampleQueue::size() const {
-    return buf.size();
+size_t AudioSampleQueue::skip(size_t samples) {
+    return buf.skip(samples);
 }
 
 void AudioSampleQueue::clear() {
     buf.clear();
 }
 
-float* AudioSampleQueue::data() {
-    return buf.data();
+size_t AudioSampleQueue::size() const {
+    return buf.size();
+}
+
+size_t AudioSampleQueue::capacity() const {
+    return buf.capacity();
 }
 
-#endif // GLOBED_VOICE_SUPPORT
\ No newline at end of file
+#endif // GLOBED_VOICE_SUPPORT
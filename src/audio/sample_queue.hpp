@@ -4,27 +4,36 @@
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include "decoder.hpp"
+#include <util/collections.hpp>
 
+// Fixed-capacity queue of PCM samples. Lock-free, and safe to use from one writer and one reader thread at the same time.
 class AudioSampleQueue {
 public:
-    AudioSampleQueue() {};
-    // enable copying
-    AudioSampleQueue(const AudioSampleQueue&) = default;
-    AudioSampleQueue& operator=(const AudioSampleQueue&) = default;
+    // a bit over 2.5 seconds of audio at 24khz
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+    AudioSampleQueue(size_t capacity = DEFAULT_CAPACITY);
+
     // enable moving
     AudioSampleQueue(AudioSampleQueue&&) = default;
     AudioSampleQueue& operator=(AudioSampleQueue&&) = default;
 
-    void writeData(const DecodedOpusData& data);
-    void writeData(const float* pcm, size_t length);
-    // contrary to the name, this will erase the samples from this queue after copying them to `dest`
+    // writer side. returns the amount of samples written, samples that don't fit are dropped
+    size_t writeData(const DecodedOpusData& data);
+    size_t writeData(const float* pcm, size_t length);
+
+    // reader side. contrary to the name, this will erase the samples from this queue after copying them to `dest`
     size_t copyTo(float* dest, size_t samples);
-    size_t size() const;
+    // reader side. discards up to `samples` of the oldest samples, returns the amount discarded
+    size_t skip(size_t samples);
+    // reader side.
     void clear();
-    float* data();
+
+    size_t size() const;
+    size_t capacity() const;
 
 private:
-    std::vector<float> buf;
+    util::collections::SpscQueue<float> buf;
 };
 
 #endif // GLOBED_VOICE_SUPPORT
@@ -3,11 +3,16 @@
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include "manager.hpp"
+#include "mixer.hpp"
 #include <util/misc.hpp>
 
-AudioStream::AudioStream(AudioDecoder&& decoder)
-    : decoder(std::move(decoder)),
-      estimator(std::move(VolumeEstimator(VOICE_TARGET_SAMPLERATE))) {
+AudioStream::AudioStream(AudioDecoder&& decoder, VoiceMixer* mixer)
+    : mixer(mixer),
+      decoder(std::move(decoder)),
+      estimator(VOICE_TARGET_SAMPLERATE) {
+    // when played through a mixer, the stream has no fmod sound of its own
+    if (mixer) return;
+
     FMOD_CREATESOUNDEXINFO exinfo = {};
 
     exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
@@ -27,21 +32,12 @@ AudioStream::AudioStream(AudioDecoder&& decoder)
             return FMOD_OK;
         }
 
-        // write data..
-
         size_t neededSamples = len / sizeof(float);
-        size_t copied = stream->queue.lock()->copyTo(reinterpret_cast<float*>(data), neededSamples);
-        stream->estimator.lock()->feedData(reinterpret_cast<const float*>(data), copied);
-
-        if (copied != neededSamples) {
-            stream->starving = true;
-            // fill the rest with the void to not repeat stuff
-            for (size_t i = copied; i < neededSamples; i++) {
-                ((float*)data)[i] = 0.0f;
-            }
-        } else {
-            stream->starving = false;
-            stream->lastPlaybackTime = util::time::now();
+        size_t copied = stream->readData(reinterpret_cast<float*>(data), neededSamples);
+
+        // fill the rest with the void to not repeat stuff
+        for (size_t i = copied; i < neededSamples; i++) {
+            ((float*)data)[i] = 0.0f;
         }
 
         return FMOD_OK;
@@ -57,6 +53,12 @@ AudioStream::AudioStream(AudioDecoder&& decoder)
 }
 
 AudioStream::~AudioStream() {
+    this->waitForPump();
+
+    if (mixer && attached) {
+        mixer->detach(this);
+    }
+
     // honestly idk if this even does anything but i'm hoping it fixes a weird crash
     if (sound) {
         sound->setUserData(nullptr);
@@ -72,18 +74,37 @@ AudioStream::~AudioStream() {
 }
 
 AudioStream::AudioStream(AudioStream&& other) noexcept {
+    other.waitForPump();
+
+    // the mixer refers to streams by address, so the stream is detached while it's being moved
+    bool wasAttached = other.attached;
+    if (wasAttached) {
+        other.mixer->detach(&other);
+        other.attached = false;
+    }
+
     sound = other.sound;
     channel = other.channel;
+    mixer = other.mixer;
     other.sound = nullptr;
     other.channel = nullptr;
 
-    *queue.lock() = std::move(*other.queue.lock());
+    queue = std::move(other.queue);
     decoder = std::move(other.decoder);
-    *estimator.lock() = std::move(*other.estimator.lock());
+    jitterBuffer = std::move(other.jitterBuffer);
+    estimator = std::move(other.estimator);
+
+    if (wasAttached) {
+        mixer->attach(this);
+        attached = true;
+    }
 }
 
 AudioStream& AudioStream::operator=(AudioStream&& other) noexcept {
     if (this != &other) {
+        this->waitForPump();
+        other.waitForPump();
+
         if (this->sound) {
             this->sound->release();
         }
@@ -92,21 +113,48 @@ AudioStream& AudioStream::operator=(AudioStream&& other) noexcept {
             this->channel->stop();
         }
 
+        if (this->attached) {
+            this->mixer->detach(this);
+            this->attached = false;
+        }
+
+        bool wasAttached = other.attached;
+        if (wasAttached) {
+            other.mixer->detach(&other);
+            other.attached = false;
+        }
+
         this->sound = other.sound;
         this->channel = other.channel;
+        this->mixer = other.mixer;
 
         other.sound = nullptr;
         other.channel = nullptr;
 
-        *queue.lock() = std::move(*other.queue.lock());
+        queue = std::move(other.queue);
         decoder = std::move(other.decoder);
-        *estimator.lock() = std::move(*other.estimator.lock());
+        jitterBuffer = std::move(other.jitterBuffer);
+        estimator = std::move(other.estimator);
+
+        if (wasAttached) {
+            this->mixer->attach(this);
+            this->attached = true;
+        }
     }
 
     return *this;
 }
 
 void AudioStream::start() {
+    if (mixer) {
+        if (!attached) {
+            mixer->attach(this);
+            attached = true;
+        }
+
+        return;
+    }
+
     if (this->channel) {
         return;
     }
@@ -114,13 +162,56 @@ void AudioStream::start() {
     this->channel = GlobedAudioManager::get().playSound(sound);
 }
 
-Result<> AudioStream::writeData(const EncodedAudioFrame& frame) {
-    const auto& frames = frame.getFrames();
-    for (const auto& opusFrame : frames) {
-        auto decodedFrame_ = decoder.decode(opusFrame);
+size_t AudioStream::readData(float* dest, size_t samples) {
+    size_t copied = queue.copyTo(dest, samples);
+    estimator.feedData(dest, copied);
+
+    if (copied != samples) {
+        starving = true;
+    } else {
+        starving = false;
+        lastPlaybackTime = util::time::now();
+    }
+
+    return copied;
+}
+
+void AudioStream::writeData(const EncodedAudioFrame& frame) {
+    auto _lock = jitterMutex.lock();
+    jitterBuffer.push(frame, util::time::now());
+}
+
+Result<> AudioStream::pump() {
+    auto now = util::time::now();
+
+    while (queue.size() < PLAYOUT_QUEUED_FRAMES * VOICE_TARGET_FRAMESIZE) {
+        VoiceJitterBuffer::PlayoutKind kind;
+
+        // copy the frame out, so new frames can be pushed while this one is being decoded
+        {
+            auto _lock = jitterMutex.lock();
+            auto playout = jitterBuffer.pull(now);
+
+            kind = playout.kind;
+            if (playout.data) {
+                pumpFrame.assign(playout.data->begin(), playout.data->end());
+            } else {
+                pumpFrame.clear();
+            }
+        }
+
+        if (kind == VoiceJitterBuffer::PlayoutKind::Empty) {
+            break;
+        }
+
+        // for fec the data is the frame after the lost one, for plc there is no data
+        auto decodedFrame_ = kind == VoiceJitterBuffer::PlayoutKind::Frame
+            ? decoder.decode(pumpFrame.data(), pumpFrame.size())
+            : decoder.decodeLost(pumpFrame.empty() ? nullptr : pumpFrame.data(), pumpFrame.size());
+
         GLOBED_UNWRAP_INTO(decodedFrame_, auto decodedFrame);
 
-        queue.lock()->writeData(decodedFrame);
+        queue.writeData(decodedFrame);
 
         AudioDecoder::freeData(decodedFrame);
     }
@@ -128,8 +219,30 @@ Result<> AudioStream::writeData(const EncodedAudioFrame& frame) {
     return Ok();
 }
 
+void AudioStream::schedulePump(asp::thread::ThreadPool& pool) {
+    if (pumpScheduled.exchange(true, std::memory_order::acq_rel)) {
+        return;
+    }
+
+    pool.pushTask([this] {
+        auto result = this->pump();
+        if (result.isErr()) {
+            log::warn("failed to decode voice: {}", result.unwrapErr());
+        }
+
+        // must be the last time the stream is touched, the destructor waits for this
+        pumpScheduled.store(false, std::memory_order::release);
+    });
+}
+
+void AudioStream::waitForPump() {
+    while (pumpScheduled.load(std::memory_order::acquire)) {
+        std::this_thread::yield();
+    }
+}
+
 void AudioStream::writeData(const float* pcm, size_t samples) {
-    queue.lock()->writeData(pcm, samples);
+    queue.writeData(pcm, samples);
 }
 
 void AudioStream::setVolume(float volume) {
@@ -145,15 +258,20 @@ float AudioStream::getVolume() {
 }
 
 void AudioStream::updateEstimator(float dt) {
-    estimator.lock()->update(dt);
+    estimator.update(dt);
 }
 
 float AudioStream::getLoudness() {
-    return estimator.lock()->getVolume() * this->volume;
+    return estimator.getVolume() * this->volume;
 }
 
 util::time::time_point AudioStream::getLastPlaybackTime() {
     return lastPlaybackTime;
 }
 
+VoiceJitterStats AudioStream::getJitterStats() {
+    auto _lock = jitterMutex.lock();
+    return jitterBuffer.getStats();
+}
+
 #endif // GLOBED_VOICE_SUPPORT
@@ -6,14 +6,19 @@
 #include "frame.hpp"
 #include "sample_queue.hpp"
 #include "decoder.hpp"
+#include "jitter_buffer.hpp"
 #include "volume_estimator.hpp"
 
 #include <asp/sync.hpp>
+#include <asp/thread.hpp>
 #include <util/time.hpp>
 
+class VoiceMixer;
+
 class AudioStream {
 public:
-    AudioStream(AudioDecoder&& decoder);
+    // if `mixer` is not null, the stream is played through it instead of creating its own fmod sound
+    AudioStream(AudioDecoder&& decoder, VoiceMixer* mixer = nullptr);
     ~AudioStream();
 
     // prevent copying since we manually free the sound
@@ -24,10 +29,19 @@ public:
     AudioStream(AudioStream&& other) noexcept;
     AudioStream& operator=(AudioStream&& other) noexcept;
 
+    // amount of decoded opus frames kept queued for the mixer, the rest waits in the jitter buffer
+    static constexpr size_t PLAYOUT_QUEUED_FRAMES = 2;
+
     // start playing this stream
     void start();
-    // write an audio frame to this stream. returns error if opus decoding failed
-    Result<> writeData(const EncodedAudioFrame& frame);
+    // write an audio frame to the jitter buffer of this stream. it gets decoded by the next `pump`
+    void writeData(const EncodedAudioFrame& frame);
+    // decode frames from the jitter buffer until the mixer has enough queued. returns error if opus decoding failed
+    Result<> pump();
+    // run `pump` on the given pool, unless it's already queued or running there. should be called regularly
+    void schedulePump(asp::thread::ThreadPool& pool);
+    // read queued samples for playback, called from the fmod mixer thread. returns the amount of samples read
+    size_t readData(float* dest, size_t samples);
     // write raw audio data to this stream
     void writeData(const float* pcm, size_t samples);
 
@@ -42,16 +56,29 @@ public:
 
     util::time::time_point getLastPlaybackTime();
 
+    VoiceJitterStats getJitterStats();
+
     asp::AtomicBool starving = false; // true if there aren't enough samples in the queue
 
 private:
     FMOD::Sound* sound = nullptr;
     FMOD::Channel* channel = nullptr;
-    asp::Mutex<AudioSampleQueue> queue;
+    VoiceMixer* mixer = nullptr;
+    bool attached = false;
+    // written to by a decode worker and read by the fmod mixer thread, lock-free
+    AudioSampleQueue queue;
+    // only used by `pump`, which never runs twice at the same time for one stream
     AudioDecoder decoder;
-    asp::Mutex<VolumeEstimator> estimator;
-    float volume = 0.f;
+    std::vector<util::data::byte> pumpFrame;
+    std::atomic_bool pumpScheduled = false;
+    // pushed to by the main thread and pulled from by a decode worker
+    VoiceJitterBuffer jitterBuffer;
+    asp::Mutex<> jitterMutex;
+    VolumeEstimator estimator;
+    asp::AtomicF32 volume = 0.f; // read by the mixer thread when using a shared mixer
     util::time::time_point lastPlaybackTime;
+
+    void waitForPump();
 };
 
 #else
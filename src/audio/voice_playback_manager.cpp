@@ -1,17 +1,19 @@
 #include "voice_playback_manager.hpp"
 
 #include "manager.hpp"
+#include <managers/settings.hpp>
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-Result<> VoicePlaybackManager::playFrameStreamed(int playerId, const EncodedAudioFrame& frame) {
+void VoicePlaybackManager::playFrameStreamed(int playerId, const EncodedAudioFrame& frame) {
     // if the stream doesn't exist yet, create it
     if (!streams.contains(playerId)) {
         this->prepareStream(playerId);
     }
 
     auto& stream = streams.at(playerId);
-    return stream->writeData(frame);
+    stream->writeData(frame);
+    stream->schedulePump(*decodePool);
 }
 
 void VoicePlaybackManager::playRawDataStreamed(int playerId, const float* pcm, size_t samples) {
@@ -25,14 +27,29 @@ void VoicePlaybackManager::playRawDataStreamed(int playerId, const float* pcm, s
 
 void VoicePlaybackManager::stopAllStreams() {
     streams.clear();
+    mixer.reset();
 }
 
 void VoicePlaybackManager::prepareStream(int playerId) {
     if (streams.contains(playerId)) return;
 
+    // decoding a frame is cheap, but there can be many speakers at once.
+    // keep the pool small so voice doesn't compete with the game for cores
+    if (!decodePool) {
+        size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+        decodePool = std::make_unique<asp::thread::ThreadPool>(threads);
+    }
+
+    auto& settings = GlobedSettings::get();
+    if (settings.communication.sharedVoiceMixer && !mixer) {
+        mixer = std::make_unique<VoiceMixer>(settings.communication.mixedSpeakerLimit.get());
+        mixer->start();
+    }
+
     AudioDecoder decoder(VOICE_TARGET_SAMPLERATE, VOICE_TARGET_FRAMESIZE, VOICE_CHANNELS);
 
-    auto stream = std::make_unique<AudioStream>(std::move(decoder));
+    // streams created before the setting was toggled keep playing the way they were created
+    auto stream = std::make_unique<AudioStream>(std::move(decoder), settings.communication.sharedVoiceMixer ? mixer.get() : nullptr);
     stream->start();
     streams.emplace(playerId, std::move(stream));
 }
@@ -89,6 +106,12 @@ void VoicePlaybackManager::updateAllEstimators(float dt) {
     }
 }
 
+void VoicePlaybackManager::pumpAllStreams() {
+    for (const auto& [playerId, stream] : streams) {
+        stream->schedulePump(*decodePool);
+    }
+}
+
 float VoicePlaybackManager::getLoudness(int playerId) {
     if (!streams.contains(playerId)) return 0.f;
 
@@ -101,6 +124,12 @@ util::time::time_point VoicePlaybackManager::getLastPlaybackTime(int playerId) {
     return streams.at(playerId)->getLastPlaybackTime();
 }
 
+VoiceJitterStats VoicePlaybackManager::getJitterStats(int playerId) {
+    if (!streams.contains(playerId)) return {};
+
+    return streams.at(playerId)->getJitterStats();
+}
+
 void VoicePlaybackManager::forEachStream(std::function<void(int, AudioStream&)> func) {
     for (const auto& [accountId, stream] : streams) {
         func(accountId, *stream);
@@ -124,12 +153,16 @@ void VoicePlaybackManager::muteEveryone() {}
 void VoicePlaybackManager::setVolumeAll(float volume) {}
 void VoicePlaybackManager::updateEstimator(int playerId, float dt) {}
 void VoicePlaybackManager::updateAllEstimators(float dt) {}
+void VoicePlaybackManager::pumpAllStreams() {}
 float VoicePlaybackManager::getLoudness(int playerId) {
     return 0.f;
 }
 util::time::time_point VoicePlaybackManager::getLastPlaybackTime(int playerId) {
     return {};
 }
+VoiceJitterStats VoicePlaybackManager::getJitterStats(int playerId) {
+    return {};
+}
 void VoicePlaybackManager::forEachStream(std::function<void(int, AudioStream&)> func) {}
 
 #endif // GLOBED_VOICE_SUPPORT
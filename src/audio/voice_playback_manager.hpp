@@ -3,6 +3,8 @@
 #include <defs/minimal_geode.hpp>
 
 #include "stream.hpp"
+#include "jitter_buffer.hpp"
+#include "mixer.hpp"
 #include <util/time.hpp>
 #include <util/singleton.hpp>
 
@@ -14,7 +16,8 @@
 class VoicePlaybackManager : public SingletonBase<VoicePlaybackManager> {
 public:
 #ifdef GLOBED_VOICE_SUPPORT
-    Result<> playFrameStreamed(int playerId, const EncodedAudioFrame& frame);
+    // queue the frame for playback, it's decoded later on a worker thread
+    void playFrameStreamed(int playerId, const EncodedAudioFrame& frame);
 #endif
     void playRawDataStreamed(int playerId, const float* pcm, size_t samples);
     void stopAllStreams();
@@ -30,13 +33,21 @@ public:
     void updateEstimator(int playerId, float dt);
     void updateAllEstimators(float dt);
 
+    // schedule decoding of due frames from the jitter buffers, must be called regularly
+    void pumpAllStreams();
+
     float getLoudness(int playerId);
     util::time::time_point getLastPlaybackTime(int playerId);
+    VoiceJitterStats getJitterStats(int playerId);
 
     void forEachStream(std::function<void(int, AudioStream&)> func);
 
 private:
 #ifdef GLOBED_VOICE_SUPPORT
+    // both are created with the first stream and declared before `streams` so they outlive them.
+    // the mixer only exists when the shared mixer is enabled
+    std::unique_ptr<asp::thread::ThreadPool> decodePool;
+    std::unique_ptr<VoiceMixer> mixer;
     std::unordered_map<int, std::unique_ptr<AudioStream>> streams;
 #endif
 };
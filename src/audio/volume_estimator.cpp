@@ -5,20 +5,15 @@
 
 #ifdef GLOBED_VOICE_SUPPORT
 
-VolumeEstimator::VolumeEstimator(size_t sampleRate) {
-    this->sampleRate = sampleRate;
-}
+VolumeEstimator::VolumeEstimator(size_t sampleRate)
+    : sampleRate(sampleRate),
+      sampleQueue(static_cast<size_t>(static_cast<float>(sampleRate) * QUEUE_SIZE)) {}
 
-VolumeEstimator::VolumeEstimator() {
-    this->sampleRate = 0;
-}
+VolumeEstimator::VolumeEstimator() : VolumeEstimator(0) {}
 
 void VolumeEstimator::feedData(const float* pcm, size_t samples) {
+    // old samples are dropped in `update`, since only the reader can remove them
     sampleQueue.writeData(pcm, samples);
-
-    if (sampleQueue.size() > static_cast<float>(sampleRate) * BUFFER_SIZE) {
-        sampleQueue.clear();
-    }
 }
 
 void VolumeEstimator::update(float dt) {
@@ -28,6 +23,13 @@ void VolumeEstimator::update(float dt) {
 
     dt = std::clamp(dt, 0.0f, 0.25f);
 
+    // if more than BUFFER_SIZE is queued up (i.e. we weren't updated for a while), drop the oldest samples
+    const size_t maxBuffered = static_cast<size_t>(static_cast<float>(sampleRate) * BUFFER_SIZE);
+    const size_t buffered = sampleQueue.size();
+    if (buffered > maxBuffered) {
+        sampleQueue.skip(buffered - maxBuffered);
+    }
+
     const size_t needed = static_cast<size_t>(static_cast<float>(sampleRate) * BUFFER_SIZE * dt);
 
 #ifdef __clang__
@@ -6,14 +6,12 @@
 #include "sample_queue.hpp"
 #include <util/collections.hpp>
 
+// `feedData` may be called from a different thread than `update` and `getVolume`, without any locking.
 class VolumeEstimator {
 public:
     VolumeEstimator(size_t sampleRate);
     VolumeEstimator();
 
-    VolumeEstimator(const VolumeEstimator&) = default;
-    VolumeEstimator& operator=(const VolumeEstimator&) = default;
-
     VolumeEstimator(VolumeEstimator&&) = default;
     VolumeEstimator& operator=(VolumeEstimator&&) = default;
 
@@ -24,9 +22,12 @@ public:
     float getVolume();
 
 private:
+    // how much audio (in seconds) is kept for estimating, older samples are dropped
     static constexpr float BUFFER_SIZE = 1.0f;
+    // the queue has room for more than that, so the writer doesn't have to drop new samples until the reader catches up
+    static constexpr float QUEUE_SIZE = BUFFER_SIZE * 2.f;
 
-    float volume;
+    float volume = 0.f;
     size_t sampleRate;
     AudioSampleQueue sampleQueue;
 };
@@ -32,6 +32,7 @@ constexpr auto func_box_keypair = CRYPTO_JOIN(keypair);
 constexpr auto func_box_beforenm = CRYPTO_JOIN(beforenm);
 constexpr auto func_box_easy = CRYPTO_JOIN(easy_afternm);
 constexpr auto func_box_open_easy = CRYPTO_JOIN(open_easy_afternm);
+constexpr auto func_box_detached = CRYPTO_JOIN(detached_afternm);
 
 constexpr static size_t PREFIX_LEN = NONCE_LEN + MAC_LEN;
 
@@ -102,6 +103,20 @@ size_t CryptoBox::encryptInto(const byte* src, byte* dest, size_t size) {
     return size + PREFIX_LEN;
 }
 
+size_t CryptoBox::encryptWithHeadroom(byte* data, size_t size) {
+    byte* nonce = data;
+    byte* mac = data + NONCE_LEN;
+    byte* plaintext = data + PREFIX_LEN;
+
+    util::crypto::secureRandom(nonce, NONCE_LEN);
+
+    // detached_afternm encrypts the plaintext in place and writes the mac into the headroom right before it,
+    // which gives the same nonce + mac + ciphertext layout that open_easy_afternm expects on the other side
+    CRYPTO_ERR_CHECK(func_box_detached(plaintext, mac, plaintext, size, nonce, sharedKey), "func_box_detached failed")
+
+    return size + PREFIX_LEN;
+}
+
 size_t CryptoBox::decryptInto(const util::data::byte* src, util::data::byte* dest, size_t size) {
     CRYPTO_REQUIRE(size >= PREFIX_LEN, "message is too short")
 
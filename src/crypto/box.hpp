@@ -31,6 +31,10 @@ public:
     size_t encryptInto(const util::data::byte* src, util::data::byte* dest, size_t size);
     size_t decryptInto(const util::data::byte* src, util::data::byte* dest, size_t size);
 
+    // Encrypt `size` bytes located at `data + PREFIX_LEN` in place, and write the nonce and the MAC into the first `PREFIX_LEN` bytes.
+    // Produces the same output as `encryptInPlace`, but the plaintext does not have to be moved. Returns the length of the encrypted data.
+    size_t encryptWithHeadroom(util::data::byte* data, size_t size);
+
 private: // nuh uh
     util::data::byte* memBasePtr = nullptr;
 
@@ -32,7 +32,16 @@ ByteBuffer::ByteBuffer(const byte* data, size_t length)
 ByteBuffer::ByteBuffer(bytevector&& data)
     : _data(std::move(data)) {}
 
+ByteBuffer ByteBuffer::borrow(byte* data, size_t length) {
+    ByteBuffer buf;
+    buf._borrowed = data;
+    buf._borrowedSize = length;
+    return buf;
+}
+
 void ByteBuffer::rawWriteBytes(const byte* bytes, size_t length) {
+    GLOBED_REQUIRE(!_borrowed, "attempting to write into a borrowed ByteBuffer")
+
     // if we can't fit (i.e. writing at the end, just use insert)
     if (_position + length > _data.size()) {
         _data.insert(_data.begin() + _position, bytes, bytes + length);
@@ -49,7 +58,7 @@ void ByteBuffer::rawWriteBytes(const byte* bytes, size_t length) {
 }
 
 DecodeResult<> ByteBuffer::boundsCheck(size_t count) {
-    if (_position + count > _data.size()) {
+    if (_position + count > this->size()) {
         return Err(DecodeError::NotEnoughData);
     }
 
@@ -59,20 +68,36 @@ DecodeResult<> ByteBuffer::boundsCheck(size_t count) {
 /* Util methods */
 
 const bytevector& ByteBuffer::data() const {
+    GLOBED_REQUIRE(!_borrowed, "attempting to call ByteBuffer::data on a borrowed buffer")
     return _data;
 }
 
 bytevector& ByteBuffer::data() {
+    GLOBED_REQUIRE(!_borrowed, "attempting to call ByteBuffer::data on a borrowed buffer")
     return _data;
 }
 
+byte* ByteBuffer::rawData() {
+    return _borrowed ? _borrowed : _data.data();
+}
+
+const byte* ByteBuffer::rawData() const {
+    return _borrowed ? _borrowed : _data.data();
+}
+
+bool ByteBuffer::isBorrowed() const {
+    return _borrowed != nullptr;
+}
+
 void ByteBuffer::clear() {
     _data.clear();
+    _borrowed = nullptr;
+    _borrowedSize = 0;
     _position = 0;
 }
 
 size_t ByteBuffer::size() const {
-    return _data.size();
+    return _borrowed ? _borrowedSize : _data.size();
 }
 
 size_t ByteBuffer::getPosition() const {
@@ -84,6 +109,12 @@ void ByteBuffer::setPosition(size_t pos) {
 }
 
 void ByteBuffer::resize(size_t newSize) {
+    if (_borrowed) {
+        GLOBED_REQUIRE(newSize <= _borrowedSize, "attempting to grow a borrowed ByteBuffer")
+        _borrowedSize = newSize;
+        return;
+    }
+
     _data.resize(newSize);
 }
 
@@ -95,6 +126,11 @@ void ByteBuffer::shrink(size_t bytes) {
     this->resize(this->size() - bytes);
 }
 
+void ByteBuffer::reserve(size_t capacity) {
+    GLOBED_REQUIRE(!_borrowed, "attempting to reserve space in a borrowed ByteBuffer")
+    _data.reserve(capacity);
+}
+
 DecodeResult<> ByteBuffer::skip(size_t bytes) {
     GLOBED_UNWRAP(this->boundsCheck(bytes));
     _position += bytes;
@@ -104,7 +140,7 @@ DecodeResult<> ByteBuffer::skip(size_t bytes) {
 
 DecodeResult<> ByteBuffer::readBytesInto(byte* buf, size_t bytes) {
     GLOBED_UNWRAP(this->boundsCheck(bytes));
-    std::memcpy(buf, _data.data() + _position, bytes);
+    std::memcpy(buf, this->rawData() + _position, bytes);
     _position += bytes;
 
     return Ok();
@@ -128,7 +164,7 @@ template<> DecodeResult<std::string> ByteBuffer::customDecode() {
 
     GLOBED_UNWRAP(this->boundsCheck(length));
 
-    std::string str(reinterpret_cast<const char*>(_data.data() + _position), length);
+    std::string str(reinterpret_cast<const char*>(this->rawData() + _position), length);
     _position += length;
 
     return Ok(std::move(str));
@@ -204,9 +240,7 @@ template<> DecodeResult<ccColor4B> ByteBuffer::customDecode() {
     \
     template<> DecodeResult<bytearray<sz>> ByteBuffer::customDecode() { \
         bytearray<sz> out; \
-        for (size_t i = 0; i < sz; i++) { \
-            GLOBED_UNWRAP_INTO(this->readU8(), out[i]); \
-        } \
+        GLOBED_UNWRAP(this->readBytesInto(out.data(), sz)); \
         return Ok(out); \
     }
 
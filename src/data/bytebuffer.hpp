@@ -42,12 +42,59 @@ public:
     // Take ownership of the given `bytevector` and construct a `ByteBuffer` from the data
     ByteBuffer(util::data::bytevector&& data);
 
+    // Construct a `ByteBuffer` that borrows `length` bytes at `data` instead of copying them.
+    // The memory must outlive the returned buffer. Borrowed buffers can be read from and shrunk, but not written to.
+    static ByteBuffer borrow(util::data::byte* data, size_t length);
+
     ByteBuffer(const ByteBuffer& other) = default;
     ByteBuffer& operator=(const ByteBuffer& other) = default;
 
     ByteBuffer(ByteBuffer&& other) = default;
     ByteBuffer& operator=(ByteBuffer&& other) = default;
 
+    // Returned by `fixedEncodedSize` for types whose encoded size depends on their contents
+    static constexpr size_t DYNAMIC_SIZE = static_cast<size_t>(-1);
+
+    // Returns the amount of bytes `T` always encodes to, or `DYNAMIC_SIZE` if it varies (strings, vectors, optionals, etc.)
+    // Equivalent of `ENCODED_SIZE` on the server.
+    template <typename T>
+    static constexpr size_t fixedEncodedSize() {
+        if constexpr (util::data::IsPrimitive<T>) {
+            return sizeof(T);
+        } else if constexpr (std::is_enum_v<T>) {
+            return sizeof(std::underlying_type_t<T>);
+        } else if constexpr (util::misc::is_one_of<T, cocos2d::CCPoint, cocos2d::CCSize>) {
+            return sizeof(float) * 2;
+        } else if constexpr (std::is_same_v<T, cocos2d::ccColor3B>) {
+            return 3;
+        } else if constexpr (std::is_same_v<T, cocos2d::ccColor4B>) {
+            return 4;
+        } else if constexpr (IsByteArray<T>::value) {
+            return std::tuple_size_v<T>;
+        } else if constexpr (std::is_empty_v<T>) {
+            return 0;
+        } else if constexpr (boost::describe::has_describe_members<T>::value) {
+            if constexpr (IsBitfield<T>) {
+                return sizeof(BitBufferUnderlyingType<util::data::bitsToBytes(sizeof(T)) * 8>);
+            } else {
+                return fixedStructSize<T>();
+            }
+        } else {
+            return DYNAMIC_SIZE;
+        }
+    }
+
+    template <typename T>
+    static constexpr bool IsFixedSize = fixedEncodedSize<T>() != DYNAMIC_SIZE;
+
+    // Fixed-size structs are encoded and decoded with a single bounds check instead of one per field.
+    // Building with GLOBED_BYTEBUFFER_GENERIC turns this off, so that the generic path can be benchmarked against it.
+#ifdef GLOBED_BYTEBUFFER_GENERIC
+    static constexpr bool FIXED_SIZE_FAST_PATH = false;
+#else
+    static constexpr bool FIXED_SIZE_FAST_PATH = true;
+#endif
+
     // Read a value from this bytebuffer
     template <typename T>
     DecodeResult<T> readValue() {
@@ -68,6 +115,20 @@ public:
         }
     }
 
+    // Like `readValue`, but decodes into an existing object, reusing any storage it already owns (i.e. vector capacity).
+    // If an error is returned, `out` is left in an unspecified (but valid) state.
+    template <typename T>
+    DecodeResult<> readValueInto(T& out) {
+        if constexpr (util::misc::IsStdVector<T>::value) {
+            return this->pcDecodeVectorInto<typename T::value_type>(out);
+        } else if constexpr (boost::describe::has_describe_members<T>::value && !IsBitfield<T>) {
+            return this->reflectionDecodeInto<T>(out);
+        } else {
+            GLOBED_UNWRAP_INTO(this->readValue<T>(), out);
+            return Ok();
+        }
+    }
+
     // Write a value to this bytebuffer
     template <typename T>
     void writeValue(const T& value) {
@@ -95,12 +156,19 @@ public:
 
     /* Various helper methods */
 
-    // Get the underlying data buffer of this `ByteBuffer`
+    // Get the underlying data buffer of this `ByteBuffer`. Must not be called on a borrowed buffer.
     const util::data::bytevector& data() const;
 
-    // Get the underlying data buffer of this `ByteBuffer`
+    // Get the underlying data buffer of this `ByteBuffer`. Must not be called on a borrowed buffer.
     util::data::bytevector& data();
 
+    // Get a pointer to the start of the data, works for both owned and borrowed buffers
+    util::data::byte* rawData();
+    const util::data::byte* rawData() const;
+
+    // Returns whether this buffer borrows its data instead of owning it
+    bool isBorrowed() const;
+
     // Clear all the data in this buffer
     void clear();
 
@@ -122,6 +190,9 @@ public:
     // Equivalent to `resize(size() - bytes)`
     void shrink(size_t bytes);
 
+    // Ensure the internal buffer can hold at least `capacity` bytes without reallocating
+    void reserve(size_t capacity);
+
     // Skips the next `bytes` bytes. Returns an error if there aren't enough bytes to skip.
     DecodeResult<> skip(size_t bytes);
 
@@ -175,13 +246,35 @@ public:
     DecodeResult<> readBytesInto(util::data::byte* buf, size_t bytes);
 
 protected:
+    template <typename T>
+    static constexpr bool isBitfieldImpl() {
+        if constexpr (boost::describe::has_describe_bases<T>::value) {
+            using Bd = boost::describe::describe_bases<T, boost::describe::mod_any_access>;
+
+            if constexpr (!boost::mp11::mp_empty<Bd>::value) {
+                return std::is_same_v<typename boost::mp11::mp_first<Bd>::type, BitfieldBase>;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    static constexpr bool IsBitfield = isBitfieldImpl<T>();
+
+    template <typename>
+    struct IsByteArray : std::false_type {};
+
+    template <size_t N>
+    struct IsByteArray<util::data::bytearray<N>> : std::true_type {};
+
     // Read `sizeof(T)` bytes and reinterpret them as `T`. No endianness conversions are done.
     template <typename T>
     DecodeResult<T> rawRead() {
         GLOBED_UNWRAP(this->boundsCheck(sizeof(T)));
 
         T value;
-        std::memcpy(&value, _data.data() + _position, sizeof(T));
+        std::memcpy(&value, this->rawData() + _position, sizeof(T));
         _position += sizeof(T);
 
         return Ok(value);
@@ -230,6 +323,12 @@ protected:
 
         GLOBED_UNWRAP_INTO(this->readPrimitive<P>(), P underlying);
 
+        return this->enumFromUnderlying<E>(underlying);
+    }
+
+    // Validate and convert the underlying value of an enum
+    template <typename E, typename P = std::underlying_type_t<E>>
+    DecodeResult<E> enumFromUnderlying(P underlying) {
         // validate the enum - if there's no descriptor matching the decoded value, raise an error
 
         bool foundMatch = false;
@@ -281,6 +380,11 @@ protected:
             checkMissingFields<T>();
         }
 
+        if constexpr (FIXED_SIZE_FAST_PATH && IsFixedSize<T> && !IsBitfield<T>) {
+            GLOBED_UNWRAP(this->boundsCheck(fixedEncodedSize<T>()));
+            return this->readFixedUnchecked<T>();
+        }
+
         // create a default initialized instance
         T value;
 
@@ -310,6 +414,42 @@ protected:
         return Ok(std::move(value));
     }
 
+    // Read a value using boost reflection, into an existing instance
+    template <
+        typename T,
+        class Md = boost::describe::describe_members<T, boost::describe::mod_public>
+    >
+    DecodeResult<> reflectionDecodeInto(T& value) {
+        static_assert(std::is_class_v<T>, "attempted to call reflectionDecodeInto on a non-class type");
+        static_assert(!IsBitfield<T>, "reflectionDecodeInto cannot be used on bitfields");
+
+        checkMissingFields<T>();
+
+        if constexpr (FIXED_SIZE_FAST_PATH && IsFixedSize<T>) {
+            GLOBED_UNWRAP(this->boundsCheck(fixedEncodedSize<T>()));
+            return this->readFixedUncheckedInto<T>(value);
+        }
+
+        bool failed = false;
+        DecodeError failError;
+
+        boost::mp11::mp_for_each<Md>([&, this](auto descriptor) -> void {
+            if (failed) return;
+
+            auto result = this->readValueInto(value.*descriptor.pointer);
+            if (result.isErr()) {
+                failed = true;
+                failError = result.unwrapErr();
+            }
+        });
+
+        if (failed) {
+            return Err(std::move(failError));
+        }
+
+        return Ok();
+    }
+
     // Write a value using boost reflection
     template <
         typename T,
@@ -329,11 +469,167 @@ protected:
             checkMissingFields<T>();
         }
 
+        if constexpr (FIXED_SIZE_FAST_PATH && IsFixedSize<T> && !IsBitfield<T>) {
+            GLOBED_REQUIRE(!_borrowed, "attempting to write into a borrowed ByteBuffer")
+
+            // grow once for the entire struct, then write all the fields without any checks
+            size_t end = _position + fixedEncodedSize<T>();
+            if (end > _data.size()) {
+                _data.resize(end);
+            }
+
+            this->writeFixedUnchecked<T>(value);
+            return;
+        }
+
         boost::mp11::mp_for_each<Md>([&, this](auto descriptor) {
             this->writeValue(value.*descriptor.pointer);
         });
     }
 
+    /* Fixed-size encoding */
+
+    template <
+        typename T,
+        class Md = boost::describe::describe_members<T, boost::describe::mod_public>
+    >
+    static constexpr size_t fixedStructSize() {
+        size_t total = 0;
+
+        boost::mp11::mp_for_each<Md>([&](auto descriptor) {
+            using MPT = decltype(descriptor.pointer);
+            using FT = typename util::misc::MemberPtrToUnderlying<MPT>::type;
+
+            constexpr size_t size = fixedEncodedSize<FT>();
+
+            if (total == DYNAMIC_SIZE || size == DYNAMIC_SIZE) {
+                total = DYNAMIC_SIZE;
+            } else {
+                total += size;
+            }
+        });
+
+        return total;
+    }
+
+    // Write a fixed-size value. Does no bounds checking, the caller must ensure `fixedEncodedSize<T>()` bytes are available.
+    template <typename T>
+    void writeFixedUnchecked(const T& value) {
+        static_assert(IsFixedSize<T>, "type passed to writeFixedUnchecked must be fixed-size");
+
+        if constexpr (util::data::IsPrimitive<T>) {
+            T swapped = util::data::maybeByteswap(value);
+            std::memcpy(_data.data() + _position, &swapped, sizeof(T));
+            _position += sizeof(T);
+        } else if constexpr (std::is_enum_v<T>) {
+            this->writeFixedUnchecked(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_same_v<T, cocos2d::CCPoint>) {
+            this->writeFixedUnchecked(value.x);
+            this->writeFixedUnchecked(value.y);
+        } else if constexpr (std::is_same_v<T, cocos2d::CCSize>) {
+            this->writeFixedUnchecked(value.width);
+            this->writeFixedUnchecked(value.height);
+        } else if constexpr (util::misc::is_one_of<T, cocos2d::ccColor3B, cocos2d::ccColor4B>) {
+            this->writeFixedUnchecked(value.r);
+            this->writeFixedUnchecked(value.g);
+            this->writeFixedUnchecked(value.b);
+
+            if constexpr (std::is_same_v<T, cocos2d::ccColor4B>) {
+                this->writeFixedUnchecked(value.a);
+            }
+        } else if constexpr (IsByteArray<T>::value) {
+            std::memcpy(_data.data() + _position, value.data(), value.size());
+            _position += value.size();
+        } else if constexpr (std::is_empty_v<T>) {
+            // zst, do nothing
+        } else if constexpr (IsBitfield<T>) {
+            // space is already there, so this just overwrites it
+            this->reflectionEncodeBitfield<T>(value);
+        } else {
+            boost::mp11::mp_for_each<boost::describe::describe_members<T, boost::describe::mod_public>>([&, this](auto descriptor) {
+                this->writeFixedUnchecked(value.*descriptor.pointer);
+            });
+        }
+    }
+
+    // Read a fixed-size value. Does no bounds checking, the caller must ensure `fixedEncodedSize<T>()` bytes are available.
+    template <typename T>
+    DecodeResult<T> readFixedUnchecked() {
+        static_assert(IsFixedSize<T>, "type passed to readFixedUnchecked must be fixed-size");
+
+        if constexpr (util::data::IsPrimitive<T>) {
+            T value;
+            std::memcpy(&value, this->rawData() + _position, sizeof(T));
+            _position += sizeof(T);
+
+            return Ok(util::data::maybeByteswap(value));
+        } else if constexpr (std::is_enum_v<T>) {
+            GLOBED_UNWRAP_INTO(this->readFixedUnchecked<std::underlying_type_t<T>>(), auto underlying);
+            return this->enumFromUnderlying<T>(underlying);
+        } else if constexpr (util::misc::is_one_of<T, cocos2d::CCPoint, cocos2d::CCSize>) {
+            // floats can't fail to decode
+            float a = this->readFixedUnchecked<float>().unwrap();
+            float b = this->readFixedUnchecked<float>().unwrap();
+
+            return Ok(T { a, b });
+        } else if constexpr (util::misc::is_one_of<T, cocos2d::ccColor3B, cocos2d::ccColor4B>) {
+            T color;
+            color.r = this->readFixedUnchecked<uint8_t>().unwrap();
+            color.g = this->readFixedUnchecked<uint8_t>().unwrap();
+            color.b = this->readFixedUnchecked<uint8_t>().unwrap();
+
+            if constexpr (std::is_same_v<T, cocos2d::ccColor4B>) {
+                color.a = this->readFixedUnchecked<uint8_t>().unwrap();
+            }
+
+            return Ok(color);
+        } else if constexpr (IsByteArray<T>::value) {
+            T out;
+            std::memcpy(out.data(), this->rawData() + _position, out.size());
+            _position += out.size();
+
+            return Ok(out);
+        } else if constexpr (std::is_empty_v<T>) {
+            return Ok(T {});
+        } else if constexpr (IsBitfield<T>) {
+            return this->reflectionDecodeBitfield<T>();
+        } else {
+            T value;
+            GLOBED_UNWRAP(this->readFixedUncheckedInto<T>(value));
+
+            return Ok(std::move(value));
+        }
+    }
+
+    // Read the fields of a fixed-size struct into an existing instance. Does no bounds checking.
+    template <typename T>
+    DecodeResult<> readFixedUncheckedInto(T& value) {
+        bool failed = false;
+        DecodeError failError;
+
+        boost::mp11::mp_for_each<boost::describe::describe_members<T, boost::describe::mod_public>>([&, this](auto descriptor) -> void {
+            if (failed) return;
+
+            using MPT = decltype(descriptor.pointer);
+            using FT = typename util::misc::MemberPtrToUnderlying<MPT>::type;
+
+            // only enums can fail here
+            auto result = this->readFixedUnchecked<FT>();
+            if (result.isErr()) {
+                failed = true;
+                failError = result.unwrapErr();
+            } else {
+                value.*descriptor.pointer = std::move(result.unwrap());
+            }
+        });
+
+        if (failed) {
+            return Err(std::move(failError));
+        }
+
+        return Ok();
+    }
+
     template <
         typename T,
         class Md = boost::describe::describe_members<T, boost::describe::mod_public>
@@ -434,6 +730,30 @@ protected:
         return Ok(out);
     }
 
+    template<typename T>
+    DecodeResult<> pcDecodeVectorInto(std::vector<T>& out) {
+        GLOBED_UNWRAP_INTO(this->readLength(), auto length);
+
+        // decode in place into the elements we already have, only construct the rest
+        size_t reused = std::min(length, out.size());
+        out.erase(out.begin() + reused, out.end());
+
+        for (size_t i = 0; i < reused; i++) {
+            GLOBED_UNWRAP(this->readValueInto<T>(out[i]));
+        }
+
+        if (length > reused && sizeof(T) * length < (2 << 15)) {
+            out.reserve(length);
+        }
+
+        for (size_t i = reused; i < length; i++) {
+            GLOBED_UNWRAP_INTO(this->readValue<T>(), T val);
+            out.emplace_back(std::move(val));
+        }
+
+        return Ok();
+    }
+
     template<typename T>
     void pcEncodeVector(const std::vector<T>& vec) {
         this->writeLength(vec.size());
@@ -557,6 +877,10 @@ private:
     // Data members
     util::data::bytevector _data;
     size_t _position = 0;
+
+    // set if this buffer borrows its data, in which case `_data` is unused
+    util::data::byte* _borrowed = nullptr;
+    size_t _borrowedSize = 0;
 };
 
 // Custom error formatter
@@ -11,7 +11,7 @@
 * 2. in your class, inherit Packet and add GLOBED_PACKET(id, encrypt), encrypt should be true for packets that are sensitive.
 * 3. add the GLOBED_ENCODE or GLOBED_DECODE method
 * 4. For client packets, you may also choose to add a ::create(...) function and/or a constructor
-* 5. For server packets, in `all.cpp` add the packet to the switch as PACKET(cls).
+* 5. For server packets, add the packet to GLOBED_FOR_EACH_SERVER_PACKET below.
 */
 
 #pragma once
@@ -30,5 +30,51 @@
 #include "server/general.hpp"
 #include "server/room.hpp"
 
+// Calls X(cls) for every packet that can be received from the server.
+// This generates `matchPacket` and the packet dispatch table of the network manager.
+#define GLOBED_FOR_EACH_SERVER_PACKET(X) \
+    /* connection related */ \
+    X(PingResponsePacket) \
+    X(CryptoHandshakeResponsePacket) \
+    X(KeepaliveResponsePacket) \
+    X(ServerDisconnectPacket) \
+    X(LoggedInPacket) \
+    X(LoginFailedPacket) \
+    X(ProtocolMismatchPacket) \
+    X(KeepaliveTCPResponsePacket) \
+    X(ClaimThreadFailedPacket) \
+    X(LoginRecoveryFailecPacket) \
+    X(ServerNoticePacket) \
+    X(ServerBannedPacket) \
+    X(ServerMutedPacket) \
+    X(ConnectionTestResponsePacket) \
+    /* general */ \
+    X(GlobalPlayerListPacket) \
+    X(LevelListPacket) \
+    X(LevelPlayerCountPacket) \
+    X(RolesUpdatedPacket) \
+    /* game related */ \
+    X(PlayerProfilesPacket) \
+    X(LevelDataPacket) \
+    X(LevelPlayerMetadataPacket) \
+    X(AckedLevelDataPacket) \
+    X(VoiceBroadcastPacket) \
+    X(ChatMessageBroadcastPacket) \
+    /* room related */ \
+    X(RoomCreatedPacket) \
+    X(RoomJoinedPacket) \
+    X(RoomJoinFailedPacket) \
+    X(RoomPlayerListPacket) \
+    X(RoomInfoPacket) \
+    X(RoomInvitePacket) \
+    X(RoomListPacket) \
+    X(RoomCreateFailedPacket) \
+    /* admin related */ \
+    X(AdminAuthSuccessPacket) \
+    X(AdminErrorPacket) \
+    X(AdminUserDataPacket) \
+    X(AdminSuccessMessagePacket) \
+    X(AdminAuthFailedPacket)
+
 // Matches a packet by packet ID, returns nullptr if not found. Otherwise returns an Packet pointer with uninitialized data
-std::shared_ptr<Packet> matchPacket(packetid_t packetId);
\ No newline at end of file
+std::shared_ptr<Packet> matchPacket(packetid_t packetId);
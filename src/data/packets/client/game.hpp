@@ -59,6 +59,22 @@ class PlayerMetadataPacket : public Packet {
 
 GLOBED_SERIALIZABLE_STRUCT(PlayerMetadataPacket, (data));
 
+// 12005 - PlayerDataDeltaPacket
+// Sent instead of PlayerDataPacket when the server supports it. Carries either the full data (a keyframe),
+// or only the changes relative to a state that the server has already acknowledged.
+class PlayerDataDeltaPacket : public Packet {
+    GLOBED_PACKET(12005, PlayerDataDeltaPacket, false, false)
+
+    PlayerDataDeltaPacket() : data(PlayerData {}) {}
+    PlayerDataDeltaPacket(uint16_t seq, const PlayerData& keyframe) : seq(seq), data(keyframe) {}
+    PlayerDataDeltaPacket(uint16_t seq, const PlayerDataDelta& delta) : seq(seq), data(delta) {}
+
+    uint16_t seq;
+    Either<PlayerData, PlayerDataDelta> data;
+};
+
+GLOBED_SERIALIZABLE_STRUCT(PlayerDataDeltaPacket, (seq, data));
+
 #ifdef GLOBED_VOICE_SUPPORT
 
 #include <audio/frame.hpp>
@@ -22,8 +22,7 @@ using packetid_t = uint16_t;
         buf.writeValue<NonCvTy>(*this); \
     } \
     ByteBuffer::DecodeResult<> decode(ByteBuffer& buf) override { \
-        GLOBED_UNWRAP_INTO(buf.readValue<std::remove_reference_t<decltype(*this)>>(), *this); \
-        return Ok(); \
+        return buf.readValueInto<std::remove_reference_t<decltype(*this)>>(*this); \
     } \
     template <typename... Args> \
     static std::shared_ptr<Packet> create(Args&&... args) { \
@@ -69,3 +68,4 @@ struct PacketHeader {
 };
 
 GLOBED_SERIALIZABLE_STRUCT(PacketHeader, (id, encrypted));
+static_assert(ByteBuffer::fixedEncodedSize<PacketHeader>() == PacketHeader::SIZE);
@@ -21,8 +21,9 @@ class CryptoHandshakeResponsePacket : public Packet {
     CryptoHandshakeResponsePacket() {}
 
     CryptoPublicKey data;
+    ServerProtocolVersion protocol;
 };
-GLOBED_SERIALIZABLE_STRUCT(CryptoHandshakeResponsePacket, (data));
+GLOBED_SERIALIZABLE_STRUCT(CryptoHandshakeResponsePacket, (data, protocol));
 
 // 20002 - KeepaliveResponsePacket
 class KeepaliveResponsePacket : public Packet {
@@ -35,6 +35,22 @@ class LevelPlayerMetadataPacket : public Packet {
 
 GLOBED_SERIALIZABLE_STRUCT(LevelPlayerMetadataPacket, (players));
 
+// 22003 - AckedLevelDataPacket
+// Same as LevelDataPacket, but sent in response to PlayerDataDeltaPacket, `ack` is the sequence number of the data the server applied.
+// If `keyframeRequested` is set, the server couldn't apply the delta because it lost the baseline, `ack` is meaningless then.
+// Player data may be quantized, depending on the server and room settings.
+class AckedLevelDataPacket : public Packet {
+    GLOBED_PACKET(22003, AckedLevelDataPacket, false, false)
+
+    AckedLevelDataPacket() {}
+
+    uint16_t ack;
+    bool keyframeRequested = false;
+    QuantizedLevelData data;
+};
+
+GLOBED_SERIALIZABLE_STRUCT(AckedLevelDataPacket, (ack, keyframeRequested, data));
+
 #ifdef GLOBED_VOICE_SUPPORT
 # include <audio/frame.hpp>
 #endif
@@ -0,0 +1,16 @@
+#include "crypto.hpp"
+
+template<> void ByteBuffer::customEncode(const ServerProtocolVersion& data) {
+    this->writeU16(data.version);
+}
+
+template<> ByteBuffer::DecodeResult<ServerProtocolVersion> ByteBuffer::customDecode() {
+    // older servers end the packet before the version
+    if (this->getPosition() >= this->size()) {
+        return Ok(ServerProtocolVersion {});
+    }
+
+    GLOBED_UNWRAP_INTO(this->readU16(), auto version);
+
+    return Ok(ServerProtocolVersion(version));
+}
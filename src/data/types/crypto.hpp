@@ -16,3 +16,15 @@ public:
 };
 
 GLOBED_SERIALIZABLE_STRUCT(CryptoPublicKey, (key));
+
+// Protocol version of the server, sent at the end of the handshake response.
+// Servers older than v7 don't send it, in which case it's assumed to be v6.
+class ServerProtocolVersion {
+public:
+    static constexpr uint16_t LEGACY = 6;
+
+    ServerProtocolVersion() {}
+    ServerProtocolVersion(uint16_t version) : version(version) {}
+
+    uint16_t version = LEGACY;
+};
@@ -2,8 +2,56 @@
 
 #include <data/bitbuffer.hpp>
 
+#include <cmath>
+#include <limits>
+
 using namespace cocos2d;
 
+static BitBuffer<16> encodeIconFlags(const SpecificIconData& data) {
+    BitBuffer<16> bits;
+    bits.writeBits(
+        data.isVisible,
+        data.isLookingLeft,
+        data.isUpsideDown,
+        data.isDashing,
+        data.isMini,
+        data.isGrounded,
+        data.isStationary,
+        data.isFalling,
+        data.didJustJump,
+        data.isRotating,
+        data.isSideways
+    );
+
+    return bits;
+}
+
+static void decodeIconFlags(BitBuffer<16> bits, SpecificIconData& data) {
+    bits.readBitsInto(
+        data.isVisible,
+        data.isLookingLeft,
+        data.isUpsideDown,
+        data.isDashing,
+        data.isMini,
+        data.isGrounded,
+        data.isStationary,
+        data.isFalling,
+        data.didJustJump,
+        data.isRotating,
+        data.isSideways
+    );
+}
+
+static BitBuffer<8> encodePlayerFlags(const PlayerData& data) {
+    BitBuffer<8> bits;
+    bits.writeBits(data.isDead, data.isPaused, data.isPracticing, data.isDualMode, data.isInEditor, data.isEditorBuilding);
+    return bits;
+}
+
+static void decodePlayerFlags(BitBuffer<8> bits, PlayerData& data) {
+    bits.readBitsInto(data.isDead, data.isPaused, data.isPracticing, data.isDualMode, data.isInEditor, data.isEditorBuilding);
+}
+
 void SpecificIconData::copyFlagsFrom(const SpecificIconData& other) {
     iconType = other.iconType;
     isDashing = other.isDashing;
@@ -23,22 +71,7 @@ template<> void ByteBuffer::customEncode(const SpecificIconData& data) {
     this->writeValue(data.position);
     this->writeValue(data.rotation);
     this->writeValue(data.iconType);
-
-    BitBuffer<16> bits;
-    bits.writeBits(
-        data.isVisible,
-        data.isLookingLeft,
-        data.isUpsideDown,
-        data.isDashing,
-        data.isMini,
-        data.isGrounded,
-        data.isStationary,
-        data.isFalling,
-        data.didJustJump,
-        data.isRotating,
-        data.isSideways
-    );
-    this->writeBits(bits);
+    this->writeBits(encodeIconFlags(data));
 
     this->writeValue(data.spiderTeleportData);
 }
@@ -51,19 +84,7 @@ template<> ByteBuffer::DecodeResult<SpecificIconData> ByteBuffer::customDecode()
     GLOBED_UNWRAP_INTO(this->readValue<PlayerIconType>(), data.iconType);
 
     GLOBED_UNWRAP_INTO(this->readBits<16>(), auto bits);
-    bits.readBitsInto(
-        data.isVisible,
-        data.isLookingLeft,
-        data.isUpsideDown,
-        data.isDashing,
-        data.isMini,
-        data.isGrounded,
-        data.isStationary,
-        data.isFalling,
-        data.didJustJump,
-        data.isRotating,
-        data.isSideways
-    );
+    decodeIconFlags(bits, data);
 
     GLOBED_UNWRAP_INTO(this->readValue<std::optional<SpiderTeleportData>>(), data.spiderTeleportData);
 
@@ -77,9 +98,7 @@ template<> void ByteBuffer::customEncode(const PlayerData& data) {
     this->writeValue(data.lastDeathTimestamp);
     this->writeValue(data.currentPercentage);
 
-    BitBuffer<8> bits;
-    bits.writeBits(data.isDead, data.isPaused, data.isPracticing, data.isDualMode, data.isInEditor, data.isEditorBuilding);
-    this->writeBits(bits);
+    this->writeBits(encodePlayerFlags(data));
 }
 
 template<> ByteBuffer::DecodeResult<PlayerData> ByteBuffer::customDecode() {
@@ -92,7 +111,406 @@ template<> ByteBuffer::DecodeResult<PlayerData> ByteBuffer::customDecode() {
     GLOBED_UNWRAP_INTO(this->readValue<float>(), data.currentPercentage);
 
     GLOBED_UNWRAP_INTO(this->readBits<8>(), auto bits);
-    bits.readBitsInto(data.isDead, data.isPaused, data.isPracticing, data.isDualMode, data.isInEditor, data.isEditorBuilding);
+    decodePlayerFlags(bits, data);
 
     return Ok(data);
 }
+
+/* Deltas */
+
+// Returns false if the difference does not fit into 16 bits after quantizing.
+static bool quantizeDelta(float from, float to, float quantum, int16_t& out) {
+    float steps = std::round((to - from) / quantum);
+
+    if (!std::isfinite(steps)
+        || steps < std::numeric_limits<int16_t>::min()
+        || steps > std::numeric_limits<int16_t>::max()
+    ) {
+        return false;
+    }
+
+    out = static_cast<int16_t>(steps);
+    return true;
+}
+
+// the quantums are powers of two, so this gives the exact same result on the server
+static float dequantizeDelta(float base, int16_t delta, float quantum) {
+    return base + static_cast<float>(delta) * quantum;
+}
+
+SpecificIconDataDelta SpecificIconDataDelta::diff(const SpecificIconData& base, const SpecificIconData& current) {
+    SpecificIconDataDelta delta;
+
+    int16_t dx, dy;
+    if (quantizeDelta(base.position.x, current.position.x, POSITION_QUANTUM, dx)
+        && quantizeDelta(base.position.y, current.position.y, POSITION_QUANTUM, dy)
+    ) {
+        if (dx != 0 || dy != 0) {
+            delta.fields |= POSITION_DELTA;
+            delta.positionDeltaX = dx;
+            delta.positionDeltaY = dy;
+        }
+    } else {
+        delta.fields |= POSITION_ABSOLUTE;
+        delta.position = current.position;
+    }
+
+    int16_t drot;
+    if (quantizeDelta(base.rotation, current.rotation, ROTATION_QUANTUM, drot)) {
+        if (drot != 0) {
+            delta.fields |= ROTATION_DELTA;
+            delta.rotationDelta = drot;
+        }
+    } else {
+        delta.fields |= ROTATION_ABSOLUTE;
+        delta.rotation = current.rotation;
+    }
+
+    if (base.iconType != current.iconType) {
+        delta.fields |= ICON_TYPE;
+        delta.iconType = current.iconType;
+    }
+
+    auto flags = encodeIconFlags(current).contents();
+    if (flags != encodeIconFlags(base).contents()) {
+        delta.fields |= FLAGS;
+        delta.flags = flags;
+    }
+
+    if (current.spiderTeleportData) {
+        delta.fields |= SPIDER_TELEPORT;
+        delta.spiderTeleportData = current.spiderTeleportData;
+    }
+
+    return delta;
+}
+
+SpecificIconData SpecificIconDataDelta::apply(const SpecificIconData& base) const {
+    SpecificIconData data = base;
+
+    if (fields & POSITION_DELTA) {
+        data.position.x = dequantizeDelta(base.position.x, positionDeltaX, POSITION_QUANTUM);
+        data.position.y = dequantizeDelta(base.position.y, positionDeltaY, POSITION_QUANTUM);
+    } else if (fields & POSITION_ABSOLUTE) {
+        data.position = position;
+    }
+
+    if (fields & ROTATION_DELTA) {
+        data.rotation = dequantizeDelta(base.rotation, rotationDelta, ROTATION_QUANTUM);
+    } else if (fields & ROTATION_ABSOLUTE) {
+        data.rotation = rotation;
+    }
+
+    if (fields & ICON_TYPE) {
+        data.iconType = iconType;
+    }
+
+    if (fields & FLAGS) {
+        decodeIconFlags(BitBuffer<16>(flags), data);
+    }
+
+    data.spiderTeleportData = spiderTeleportData;
+
+    return data;
+}
+
+PlayerDataDelta PlayerDataDelta::diff(uint16_t baseline, const PlayerData& base, const PlayerData& current) {
+    PlayerDataDelta delta;
+    delta.baseline = baseline;
+    delta.timestamp = current.timestamp;
+
+    delta.player1 = SpecificIconDataDelta::diff(base.player1, current.player1);
+    if (delta.player1.fields != 0) {
+        delta.fields |= PLAYER1;
+    }
+
+    delta.player2 = SpecificIconDataDelta::diff(base.player2, current.player2);
+    if (delta.player2.fields != 0) {
+        delta.fields |= PLAYER2;
+    }
+
+    if (base.lastDeathTimestamp != current.lastDeathTimestamp) {
+        delta.fields |= LAST_DEATH_TIMESTAMP;
+        delta.lastDeathTimestamp = current.lastDeathTimestamp;
+    }
+
+    if (base.currentPercentage != current.currentPercentage) {
+        delta.fields |= CURRENT_PERCENTAGE;
+        delta.currentPercentage = current.currentPercentage;
+    }
+
+    auto flags = encodePlayerFlags(current).contents();
+    if (flags != encodePlayerFlags(base).contents()) {
+        delta.fields |= FLAGS;
+        delta.flags = flags;
+    }
+
+    return delta;
+}
+
+PlayerData PlayerDataDelta::apply(const PlayerData& base) const {
+    PlayerData data = base;
+    data.timestamp = timestamp;
+
+    // apply even if unchanged, to clear the spider teleports of the baseline
+    data.player1 = player1.apply(base.player1);
+    data.player2 = player2.apply(base.player2);
+
+    if (fields & LAST_DEATH_TIMESTAMP) {
+        data.lastDeathTimestamp = lastDeathTimestamp;
+    }
+
+    if (fields & CURRENT_PERCENTAGE) {
+        data.currentPercentage = currentPercentage;
+    }
+
+    if (fields & FLAGS) {
+        decodePlayerFlags(BitBuffer<8>(flags), data);
+    }
+
+    return data;
+}
+
+template<> void ByteBuffer::customEncode(const SpecificIconDataDelta& delta) {
+    using D = SpecificIconDataDelta;
+
+    this->writeU8(delta.fields);
+
+    if (delta.fields & D::POSITION_DELTA) {
+        this->writeI16(delta.positionDeltaX);
+        this->writeI16(delta.positionDeltaY);
+    }
+
+    if (delta.fields & D::POSITION_ABSOLUTE) {
+        this->writeValue(delta.position);
+    }
+
+    if (delta.fields & D::ROTATION_DELTA) {
+        this->writeI16(delta.rotationDelta);
+    }
+
+    if (delta.fields & D::ROTATION_ABSOLUTE) {
+        this->writeF32(delta.rotation);
+    }
+
+    if (delta.fields & D::ICON_TYPE) {
+        this->writeValue(delta.iconType);
+    }
+
+    if (delta.fields & D::FLAGS) {
+        this->writeU16(delta.flags);
+    }
+
+    if (delta.fields & D::SPIDER_TELEPORT) {
+        this->writeValue(delta.spiderTeleportData.value());
+    }
+}
+
+template<> ByteBuffer::DecodeResult<SpecificIconDataDelta> ByteBuffer::customDecode() {
+    using D = SpecificIconDataDelta;
+
+    D delta;
+
+    GLOBED_UNWRAP_INTO(this->readU8(), delta.fields);
+
+    if (delta.fields & D::POSITION_DELTA) {
+        GLOBED_UNWRAP_INTO(this->readI16(), delta.positionDeltaX);
+        GLOBED_UNWRAP_INTO(this->readI16(), delta.positionDeltaY);
+    }
+
+    if (delta.fields & D::POSITION_ABSOLUTE) {
+        GLOBED_UNWRAP_INTO(this->readValue<CCPoint>(), delta.position);
+    }
+
+    if (delta.fields & D::ROTATION_DELTA) {
+        GLOBED_UNWRAP_INTO(this->readI16(), delta.rotationDelta);
+    }
+
+    if (delta.fields & D::ROTATION_ABSOLUTE) {
+        GLOBED_UNWRAP_INTO(this->readF32(), delta.rotation);
+    }
+
+    if (delta.fields & D::ICON_TYPE) {
+        GLOBED_UNWRAP_INTO(this->readValue<PlayerIconType>(), delta.iconType);
+    }
+
+    if (delta.fields & D::FLAGS) {
+        GLOBED_UNWRAP_INTO(this->readU16(), delta.flags);
+    }
+
+    if (delta.fields & D::SPIDER_TELEPORT) {
+        GLOBED_UNWRAP_INTO(this->readValue<SpiderTeleportData>(), delta.spiderTeleportData);
+    }
+
+    return Ok(delta);
+}
+
+template<> void ByteBuffer::customEncode(const PlayerDataDelta& delta) {
+    using D = PlayerDataDelta;
+
+    this->writeU16(delta.baseline);
+    this->writeF32(delta.timestamp);
+    this->writeU8(delta.fields);
+
+    if (delta.fields & D::PLAYER1) {
+        this->writeValue(delta.player1);
+    }
+
+    if (delta.fields & D::PLAYER2) {
+        this->writeValue(delta.player2);
+    }
+
+    if (delta.fields & D::LAST_DEATH_TIMESTAMP) {
+        this->writeF32(delta.lastDeathTimestamp);
+    }
+
+    if (delta.fields & D::CURRENT_PERCENTAGE) {
+        this->writeF32(delta.currentPercentage);
+    }
+
+    if (delta.fields & D::FLAGS) {
+        this->writeU8(delta.flags);
+    }
+}
+
+template<> ByteBuffer::DecodeResult<PlayerDataDelta> ByteBuffer::customDecode() {
+    using D = PlayerDataDelta;
+
+    D delta;
+
+    GLOBED_UNWRAP_INTO(this->readU16(), delta.baseline);
+    GLOBED_UNWRAP_INTO(this->readF32(), delta.timestamp);
+    GLOBED_UNWRAP_INTO(this->readU8(), delta.fields);
+
+    if (delta.fields & D::PLAYER1) {
+        GLOBED_UNWRAP_INTO(this->readValue<SpecificIconDataDelta>(), delta.player1);
+    }
+
+    if (delta.fields & D::PLAYER2) {
+        GLOBED_UNWRAP_INTO(this->readValue<SpecificIconDataDelta>(), delta.player2);
+    }
+
+    if (delta.fields & D::LAST_DEATH_TIMESTAMP) {
+        GLOBED_UNWRAP_INTO(this->readF32(), delta.lastDeathTimestamp);
+    }
+
+    if (delta.fields & D::CURRENT_PERCENTAGE) {
+        GLOBED_UNWRAP_INTO(this->readF32(), delta.currentPercentage);
+    }
+
+    if (delta.fields & D::FLAGS) {
+        GLOBED_UNWRAP_INTO(this->readU8(), delta.flags);
+    }
+
+    return Ok(delta);
+}
+
+/* Quantized player data */
+
+static void writeQuantized(ByteBuffer& buf, float value, float origin, float quantum) {
+    int16_t steps;
+    if (quantizeDelta(origin, value, quantum, steps) && steps != PlayerDataCodec::ESCAPE) {
+        buf.writeI16(steps);
+    } else {
+        buf.writeI16(PlayerDataCodec::ESCAPE);
+        buf.writeF32(value);
+    }
+}
+
+static ByteBuffer::DecodeResult<float> readQuantized(ByteBuffer& buf, float origin, float quantum) {
+    GLOBED_UNWRAP_INTO(buf.readI16(), int16_t steps);
+
+    if (steps == PlayerDataCodec::ESCAPE) {
+        return buf.readF32();
+    }
+
+    return Ok(dequantizeDelta(origin, steps, quantum));
+}
+
+static void encodeQuantizedIcon(ByteBuffer& buf, const SpecificIconData& data, const CCPoint& origin, float quantum) {
+    writeQuantized(buf, data.position.x, origin.x, quantum);
+    writeQuantized(buf, data.position.y, origin.y, quantum);
+    writeQuantized(buf, data.rotation, 0.f, PlayerDataCodec::ROTATION_QUANTUM);
+    buf.writeValue(data.iconType);
+    buf.writeBits(encodeIconFlags(data));
+
+    buf.writeValue(data.spiderTeleportData);
+}
+
+static ByteBuffer::DecodeResult<SpecificIconData> decodeQuantizedIcon(ByteBuffer& buf, const CCPoint& origin, float quantum) {
+    SpecificIconData data;
+
+    GLOBED_UNWRAP_INTO(readQuantized(buf, origin.x, quantum), data.position.x);
+    GLOBED_UNWRAP_INTO(readQuantized(buf, origin.y, quantum), data.position.y);
+    GLOBED_UNWRAP_INTO(readQuantized(buf, 0.f, PlayerDataCodec::ROTATION_QUANTUM), data.rotation);
+    GLOBED_UNWRAP_INTO(buf.readValue<PlayerIconType>(), data.iconType);
+
+    GLOBED_UNWRAP_INTO(buf.readBits<16>(), auto bits);
+    decodeIconFlags(bits, data);
+
+    GLOBED_UNWRAP_INTO(buf.readValue<std::optional<SpiderTeleportData>>(), data.spiderTeleportData);
+
+    return Ok(data);
+}
+
+void PlayerDataCodec::encode(ByteBuffer& buf, const PlayerData& data) const {
+    if (!this->isQuantized()) {
+        buf.writeValue(data);
+        return;
+    }
+
+    float quantum = 1.f / static_cast<float>(1 << precision);
+
+    buf.writeValue(data.timestamp);
+    encodeQuantizedIcon(buf, data.player1, origin, quantum);
+    encodeQuantizedIcon(buf, data.player2, origin, quantum);
+    buf.writeValue(data.lastDeathTimestamp);
+    buf.writeValue(data.currentPercentage);
+
+    buf.writeBits(encodePlayerFlags(data));
+}
+
+ByteBuffer::DecodeResult<PlayerData> PlayerDataCodec::decode(ByteBuffer& buf) const {
+    if (!this->isQuantized()) {
+        return buf.readValue<PlayerData>();
+    }
+
+    float quantum = 1.f / static_cast<float>(1 << precision);
+
+    PlayerData data;
+
+    GLOBED_UNWRAP_INTO(buf.readValue<float>(), data.timestamp);
+    GLOBED_UNWRAP_INTO(decodeQuantizedIcon(buf, origin, quantum), data.player1);
+    GLOBED_UNWRAP_INTO(decodeQuantizedIcon(buf, origin, quantum), data.player2);
+    GLOBED_UNWRAP_INTO(buf.readValue<float>(), data.lastDeathTimestamp);
+    GLOBED_UNWRAP_INTO(buf.readValue<float>(), data.currentPercentage);
+
+    GLOBED_UNWRAP_INTO(buf.readBits<8>(), auto bits);
+    decodePlayerFlags(bits, data);
+
+    return Ok(data);
+}
+
+// the origin is only sent if quantization is enabled
+template<> void ByteBuffer::customEncode(const PlayerDataCodec& codec) {
+    this->writeU8(codec.precision);
+
+    if (codec.isQuantized()) {
+        this->writeValue(codec.origin);
+    }
+}
+
+template<> ByteBuffer::DecodeResult<PlayerDataCodec> ByteBuffer::customDecode() {
+    PlayerDataCodec codec;
+
+    GLOBED_UNWRAP_INTO(this->readU8(), codec.precision);
+    if (codec.precision > PlayerDataCodec::MAX_PRECISION) {
+        return Err(DecodeError::InvalidEnumValue);
+    }
+
+    if (codec.isQuantized()) {
+        GLOBED_UNWRAP_INTO(this->readValue<CCPoint>(), codec.origin);
+    }
+
+    return Ok(codec);
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <data/bytebuffer.hpp>
 
+#include <limits>
+
 enum class PlayerIconType : uint8_t {
     Unknown = 0,
     Cube = 1,
@@ -62,6 +64,77 @@ struct PlayerData {
     bool isEditorBuilding; // in the editor && not playtesting (incl. not paused)
 };
 
+// Difference between two `SpecificIconData` states. Only the fields that changed are encoded.
+// Position and rotation are sent as quantized differences when they fit into 16 bits, as absolute values otherwise.
+struct SpecificIconDataDelta {
+    static constexpr float POSITION_QUANTUM = 1.f / 64.f;
+    static constexpr float ROTATION_QUANTUM = 1.f / 32.f;
+
+    static constexpr uint8_t POSITION_DELTA = 1 << 0;
+    static constexpr uint8_t POSITION_ABSOLUTE = 1 << 1;
+    static constexpr uint8_t ROTATION_DELTA = 1 << 2;
+    static constexpr uint8_t ROTATION_ABSOLUTE = 1 << 3;
+    static constexpr uint8_t ICON_TYPE = 1 << 4;
+    static constexpr uint8_t FLAGS = 1 << 5;
+    static constexpr uint8_t SPIDER_TELEPORT = 1 << 6;
+
+    static SpecificIconDataDelta diff(const SpecificIconData& base, const SpecificIconData& current);
+
+    // Reconstruct the state this delta was made from. Spider teleports are events, so they are never carried over from `base`.
+    SpecificIconData apply(const SpecificIconData& base) const;
+
+    uint8_t fields = 0;
+
+    int16_t positionDeltaX = 0, positionDeltaY = 0;
+    cocos2d::CCPoint position;
+    int16_t rotationDelta = 0;
+    float rotation = 0.f;
+    PlayerIconType iconType = PlayerIconType::Unknown;
+    uint16_t flags = 0;
+    std::optional<SpiderTeleportData> spiderTeleportData;
+};
+
+// Difference between the `PlayerData` that was sent with the sequence number `baseline` and a newer one.
+struct PlayerDataDelta {
+    static constexpr uint8_t PLAYER1 = 1 << 0;
+    static constexpr uint8_t PLAYER2 = 1 << 1;
+    static constexpr uint8_t LAST_DEATH_TIMESTAMP = 1 << 2;
+    static constexpr uint8_t CURRENT_PERCENTAGE = 1 << 3;
+    static constexpr uint8_t FLAGS = 1 << 4;
+
+    static PlayerDataDelta diff(uint16_t baseline, const PlayerData& base, const PlayerData& current);
+
+    PlayerData apply(const PlayerData& base) const;
+
+    uint16_t baseline = 0;
+    float timestamp = 0.f;
+    uint8_t fields = 0;
+
+    SpecificIconDataDelta player1, player2;
+    float lastDeathTimestamp = 0.f;
+    float currentPercentage = 0.f;
+    uint8_t flags = 0;
+};
+
+// Encodes `PlayerData` with positions as 16-bit fixed point relative to `origin`, with a precision of 1 / 2^precision units,
+// and rotations as 16-bit fixed point with a precision of `ROTATION_QUANTUM` degrees.
+// Values that don't fit are escaped and sent as raw floats. Precision of 0 disables quantization, data is then encoded as-is.
+struct PlayerDataCodec {
+    static constexpr uint8_t MAX_PRECISION = 8;
+    static constexpr float ROTATION_QUANTUM = 1.f / 32.f;
+    static constexpr int16_t ESCAPE = std::numeric_limits<int16_t>::min();
+
+    bool isQuantized() const {
+        return precision != 0;
+    }
+
+    void encode(ByteBuffer& buf, const PlayerData& data) const;
+    ByteBuffer::DecodeResult<PlayerData> decode(ByteBuffer& buf) const;
+
+    uint8_t precision = 0;
+    cocos2d::CCPoint origin;
+};
+
 struct PlayerMetadata {
     uint32_t localBest;
     int32_t attempts;
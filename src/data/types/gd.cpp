@@ -0,0 +1,38 @@
+#include "gd.hpp"
+
+template<> void ByteBuffer::customEncode(const QuantizedLevelData& data) {
+    this->writeValue(data.codec);
+    this->writeLength(data.players.size());
+
+    for (const auto& player : data.players) {
+        this->writeI32(player.accountId);
+        data.codec.encode(*this, player.data);
+    }
+}
+
+template<> ByteBuffer::DecodeResult<> ByteBuffer::readValueInto(QuantizedLevelData& data) {
+    GLOBED_UNWRAP_INTO(this->readValue<PlayerDataCodec>(), data.codec);
+    GLOBED_UNWRAP_INTO(this->readLength(), auto length);
+
+    // keep the capacity, pooled packets decode into the same list every time
+    data.players.clear();
+
+    if (sizeof(AssociatedPlayerData) * length < (2 << 15)) {
+        data.players.reserve(length);
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        auto& player = data.players.emplace_back();
+
+        GLOBED_UNWRAP_INTO(this->readI32(), player.accountId);
+        GLOBED_UNWRAP_INTO(data.codec.decode(*this), player.data);
+    }
+
+    return Ok();
+}
+
+template<> ByteBuffer::DecodeResult<QuantizedLevelData> ByteBuffer::customDecode() {
+    QuantizedLevelData data;
+    GLOBED_UNWRAP(this->readValueInto(data));
+    return Ok(std::move(data));
+}
@@ -170,6 +170,15 @@ GLOBED_SERIALIZABLE_STRUCT(AssociatedPlayerData, (
     accountId, data
 ));
 
+// Data of multiple players, encoded with `codec`.
+struct QuantizedLevelData {
+    PlayerDataCodec codec;
+    std::vector<AssociatedPlayerData> players;
+};
+
+// Decodes into the existing player list instead of replacing it, see gd.cpp
+template<> ByteBuffer::DecodeResult<> ByteBuffer::readValueInto(QuantizedLevelData& data);
+
 class AssociatedPlayerMetadata {
 public:
     AssociatedPlayerMetadata(int accountId, const PlayerMetadata& data) : accountId(accountId), data(data) {}
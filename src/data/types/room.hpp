@@ -8,15 +8,16 @@ struct RoomSettingsFlags : BitfieldBase {
     bool publicInvites;
     bool collision;
     bool twoPlayerMode;
+    bool precisePositions; // disables quantization of player positions
 
     // we need the struct to be 2 bytes
-    bool _pad1, _pad2, _pad3, _pad4, _pad5;
+    bool _pad1, _pad2, _pad3, _pad4;
 };
 
 static_assert((sizeof(RoomSettingsFlags) + 7) / 8 == 2);
 
 GLOBED_SERIALIZABLE_BITFIELD(RoomSettingsFlags, (
-    isHidden, publicInvites, collision, twoPlayerMode
+    isHidden, publicInvites, collision, twoPlayerMode, precisePositions
 ))
 
 struct RoomSettings {
@@ -4,6 +4,7 @@
 /*
 * GLOBED_SOCKET_POLL - poll function
 * GLOBED_SOCKET_POLLFD - pollfd structure
+* GLOBED_HAS_MMSG - sendmmsg and recvmmsg are available (linux and android)
 */
 
 #ifdef GEODE_IS_WINDOWS
@@ -17,3 +18,7 @@
 # define GLOBED_SOCKET_POLLFD struct pollfd
 
 #endif
+
+#if defined(__linux__)
+# define GLOBED_HAS_MMSG 1
+#endif
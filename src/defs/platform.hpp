@@ -52,6 +52,12 @@
 #  define GLOBED_PLATFORM_STRING_ARCH "arm64"
 # define GLOBED_IS_ARM 1
 # define GLOBED_IS_ARM64 1
+#elif defined(GLOBED_STANDALONE)
+// built without geode (i.e. benchmarks), only the platform independent parts are available
+# define GLOBED_PLATFORM_STRING_PLATFORM "Standalone"
+# define GLOBED_PLATFORM_STRING_ARCH "x86_64"
+# define GLOBED_IS_X86_64 1
+# define GLOBED_IS_X86 1
 #endif
 
 #define GLOBED_PLATFORM_STRING GLOBED_PLATFORM_STRING_PLATFORM " " GLOBED_PLATFORM_STRING_ARCH
@@ -78,6 +84,10 @@
 # define GLOBED_HAS_FMOD GLOBED_FMOD_IOS
 # define GLOBED_HAS_DRPC GLOBED_DRPC_IOS
 # define GLOBED_HAS_KEYBINDS 0
+#elif defined(GLOBED_STANDALONE)
+# define GLOBED_HAS_FMOD 0
+# define GLOBED_HAS_DRPC 0
+# define GLOBED_HAS_KEYBINDS 0
 #else
 # error "what"
 #endif
@@ -1,6 +1,17 @@
 #pragma once
 
+// How much work is spent on a remote player each frame, depending on where they are relative to the camera
+enum class CullLevel : uint8_t {
+    Visible,    // on screen or right next to it, fully updated
+    Near,       // within 3 screens, fully updated so that animations are already right once they come into view
+    Far,        // further away, the player is hidden and only the progress indicators are kept up to date
+};
+
 struct GameCameraState {
+    // the area around the camera (in screens) that counts as visible and near
+    static constexpr float VISIBLE_SCALE = 1.5f;
+    static constexpr float NEAR_SCALE = 3.f;
+
     cocos2d::CCPoint cameraOrigin;
     cocos2d::CCPoint visibleOrigin;
     cocos2d::CCSize visibleCoverage;
@@ -9,4 +20,22 @@ struct GameCameraState {
     cocos2d::CCSize cameraCoverage() const {
         return visibleCoverage / zoom;
     }
+
+    // Returns whether the point is inside the camera coverage, scaled by `scale` around its center
+    bool contains(cocos2d::CCPoint point, float scale = 1.f) const {
+        cocos2d::CCSize origCoverage = this->cameraCoverage();
+        cocos2d::CCSize coverage = origCoverage * scale;
+        cocos2d::CCPoint origin = cameraOrigin - origCoverage * ((scale - 1.f) / 2.f);
+
+        return point.x >= origin.x
+            && point.x <= origin.x + coverage.width
+            && point.y >= origin.y
+            && point.y <= origin.y + coverage.height;
+    }
+
+    CullLevel cullLevel(cocos2d::CCPoint point) const {
+        if (this->contains(point, VISIBLE_SCALE)) return CullLevel::Visible;
+        if (this->contains(point, NEAR_SCALE)) return CullLevel::Near;
+        return CullLevel::Far;
+    }
 };
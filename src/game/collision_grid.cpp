@@ -0,0 +1,66 @@
+#include "collision_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void PlayerCollisionGrid::update(int playerId, bool second, cocos2d::CCPoint position) {
+    uint64_t icon = iconKey(playerId, second);
+    uint64_t cell = cellKey(cellCoord(position.x), cellCoord(position.y));
+
+    auto it = iconCells.find(icon);
+    if (it != iconCells.end()) {
+        if (it->second == cell) return;
+
+        this->removeFromCell(icon, it->second);
+        it->second = cell;
+    } else {
+        iconCells.emplace(icon, cell);
+    }
+
+    cells[cell].push_back(icon);
+}
+
+void PlayerCollisionGrid::remove(int playerId) {
+    for (bool second : {false, true}) {
+        uint64_t icon = iconKey(playerId, second);
+
+        auto it = iconCells.find(icon);
+        if (it == iconCells.end()) continue;
+
+        this->removeFromCell(icon, it->second);
+        iconCells.erase(it);
+    }
+}
+
+void PlayerCollisionGrid::clear() {
+    cells.clear();
+    iconCells.clear();
+}
+
+int PlayerCollisionGrid::cellCoord(float pos) {
+    return static_cast<int>(std::floor(pos / CELL_SIZE));
+}
+
+uint64_t PlayerCollisionGrid::cellKey(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+uint64_t PlayerCollisionGrid::iconKey(int playerId, bool second) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(playerId)) << 1) | (second ? 1 : 0);
+}
+
+void PlayerCollisionGrid::removeFromCell(uint64_t icon, uint64_t cell) {
+    auto it = cells.find(cell);
+    if (it == cells.end()) return;
+
+    auto& icons = it->second;
+    auto pos = std::find(icons.begin(), icons.end(), icon);
+    if (pos != icons.end()) {
+        *pos = icons.back();
+        icons.pop_back();
+    }
+
+    if (icons.empty()) {
+        cells.erase(it);
+    }
+}
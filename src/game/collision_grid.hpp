@@ -0,0 +1,55 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+/*
+* PlayerCollisionGrid is a uniform grid of remote player icons, used as a broadphase for player collision.
+*
+* Every icon is kept in the cell its position falls into. Positions are updated once per frame,
+* and an icon only has to be moved when it crosses into another cell, which is rare at this cell size.
+* A query visits the cells overlapping the rect, grown by `MAX_EXTENT` so that icons positioned in a neighbouring cell
+* but reaching into the rect are still found. The caller is expected to do the exact intersection check.
+*/
+class PlayerCollisionGrid {
+public:
+    static constexpr float CELL_SIZE = 120.f;
+    // how far the hitbox of an icon can reach from its position
+    static constexpr float MAX_EXTENT = 60.f;
+
+    void update(int playerId, bool second, cocos2d::CCPoint position);
+    void remove(int playerId);
+    void clear();
+
+    // Calls `func(playerId, second)` for every icon that could intersect the rect
+    template <typename F>
+    void query(const cocos2d::CCRect& rect, F&& func) const {
+        int minX = cellCoord(rect.getMinX() - MAX_EXTENT);
+        int maxX = cellCoord(rect.getMaxX() + MAX_EXTENT);
+        int minY = cellCoord(rect.getMinY() - MAX_EXTENT);
+        int maxY = cellCoord(rect.getMaxY() + MAX_EXTENT);
+
+        for (int x = minX; x <= maxX; x++) {
+            for (int y = minY; y <= maxY; y++) {
+                auto it = cells.find(cellKey(x, y));
+                if (it == cells.end()) continue;
+
+                for (uint64_t icon : it->second) {
+                    func(static_cast<int>(icon >> 1), (icon & 1) != 0);
+                }
+            }
+        }
+    }
+
+private:
+    // icons are `playerId << 1 | second`
+    std::unordered_map<uint64_t, std::vector<uint64_t>> cells;
+    std::unordered_map<uint64_t, uint64_t> iconCells;
+
+    static int cellCoord(float pos);
+    static uint64_t cellKey(int x, int y);
+    static uint64_t iconKey(int playerId, bool second);
+
+    void removeFromCell(uint64_t icon, uint64_t cell);
+};
@@ -1,126 +1,436 @@
 #include "interpolator.hpp"
 
-#include "lerp_logger.hpp"
-#include <hooks/gjbasegamelayer.hpp>
 #include <util/math.hpp>
-#include <util/debug.hpp>
-#include <util/format.hpp>
+#include <util/simd.hpp>
+
+#ifdef GLOBED_DEBUG_INTERPOLATION
+# include "lerp_logger.hpp"
+# include <hooks/gjbasegamelayer.hpp>
+# define LERP_LOG(method, ...) LerpLogger::get().method(__VA_ARGS__)
+#else
+// skip evaluating the arguments too, `getLocalTs` is not free
+# define LERP_LOG(method, ...)
+#endif
 
 using namespace geode::prelude;
 
+// channel indices in `Lanes`
+enum Channel {
+    P1X, P1Y, P1Rot, P2X, P2Y, P2Rot,
+    CHANNEL_COUNT,
+};
+
+static constexpr float INF = std::numeric_limits<float>::infinity();
+
 PlayerInterpolator::PlayerInterpolator(const InterpolatorSettings& settings) : settings(settings) {}
 
 void PlayerInterpolator::addPlayer(int playerId) {
-    players.emplace(playerId, PlayerState {});
+    if (slots.contains(playerId)) return;
+
+    slots.emplace(playerId, static_cast<uint32_t>(states.size()));
+    slotPlayers.push_back(playerId);
+    states.emplace_back();
+    lanes.push();
+
 #ifdef GLOBED_DEBUG_INTERPOLATION
     LerpLogger::get().reset(playerId);
 #endif
 }
 
 void PlayerInterpolator::removePlayer(int playerId) {
-    players.erase(playerId);
+    auto it = slots.find(playerId);
+    if (it == slots.end()) return;
+
+    uint32_t slot = it->second;
+    uint32_t last = states.size() - 1;
+
+    if (slot != last) {
+        states[slot] = std::move(states[last]);
+        slotPlayers[slot] = slotPlayers[last];
+        slots[slotPlayers[slot]] = slot;
+    }
+
+    lanes.swapRemove(slot);
+    states.pop_back();
+    slotPlayers.pop_back();
+    slots.erase(it);
 }
 
 bool PlayerInterpolator::hasPlayer(int playerId) {
-    return players.contains(playerId);
+    return slots.contains(playerId);
+}
+
+PlayerInterpolator::PlayerState& PlayerInterpolator::stateOf(int playerId) {
+    return states[slots.at(playerId)];
+}
+
+static void mergeFlags(FrameFlags& into, const FrameFlags& from) {
+    into.pendingDeath |= from.pendingDeath;
+    into.pendingP1Jump |= from.pendingP1Jump;
+    into.pendingP2Jump |= from.pendingP2Jump;
+    if (from.pendingP1Teleport) into.pendingP1Teleport = from.pendingP1Teleport;
+    if (from.pendingP2Teleport) into.pendingP2Teleport = from.pendingP2Teleport;
 }
 
 void PlayerInterpolator::updatePlayer(int playerId, const PlayerData& data, float updateCounter) {
-    auto& player = players.at(playerId);
+    uint32_t slot = slots.at(playerId);
+    auto& player = states[slot];
     player.updateCounter = updateCounter;
-    player.pendingRealFrame = true;
+
+    auto& frames = player.frames;
+
+    // the server keeps sending the last known data of a player until they send something new, ignore the repeats.
+    // if the timestamp went back by a lot, the player must have restarted their clock (i.e. rejoined the level)
+    bool restarted = false;
+    if (!frames.empty() && data.timestamp <= frames.back().timestamp) {
+        if (frames.back().timestamp - data.timestamp < 1.0f) return;
+
+        frames.clear();
+        player.lastPlayedTimestamp = -INF;
+        restarted = true;
+    }
+
     player.totalFrames++;
 
+    LerpFrame frame(data);
+
     if (!util::math::equal(player.lastDeathTimestamp, data.lastDeathTimestamp)) {
         player.lastDeathTimestamp = data.lastDeathTimestamp;
         if (player.totalFrames > 1) {
-            player.frameFlags.pendingDeath = true;
+            frame.flags.pendingDeath = true;
         }
     }
 
-    player.frameFlags.pendingP1Teleport = data.player1.spiderTeleportData;
-    player.frameFlags.pendingP2Teleport = data.player2.spiderTeleportData;
-    player.frameFlags.pendingP1Jump = data.player1.didJustJump;
-    player.frameFlags.pendingP2Jump = data.player1.didJustJump;
+    frame.flags.pendingP1Teleport = data.player1.spiderTeleportData;
+    frame.flags.pendingP2Teleport = data.player2.spiderTeleportData;
+    frame.flags.pendingP1Jump = data.player1.didJustJump;
+    frame.flags.pendingP2Jump = data.player2.didJustJump;
 
-    LerpLogger::get().logRealFrame(playerId, this->getLocalTs(), data.timestamp, data.player1);
+    LERP_LOG(logRealFrame, playerId, this->getLocalTs(), data.timestamp, data.player1);
 
     if (settings.realtime) {
         player.interpolatedState = data;
+        mergeFlags(player.frameFlags, frame.flags);
         return;
     }
 
-    player.olderFrame = player.newerFrame;
-    player.newerFrame = data;
+    // jitter estimation, same as RFC 3550
+    float transit = localTime - data.timestamp;
+    if (frames.empty()) {
+        lanes.transit[slot] = transit;
+        player.jitter = 0.f;
+    } else {
+        player.jitter += (std::abs(transit - player.lastTransit) - player.jitter) / 16.f;
+        lanes.transit[slot] += (transit - lanes.transit[slot]) / 16.f;
+    }
+    player.lastTransit = transit;
+
+    float delay = std::clamp(
+        settings.expectedDelta + JITTER_MULTIPLIER * player.jitter,
+        settings.expectedDelta,
+        std::max(settings.expectedDelta, MAX_PLAYOUT_DELAY)
+    );
+    lanes.playoutDelay[slot] = delay;
+
+    if (frames.empty() || restarted) {
+        lanes.playbackTime[slot] = localTime - lanes.transit[slot] - delay;
+    }
+
+    if (frames.full()) {
+        // a frame that was never played still has to dispatch its flags
+        auto& oldest = frames[0];
+        if (oldest.timestamp > player.lastPlayedTimestamp) {
+            mergeFlags(player.frameFlags, oldest.flags);
+            player.lastPlayedTimestamp = oldest.timestamp;
+        }
+
+        frames.popFront();
+    }
+
+    frames.push(std::move(frame));
 
-    player.timeCounter = player.olderFrame.timestamp;
+    // the current segment might be an extrapolation that should now be replaced, pick again on the next tick
+    lanes.segmentEnd[slot] = -INF;
 }
 
-static inline void lerpSpecific(
-        const SpecificIconData& older,
-        const SpecificIconData& newer,
-        SpecificIconData& out,
-        float lerpRatio
-    ) {
+// a segment is not smoothed if the player teleported, died or changed gamemodes in between
+static inline bool isContinuous(const PlayerInterpolator::LerpFrame& older, const PlayerInterpolator::LerpFrame& newer) {
+    if (newer.flags.pendingDeath || newer.flags.pendingP1Teleport || newer.flags.pendingP2Teleport) return false;
+    if (older.visual.player1.iconType != newer.visual.player1.iconType) return false;
+    if (older.visual.player2.iconType != newer.visual.player2.iconType) return false;
 
-    out.copyFlagsFrom(older);
+    float dt = newer.timestamp - older.timestamp;
+    float maxDistance = PlayerInterpolator::MAX_SMOOTHED_SPEED * dt;
 
-    // i hate spider
-    if (out.iconType == PlayerIconType::Spider && std::abs(older.position.y - newer.position.y) >= 33.f) {
-        out.position.x = std::lerp(older.position.x, newer.position.x, lerpRatio);
-        out.position.y = older.position.y;
-    } else {
-        out.position = older.position.lerp(newer.position, lerpRatio);
+    return older.visual.player1.position.getDistanceSq(newer.visual.player1.position) <= maxDistance * maxDistance
+        && older.visual.player2.position.getDistanceSq(newer.visual.player2.position) <= maxDistance * maxDistance;
+}
+
+static inline CCPoint velocity(const CCPoint& older, const CCPoint& newer, float dt) {
+    return (newer - older) / dt;
+}
+
+// Velocity of the player at the frame `idx`, from the neighbouring frames
+static CCPoint tangentAt(const PlayerInterpolator::FrameBuffer& frames, size_t idx, bool p2) {
+    auto pos = [&](size_t i) -> const CCPoint& {
+        return p2 ? frames[i].visual.player2.position : frames[i].visual.player1.position;
+    };
+
+    bool hasPrev = idx > 0 && isContinuous(frames[idx - 1], frames[idx]);
+    bool hasNext = idx + 1 < frames.size() && isContinuous(frames[idx], frames[idx + 1]);
+
+    if (hasPrev && hasNext) {
+        return velocity(pos(idx - 1), pos(idx + 1), frames[idx + 1].timestamp - frames[idx - 1].timestamp);
+    } else if (hasNext) {
+        return velocity(pos(idx), pos(idx + 1), frames[idx + 1].timestamp - frames[idx].timestamp);
+    } else if (hasPrev) {
+        return velocity(pos(idx - 1), pos(idx), frames[idx].timestamp - frames[idx - 1].timestamp);
     }
-    out.rotation = std::lerp(older.rotation, newer.rotation, lerpRatio);
+
+    return CCPoint{0.f, 0.f};
 }
 
-static inline void lerpPlayer(
-        const VisualPlayerState& older,
-        const VisualPlayerState& newer,
-        VisualPlayerState& out,
-        float lerpRatio
-    ) {
+static inline void copyState(const VisualPlayerState& from, VisualPlayerState& out) {
+    out.player1.copyFlagsFrom(from.player1);
+    out.player2.copyFlagsFrom(from.player2);
+    out.currentPercentage = from.currentPercentage;
+    out.isDead = from.isDead;
+    out.isPaused = from.isPaused;
+    out.isPracticing = from.isPracticing;
+    out.isDualMode = from.isDualMode;
+    out.isInEditor = from.isInEditor;
+    out.isEditorBuilding = from.isEditorBuilding;
+}
 
-    lerpSpecific(older.player1, newer.player1, out.player1, lerpRatio);
-    lerpSpecific(older.player2, newer.player2, out.player2, lerpRatio);
+namespace {
+    // Writes curves into the lanes of one slot
+    struct CurveWriter {
+        std::array<std::vector<float>, CHANNEL_COUNT>& c0, & c1, & c2, & c3;
+        uint32_t slot;
 
-    out.currentPercentage = older.currentPercentage;
-    out.isDead = older.isDead;
-    out.isPaused = older.isPaused;
-    out.isPracticing = older.isPracticing;
-    out.isDualMode = older.isDualMode;
-    out.isInEditor = older.isInEditor;
-    out.isEditorBuilding = older.isEditorBuilding;
+        void constant(Channel ch, float value) {
+            this->cubic(ch, value, 0.f, 0.f, 0.f);
+        }
+
+        void linear(Channel ch, float from, float to) {
+            this->cubic(ch, from, to - from, 0.f, 0.f);
+        }
+
+        // `m0` and `m1` are the tangents scaled to the segment length
+        void hermite(Channel ch, float p0, float m0, float p1, float m1) {
+            this->cubic(ch, p0, m0, 3.f * (p1 - p0) - 2.f * m0 - m1, 2.f * (p0 - p1) + m0 + m1);
+        }
+
+        void cubic(Channel ch, float a, float b, float c, float d) {
+            c0[ch][slot] = a;
+            c1[ch][slot] = b;
+            c2[ch][slot] = c;
+            c3[ch][slot] = d;
+        }
+
+        void hold(const VisualPlayerState& state) {
+            this->constant(P1X, state.player1.position.x);
+            this->constant(P1Y, state.player1.position.y);
+            this->constant(P1Rot, state.player1.rotation);
+            this->constant(P2X, state.player2.position.x);
+            this->constant(P2Y, state.player2.position.y);
+            this->constant(P2Rot, state.player2.rotation);
+        }
+    };
 }
 
 void PlayerInterpolator::tick(float dt) {
+    localTime += dt;
+
     if (settings.realtime) return;
 
-    for (auto& [playerId, player] : players) {
-        if (player.totalFrames < 2) continue;
+    static_assert(CHANNEL_COUNT == Lanes::CHANNELS);
+
+    size_t count = lanes.size();
+    if (count == 0) return;
+
+    // advance the playback clocks, nudging them towards the target delay
+    pendingSegments.clear();
+
+    float* transit = lanes.transit.data();
+    float* playoutDelay = lanes.playoutDelay.data();
+    float* playbackTime = lanes.playbackTime.data();
+    float* segmentStart = lanes.segmentStart.data();
+    float* segmentEnd = lanes.segmentEnd.data();
+    float* segmentInvLength = lanes.segmentInvLength.data();
+    float* progress = lanes.progress.data();
+
+    for (size_t i = 0; i < count; i++) {
+        float target = localTime - transit[i] - playoutDelay[i];
+        float diff = target - playbackTime[i];
+
+        bool resync = std::abs(diff) > RESYNC_THRESHOLD;
+        if (resync) {
+            playbackTime[i] = target;
+        } else {
+            float rate = std::clamp(1.f + diff * 2.f, 1.f - MAX_CLOCK_ADJUSTMENT, 1.f + MAX_CLOCK_ADJUSTMENT);
+            playbackTime[i] += dt * rate;
+        }
+
+        float time = playbackTime[i];
+        if (resync || time >= segmentEnd[i]) {
+            pendingSegments.push_back(static_cast<uint32_t>(i));
+        } else {
+            progress[i] = std::clamp((time - segmentStart[i]) * segmentInvLength[i], 0.f, 1.f);
+        }
+    }
+
+    for (uint32_t slot : pendingSegments) {
+        this->nextSegment(slot);
+    }
+
+    for (size_t ch = 0; ch < Lanes::CHANNELS; ch++) {
+        util::simd::evalCubic(
+            lanes.values[ch].data(),
+            lanes.c0[ch].data(), lanes.c1[ch].data(), lanes.c2[ch].data(), lanes.c3[ch].data(),
+            progress, count
+        );
+    }
+
+#ifdef GLOBED_DEBUG_INTERPOLATION
+    for (size_t i = 0; i < count; i++) {
+        auto& player = states[i];
 
-        float frameDelta = player.newerFrame.timestamp - player.olderFrame.timestamp;
-        if (frameDelta == 0.f) {
-            LerpLogger::get().logLerpSkip(playerId, this->getLocalTs(), player.timeCounter, player.interpolatedState.player1);
-            continue;
+        size_t ahead = 0;
+        for (size_t f = 0; f < player.frames.size(); f++) {
+            if (player.frames[f].timestamp > playbackTime[i]) ahead++;
         }
 
-        float lerpRatio = (player.timeCounter - player.olderFrame.timestamp) / frameDelta;
-        lerpPlayer(player.olderFrame.visual, player.newerFrame.visual, player.interpolatedState, lerpRatio);
+        LERP_LOG(logBufferState, slotPlayers[i], this->getLocalTs(), playbackTime[i], ahead, playoutDelay[i], player.jitter);
+        LERP_LOG(logLerpOperation, slotPlayers[i], this->getLocalTs(), playbackTime[i], this->getPlayerState(slotPlayers[i]).player1);
+    }
+#endif
+}
+
+void PlayerInterpolator::nextSegment(uint32_t slot) {
+    auto& player = states[slot];
+    auto& frames = player.frames;
+    float time = lanes.playbackTime[slot];
+
+    CurveWriter curve { lanes.c0, lanes.c1, lanes.c2, lanes.c3, slot };
+
+    auto setSegment = [&](float start, float end, float invLength) {
+        lanes.segmentStart[slot] = start;
+        lanes.segmentEnd[slot] = end;
+        lanes.segmentInvLength[slot] = invLength;
+        lanes.progress[slot] = std::clamp((time - start) * invLength, 0.f, 1.f);
+    };
+
+    if (frames.empty()) {
+        setSegment(0.f, INF, 0.f);
+        return;
+    }
+
+    // dispatch the flags of every frame we just passed
+    size_t ahead = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        auto& frame = frames[i];
+        if (frame.timestamp > time) {
+            ahead++;
+        } else if (frame.timestamp > player.lastPlayedTimestamp) {
+            mergeFlags(player.frameFlags, frame.flags);
+            player.lastPlayedTimestamp = frame.timestamp;
+        }
+    }
+
+    if (time < frames[0].timestamp) {
+        // not yet at the first frame
+        player.interpolatedState = frames[0].visual;
+        curve.hold(frames[0].visual);
+        setSegment(0.f, frames[0].timestamp, 0.f);
+
+        LERP_LOG(logLerpSkip, slotPlayers[slot], this->getLocalTs(), time, player.interpolatedState.player1);
+        return;
+    }
+
+    if (ahead == 0) {
+        // buffer underrun, keep moving for a bit with the last known velocity.
+        // the segment lasts until a new frame arrives, `updatePlayer` ends it early
+        const auto& newest = frames.back();
+        player.interpolatedState = newest.visual;
+        curve.hold(newest.visual);
+        setSegment(newest.timestamp, INF, 1.f / MAX_EXTRAPOLATION);
+
+        if (frames.size() < 2) {
+            LERP_LOG(logLerpSkip, slotPlayers[slot], this->getLocalTs(), time, player.interpolatedState.player1);
+            return;
+        }
 
-        LerpLogger::get().logLerpOperation(playerId, this->getLocalTs(), player.timeCounter, player.interpolatedState.player1);
+        const auto& prev = frames[frames.size() - 2];
+        if (!newest.visual.isDead && !newest.visual.isPaused && isContinuous(prev, newest)) {
+            float h = newest.timestamp - prev.timestamp;
+            auto v1 = velocity(prev.visual.player1.position, newest.visual.player1.position, h) * MAX_EXTRAPOLATION;
+            auto v2 = velocity(prev.visual.player2.position, newest.visual.player2.position, h) * MAX_EXTRAPOLATION;
+
+            const auto& p1 = newest.visual.player1.position;
+            const auto& p2 = newest.visual.player2.position;
+            curve.linear(P1X, p1.x, p1.x + v1.x);
+            curve.linear(P1Y, p1.y, p1.y + v1.y);
+            curve.linear(P2X, p2.x, p2.x + v2.x);
+            curve.linear(P2Y, p2.y, p2.y + v2.y);
+        }
 
-        player.timeCounter += dt;
+        // keep the previous frame around, it's needed for the velocity
+        if (frames.size() > 2) frames.popFront(frames.size() - 2);
+        return;
     }
+
+    size_t idx = frames.size() - ahead - 1;
+    const auto& older = frames[idx];
+    const auto& newer = frames[idx + 1];
+
+    float h = newer.timestamp - older.timestamp;
+    bool continuous = isContinuous(older, newer);
+
+    auto writeIcon = [&](const SpecificIconData& o, const SpecificIconData& n, Channel chX, Channel chY, Channel chRot, bool p2) {
+        curve.linear(chRot, o.rotation, n.rotation);
+
+        // i hate spider
+        if (o.iconType == PlayerIconType::Spider && std::abs(o.position.y - n.position.y) >= 33.f) {
+            curve.linear(chX, o.position.x, n.position.x);
+            curve.constant(chY, o.position.y);
+        } else if (continuous) {
+            auto m0 = tangentAt(frames, idx, p2) * h;
+            auto m1 = tangentAt(frames, idx + 1, p2) * h;
+            curve.hermite(chX, o.position.x, m0.x, n.position.x, m1.x);
+            curve.hermite(chY, o.position.y, m0.y, n.position.y, m1.y);
+        } else {
+            curve.linear(chX, o.position.x, n.position.x);
+            curve.linear(chY, o.position.y, n.position.y);
+        }
+    };
+
+    writeIcon(older.visual.player1, newer.visual.player1, P1X, P1Y, P1Rot, false);
+    writeIcon(older.visual.player2, newer.visual.player2, P2X, P2Y, P2Rot, true);
+    copyState(older.visual, player.interpolatedState);
+
+    setSegment(older.timestamp, newer.timestamp, 1.f / h);
+
+    // frames before `idx - 1` are not needed anymore
+    if (idx > 1) frames.popFront(idx - 1);
 }
 
 VisualPlayerState& PlayerInterpolator::getPlayerState(int playerId) {
-    return players.at(playerId).interpolatedState;
+    uint32_t slot = slots.at(playerId);
+    auto& state = states[slot].interpolatedState;
+
+    if (!settings.realtime) {
+        state.player1.position = CCPoint{lanes.values[P1X][slot], lanes.values[P1Y][slot]};
+        state.player1.rotation = lanes.values[P1Rot][slot];
+        state.player2.position = CCPoint{lanes.values[P2X][slot], lanes.values[P2Y][slot]};
+        state.player2.rotation = lanes.values[P2Rot][slot];
+    }
+
+    return state;
 }
 
 FrameFlags PlayerInterpolator::swapFrameFlags(int playerId) {
-    auto& state = players.at(playerId);
+    auto& state = this->stateOf(playerId);
     FrameFlags out;
     out.pendingDeath = util::misc::swapFlag(state.frameFlags.pendingDeath);
     out.pendingP1Jump = util::misc::swapFlag(state.frameFlags.pendingP1Jump);
@@ -133,13 +443,17 @@ FrameFlags PlayerInterpolator::swapFrameFlags(int playerId) {
 }
 
 bool PlayerInterpolator::isPlayerStale(int playerId, float lastServerPacket) {
-    auto uc = players.at(playerId).updateCounter;
+    auto uc = this->stateOf(playerId).updateCounter;
 
     return uc != 0.f && std::abs(uc - lastServerPacket) > 0.5f;
 }
 
 float PlayerInterpolator::getLocalTs() {
+#ifdef GLOBED_DEBUG_INTERPOLATION
     return GlobedGJBGL::get()->m_fields->timeCounter;
+#else
+    return 0.f;
+#endif
 }
 
 PlayerInterpolator::LerpFrame::LerpFrame() {
@@ -151,3 +465,42 @@ PlayerInterpolator::LerpFrame::LerpFrame(const PlayerData& data) {
     timestamp = data.timestamp;
     visual = data;
 }
+
+void PlayerInterpolator::FrameBuffer::push(LerpFrame&& frame) {
+    frames[(head + count) % BUFFER_SIZE] = std::move(frame);
+
+    if (count == BUFFER_SIZE) {
+        head = (head + 1) % BUFFER_SIZE;
+    } else {
+        count++;
+    }
+}
+
+void PlayerInterpolator::FrameBuffer::popFront(size_t n) {
+    n = std::min(n, count);
+    head = (head + n) % BUFFER_SIZE;
+    count -= n;
+}
+
+void PlayerInterpolator::FrameBuffer::clear() {
+    head = 0;
+    count = 0;
+}
+
+size_t PlayerInterpolator::Lanes::size() const {
+    return transit.size();
+}
+
+void PlayerInterpolator::Lanes::push() {
+    this->forEach([](std::vector<float>& lane) { lane.push_back(0.f); });
+
+    // no frames yet, nothing to pick until the first one arrives
+    segmentEnd.back() = INF;
+}
+
+void PlayerInterpolator::Lanes::swapRemove(size_t slot) {
+    this->forEach([slot](std::vector<float>& lane) {
+        lane[slot] = lane.back();
+        lane.pop_back();
+    });
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <limits>
+#include <vector>
+
 #include "visual_state.hpp"
 #include <data/types/game.hpp>
 
@@ -9,10 +13,36 @@ struct InterpolatorSettings {
     float expectedDelta;
 };
 
+/*
+* PlayerInterpolator keeps a small buffer of the most recent frames of every player and plays them back with a delay.
+*
+* The delay (playout delay) adapts to the measured arrival jitter of the player's frames, so that a late packet
+* normally still arrives before it's needed. Between frames, positions are interpolated with a cubic hermite spline,
+* using velocities estimated from the neighbouring frames. If the buffer does run dry, the last known velocity
+* is extrapolated for a short time, after which the player stays still until new data arrives.
+*
+* Players are stored densely by slot. Everything that is needed every frame (the playback clock and the curve that
+* every position and rotation follows in the current segment) lives in contiguous per-slot arrays, so a tick is a few
+* linear passes plus one SIMD curve evaluation. The frame buffers are only looked at when a player moves on to the next segment.
+*/
 class PlayerInterpolator {
 public:
     struct PlayerState;
 
+    // amount of frames remembered per player
+    static constexpr size_t BUFFER_SIZE = 16;
+    // the playout delay is `expectedDelta + JITTER_MULTIPLIER * jitter`, capped to `MAX_PLAYOUT_DELAY` seconds
+    static constexpr float JITTER_MULTIPLIER = 2.5f;
+    static constexpr float MAX_PLAYOUT_DELAY = 0.3f;
+    // the playback clock is gradually sped up or slowed down to follow the target delay, by at most this much
+    static constexpr float MAX_CLOCK_ADJUSTMENT = 0.1f;
+    // if the playback clock is off by more than this many seconds, it jumps instead
+    static constexpr float RESYNC_THRESHOLD = 0.25f;
+    // for how long (in seconds) the player can be extrapolated when no new data arrives
+    static constexpr float MAX_EXTRAPOLATION = 0.1f;
+    // moving faster than this (units per second) between two frames is considered a teleport and is not smoothed
+    static constexpr float MAX_SMOOTHED_SPEED = 2500.f;
+
     PlayerInterpolator(const InterpolatorSettings& settings);
 
     PlayerInterpolator(PlayerInterpolator&) = delete;
@@ -40,10 +70,51 @@ public:
     float getLocalTs();
 
 private:
-    std::unordered_map<int, PlayerState> players;
+    // Per-slot data that is touched every frame
+    struct Lanes {
+        // x, y and rotation of both icons
+        static constexpr size_t CHANNELS = 6;
+
+        // see `PlayerState`
+        std::vector<float> transit, playoutDelay, playbackTime;
+
+        // current segment, `progress` is how far into it the playback is (0 to 1).
+        // once the playback time reaches `segmentEnd`, the next segment has to be picked
+        std::vector<float> segmentStart, segmentEnd, segmentInvLength, progress;
+
+        // coefficients of the curve every channel follows in the current segment (cubic in `progress`), and its current value
+        std::array<std::vector<float>, CHANNELS> c0, c1, c2, c3, values;
+
+        size_t size() const;
+        void push();
+        // Moves the last slot into `slot` and removes the last slot
+        void swapRemove(size_t slot);
+
+        template <typename F>
+        void forEach(F&& func) {
+            func(transit); func(playoutDelay); func(playbackTime);
+            func(segmentStart); func(segmentEnd); func(segmentInvLength); func(progress);
+
+            for (size_t i = 0; i < CHANNELS; i++) {
+                func(c0[i]); func(c1[i]); func(c2[i]); func(c3[i]); func(values[i]);
+            }
+        }
+    };
+
     InterpolatorSettings settings;
+    float localTime = 0.f;
+
+    // maps player IDs to their slot in `states` and `lanes`
+    std::unordered_map<int, uint32_t> slots;
+    std::vector<int> slotPlayers;
+    std::vector<PlayerState> states;
+    Lanes lanes;
 
-    constexpr static bool EXTRAPOLATION = false;
+    std::vector<uint32_t> pendingSegments;
+
+    PlayerState& stateOf(int playerId);
+    // Dispatches the flags of the frames that were passed and picks the segment for the current playback time
+    void nextSegment(uint32_t slot);
 
 public:
 
@@ -53,17 +124,50 @@ public:
 
         float timestamp;
         VisualPlayerState visual;
+        FrameFlags flags;
+    };
+
+    // Ring buffer of frames, sorted by timestamp (oldest first)
+    class FrameBuffer {
+    public:
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        bool full() const { return count == BUFFER_SIZE; }
+
+        LerpFrame& operator[](size_t idx) { return frames[(head + idx) % BUFFER_SIZE]; }
+        const LerpFrame& operator[](size_t idx) const { return frames[(head + idx) % BUFFER_SIZE]; }
+
+        LerpFrame& back() { return (*this)[count - 1]; }
+
+        void push(LerpFrame&& frame);
+        void popFront(size_t n = 1);
+        void clear();
+
+    private:
+        std::array<LerpFrame, BUFFER_SIZE> frames;
+        size_t head = 0, count = 0;
     };
 
     struct PlayerState {
         float updateCounter = 0.0f;
-        float timeCounter = 0.0f;
         float lastDeathTimestamp = 0.0f;
         size_t totalFrames = 0;
 
-        LerpFrame olderFrame, newerFrame;
+        FrameBuffer frames;
+
+        // the following are kept in `Lanes`:
+        // transit - smoothed difference between our local time and the player's timestamps when a frame arrives
+        // playoutDelay - how far behind the newest frame the playback should be
+        // playbackTime - current playback position, in the player's timeline
+
+        // smoothed variation of the transit time between consecutive frames
+        float jitter = 0.0f;
+        float lastTransit = 0.0f;
+
+        // flags of frames with a timestamp up to this one have been dispatched already
+        float lastPlayedTimestamp = -std::numeric_limits<float>::infinity();
+
         VisualPlayerState interpolatedState;
-        bool pendingRealFrame = false;
         FrameFlags frameFlags;
     };
-};
\ No newline at end of file
+};
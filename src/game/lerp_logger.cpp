@@ -9,6 +9,7 @@ void LerpLogger::reset(uint32_t id) {
     player.realExtrapolatedFrames.clear();
     player.lerpedFrames.clear();
     player.lerpSkippedFrames.clear();
+    player.bufferStates.clear();
 #endif
 }
 
@@ -43,6 +44,19 @@ void LerpLogger::logLerpSkip(uint32_t id, float localts, float timeCounter, cons
 #endif
 }
 
+void LerpLogger::logBufferState(uint32_t id, float localts, float playbackTime, size_t depth, float playoutDelay, float jitter) {
+#ifdef GLOBED_DEBUG_INTERPOLATION
+    auto& player = this->ensureExists(id);
+    player.bufferStates.push_back(BufferLogData {
+        .localTimestamp = localts,
+        .playbackTime = playbackTime,
+        .depth = static_cast<uint32_t>(depth),
+        .playoutDelay = playoutDelay,
+        .jitter = jitter,
+    });
+#endif
+}
+
 PlayerLog& LerpLogger::ensureExists(uint32_t id) {
 #ifdef GLOBED_DEBUG_INTERPOLATION
     if (!players.contains(id)) {
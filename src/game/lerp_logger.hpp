@@ -13,15 +13,25 @@ struct PlayerLogData {
     float rotation;
 };
 
+struct BufferLogData {
+    float localTimestamp;
+    float playbackTime;
+    uint32_t depth;         // frames in the buffer that are newer than the playback time
+    float playoutDelay;
+    float jitter;
+};
+
 struct PlayerLog {
     std::vector<PlayerLogData> realFrames;
     std::vector<std::pair<PlayerLogData, PlayerLogData>> realExtrapolatedFrames;
     std::vector<PlayerLogData> lerpedFrames;
     std::vector<PlayerLogData> lerpSkippedFrames;
+    std::vector<BufferLogData> bufferStates;
 };
 
 GLOBED_SERIALIZABLE_STRUCT(PlayerLogData, (localTimestamp, timestamp, position, rotation));
-GLOBED_SERIALIZABLE_STRUCT(PlayerLog, (realFrames, realExtrapolatedFrames, lerpedFrames, lerpSkippedFrames));
+GLOBED_SERIALIZABLE_STRUCT(BufferLogData, (localTimestamp, playbackTime, depth, playoutDelay, jitter));
+GLOBED_SERIALIZABLE_STRUCT(PlayerLog, (realFrames, realExtrapolatedFrames, lerpedFrames, lerpSkippedFrames, bufferStates));
 
 class LerpLogger : public SingletonBase<LerpLogger> {
 public:
@@ -35,6 +45,9 @@ public:
     void logLerpOperation(uint32_t player, float localts, float timeCounter, const SpecificIconData& data);
     void logLerpSkip(uint32_t player, float localts, float timeCounter, const SpecificIconData& data);
 
+    // jitter buffer logging
+    void logBufferState(uint32_t player, float localts, float playbackTime, size_t depth, float playoutDelay, float jitter);
+
     void makeDump(const std::filesystem::path path);
 
 private:
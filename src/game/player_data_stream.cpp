@@ -0,0 +1,69 @@
+#include "player_data_stream.hpp"
+
+// true if `a` was sent after `b`, accounting for wraparound
+static bool isNewer(uint16_t a, uint16_t b) {
+    return static_cast<int16_t>(a - b) > 0;
+}
+
+std::shared_ptr<PlayerDataDeltaPacket> PlayerDataStream::makePacket(const PlayerData& data) {
+    uint16_t seq = nextSeq++;
+    auto* baseline = this->findBaseline(seq);
+
+    std::shared_ptr<PlayerDataDeltaPacket> packet;
+    PlayerData sent;
+
+    if (baseline && sinceKeyframe < KEYFRAME_INTERVAL) {
+        auto delta = PlayerDataDelta::diff(lastAck.value(), *baseline, data);
+
+        // remember what the server is going to reconstruct and not the real data, so quantization errors don't add up
+        sent = delta.apply(*baseline);
+        packet = std::make_shared<PlayerDataDeltaPacket>(seq, delta);
+        sinceKeyframe++;
+    } else {
+        sent = data;
+        packet = std::make_shared<PlayerDataDeltaPacket>(seq, data);
+        sinceKeyframe = 0;
+    }
+
+    history[seq % HISTORY_SIZE] = Entry {
+        .seq = seq,
+        .data = std::move(sent),
+    };
+
+    return packet;
+}
+
+void PlayerDataStream::acknowledge(uint16_t seq) {
+    // ignore sequence numbers that we haven't used yet
+    if (isNewer(seq, static_cast<uint16_t>(nextSeq - 1))) return;
+
+    if (!lastAck || isNewer(seq, lastAck.value())) {
+        lastAck = seq;
+    }
+}
+
+void PlayerDataStream::requestKeyframe() {
+    // the server lost our baseline, so forget it too. until a new state is acknowledged, only keyframes are sent.
+    // the history goes as well, so a late ack of an older state doesn't bring back a baseline the server doesn't have
+    history = {};
+    lastAck = std::nullopt;
+    sinceKeyframe = KEYFRAME_INTERVAL;
+}
+
+void PlayerDataStream::reset() {
+    history = {};
+    lastAck = std::nullopt;
+    sinceKeyframe = KEYFRAME_INTERVAL;
+}
+
+const PlayerData* PlayerDataStream::findBaseline(uint16_t seq) {
+    if (!lastAck) return nullptr;
+
+    uint16_t age = seq - lastAck.value();
+    if (age >= HISTORY_SIZE) return nullptr;
+
+    auto& entry = history[lastAck.value() % HISTORY_SIZE];
+    if (!entry || entry->seq != lastAck.value()) return nullptr;
+
+    return &entry->data;
+}
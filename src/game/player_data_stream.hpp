@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <optional>
+
+#include <data/packets/client/game.hpp>
+
+// Turns the local player data into `PlayerDataDeltaPacket`s, sending only the changes since the last state acknowledged by the server.
+class PlayerDataStream {
+public:
+    // amount of sent states that are remembered. must not be bigger than the history on the server
+    static constexpr size_t HISTORY_SIZE = 16;
+    // send the full data at least this often, in case the server lost our baseline
+    static constexpr size_t KEYFRAME_INTERVAL = 30;
+
+    std::shared_ptr<PlayerDataDeltaPacket> makePacket(const PlayerData& data);
+
+    // Called with the sequence number from `AckedLevelDataPacket`, older or unknown numbers are ignored.
+    void acknowledge(uint16_t seq);
+
+    // Called when the server says it can't apply our deltas. Only keyframes are sent until the next `acknowledge`.
+    void requestKeyframe();
+
+    void reset();
+
+private:
+    struct Entry {
+        uint16_t seq;
+        PlayerData data;
+    };
+
+    std::array<std::optional<Entry>, HISTORY_SIZE> history;
+    std::optional<uint16_t> lastAck;
+    uint16_t nextSeq = 0;
+    size_t sinceKeyframe = KEYFRAME_INTERVAL;
+
+    const PlayerData* findBaseline(uint16_t seq);
+};
@@ -0,0 +1,116 @@
+#include "send_rate.hpp"
+
+#include <cmath>
+
+void SendRateController::reset(uint32_t tps) {
+    *this = SendRateController{};
+    this->tps = std::max(tps, 1u);
+}
+
+bool SendRateController::shouldSend(const PlayerData& data, bool hasPeers) {
+    tick++;
+
+    // jumps and teleports are only flagged for a single tick, so send them right away.
+    // they also count as a change, which keeps us at full rate long enough to send the cleared flags afterwards
+    if (!lastSent || hasEvent(data) || differs(*lastSent, data)) {
+        lastOwnChange = tick;
+    }
+
+    uint32_t interval;
+    if (!hasPeers) {
+        interval = this->secondsToTicks(NO_PEERS_INTERVAL);
+    } else {
+        uint32_t hold = this->secondsToTicks(ACTIVE_HOLD);
+        bool active = tick - lastOwnChange < hold || tick - lastPeerChange < hold;
+
+        if (active) {
+            interval = 1;
+        } else if (data.isPaused) {
+            interval = this->secondsToTicks(PAUSED_INTERVAL);
+        } else {
+            interval = this->secondsToTicks(IDLE_INTERVAL);
+        }
+    }
+
+    // with no peers, events don't need to be delivered immediately
+    bool send = !lastSent || tick - lastSentTick >= interval || (hasPeers && lastOwnChange == tick);
+
+    windowTicks++;
+    if (send) {
+        windowSends++;
+        lastSentTick = tick;
+        lastSent = data;
+    }
+
+    if (windowTicks >= tps) {
+        effectiveRate = static_cast<float>(windowSends) * tps / windowTicks;
+        windowTicks = 0;
+        windowSends = 0;
+    }
+
+    return send;
+}
+
+void SendRateController::onPeerData(int playerId, const PlayerData& data) {
+    auto it = peers.find(playerId);
+    if (it == peers.end()) {
+        peers.emplace(playerId, data);
+        lastPeerChange = tick;
+        return;
+    }
+
+    if (hasEvent(data) || differs(it->second, data)) {
+        it->second = data;
+        lastPeerChange = tick;
+    }
+}
+
+void SendRateController::removePeer(int playerId) {
+    peers.erase(playerId);
+}
+
+float SendRateController::getEffectiveRate() const {
+    return effectiveRate;
+}
+
+uint32_t SendRateController::secondsToTicks(float secs) const {
+    return std::max(static_cast<uint32_t>(std::lround(secs * tps)), 1u);
+}
+
+bool SendRateController::hasEvent(const PlayerData& data) {
+    return data.player1.didJustJump || data.player2.didJustJump
+        || data.player1.spiderTeleportData.has_value() || data.player2.spiderTeleportData.has_value();
+}
+
+static bool differsIcon(const SpecificIconData& a, const SpecificIconData& b) {
+    if (std::abs(a.position.x - b.position.x) > SendRateController::POSITION_TOLERANCE) return true;
+    if (std::abs(a.position.y - b.position.y) > SendRateController::POSITION_TOLERANCE) return true;
+    if (std::abs(a.rotation - b.rotation) > SendRateController::ROTATION_TOLERANCE) return true;
+
+    return a.iconType != b.iconType
+        || a.isVisible != b.isVisible
+        || a.isLookingLeft != b.isLookingLeft
+        || a.isUpsideDown != b.isUpsideDown
+        || a.isDashing != b.isDashing
+        || a.isMini != b.isMini
+        || a.isGrounded != b.isGrounded
+        || a.isStationary != b.isStationary
+        || a.isFalling != b.isFalling
+        || a.isRotating != b.isRotating
+        || a.isSideways != b.isSideways;
+}
+
+// timestamp is intentionally ignored, it changes every tick
+bool SendRateController::differs(const PlayerData& a, const PlayerData& b) {
+    if (std::abs(a.currentPercentage - b.currentPercentage) > PERCENTAGE_TOLERANCE) return true;
+
+    return differsIcon(a.player1, b.player1)
+        || differsIcon(a.player2, b.player2)
+        || a.lastDeathTimestamp != b.lastDeathTimestamp
+        || a.isDead != b.isDead
+        || a.isPaused != b.isPaused
+        || a.isPracticing != b.isPracticing
+        || a.isDualMode != b.isDualMode
+        || a.isInEditor != b.isInEditor
+        || a.isEditorBuilding != b.isEditorBuilding;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <optional>
+#include <unordered_map>
+
+#include <data/types/game.hpp>
+
+// Decides which player data ticks actually get sent to the server.
+// The server only sends us the other players' data in response to our own updates,
+// so updates are only thinned out when neither we nor anyone else on the level is doing anything.
+class SendRateController {
+public:
+    // movement smaller than this (in units / degrees) since the last sent state is not considered a change
+    static constexpr float POSITION_TOLERANCE = 0.25f;
+    static constexpr float ROTATION_TOLERANCE = 0.5f;
+    static constexpr float PERCENTAGE_TOLERANCE = 0.05f;
+
+    // how long to keep sending at full rate after the last change, in seconds
+    static constexpr float ACTIVE_HOLD = 0.5f;
+    // send intervals when idle, in seconds
+    static constexpr float IDLE_INTERVAL = 0.15f;
+    static constexpr float PAUSED_INTERVAL = 0.35f;
+    static constexpr float NO_PEERS_INTERVAL = 1.0f;
+
+    void reset(uint32_t tps);
+
+    // Called once every tick, returns whether the data should be sent this tick.
+    bool shouldSend(const PlayerData& data, bool hasPeers);
+
+    // Called with every update received about another player
+    void onPeerData(int playerId, const PlayerData& data);
+    void removePeer(int playerId);
+
+    // Amount of updates sent over the last second
+    float getEffectiveRate() const;
+
+private:
+    uint32_t tps = 30;
+    uint32_t tick = 0;
+    uint32_t lastOwnChange = 0;
+    uint32_t lastPeerChange = 0;
+    uint32_t lastSentTick = 0;
+    std::optional<PlayerData> lastSent;
+    std::unordered_map<int, PlayerData> peers;
+
+    uint32_t windowTicks = 0;
+    uint32_t windowSends = 0;
+    float effectiveRate = 0.f;
+
+    uint32_t secondsToTicks(float secs) const;
+    static bool hasEvent(const PlayerData& data);
+    static bool differs(const PlayerData& a, const PlayerData& b);
+};
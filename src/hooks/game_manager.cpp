@@ -4,6 +4,8 @@
 #include "gjbasegamelayer.hpp"
 #include "gjgamelevel.hpp"
 
+#include <managers/icon_atlas.hpp>
+#include <managers/icon_loader.hpp>
 #include <managers/settings.hpp>
 #include <util/debug.hpp>
 #include <util/ui.hpp>
@@ -122,6 +124,10 @@ CCTexture2D* HookedGameManager::getCachedIcon(int iconId, int iconType) {
     return nullptr;
 }
 
+void HookedGameManager::setCachedIcon(int iconId, int iconType, CCTexture2D* texture) {
+    m_fields->iconCache[iconType][iconId] = texture;
+}
+
 bool HookedGameManager::getAssetsPreloaded() {
     return m_fields->assetsPreloaded;
 }
@@ -145,6 +151,8 @@ void HookedGameManager::resetAssetPreloadState() {
     this->setAssetsPreloaded(false);
     this->setDeathEffectsPreloaded(false);
     util::cocos::resetPreloadState();
+    IconLoadManager::get().reset();
+    IconAtlasManager::get().reset();
 }
 
 void HookedGameManager::setLastSceneEnum(int n) {
@@ -51,6 +51,7 @@ class $modify(HookedGameManager, GameManager) {
     void resetAssetPreloadState();
 
     cocos2d::CCTexture2D* getCachedIcon(int iconId, int iconType);
+    void setCachedIcon(int iconId, int iconType, cocos2d::CCTexture2D* texture);
 
     void setLastSceneEnum(int n = -1);
 };
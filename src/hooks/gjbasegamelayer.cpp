@@ -12,6 +12,8 @@
 #include <managers/block_list.hpp>
 #include <managers/error_queues.hpp>
 #include <managers/friend_list.hpp>
+#include <managers/icon_atlas.hpp>
+#include <managers/icon_loader.hpp>
 #include <managers/profile_cache.hpp>
 #include <managers/game_server.hpp>
 #include <managers/settings.hpp>
@@ -29,6 +31,10 @@ using namespace geode::prelude;
 
 // how many units before the voice disappears
 constexpr float PROXIMITY_VOICE_LIMIT = 1200.f;
+// proximity volume changes smaller than this are not applied to the stream
+constexpr float PROXIMITY_GAIN_THRESHOLD = 0.01f;
+// players that are far away from the camera are updated once every this many frames
+constexpr uint32_t FAR_PLAYER_UPDATE_INTERVAL = 4;
 
 constexpr float VOICE_OVERLAY_PAD_X = 5.f;
 constexpr float VOICE_OVERLAY_PAD_Y = 20.f;
@@ -148,33 +154,44 @@ void GlobedGJBGL::setupDeferredAssetPreloading() {
 
     auto* gm = static_cast<HookedGameManager*>(GameManager::get());
 
-    if (util::cocos::shouldTryToPreload(false)) {
-        log::info("Preloading assets (deferred)");
-
-        auto start = util::time::now();
-        util::cocos::preloadAssets(util::cocos::AssetPreloadStage::AllWithoutDeathEffects);
-        auto took = util::time::now() - start;
+    if (IconLoadManager::get().isEnabled()) {
+        // players that were seen recently will likely show up again
+        IconLoadManager::get().requestRecentIcons();
+    }
 
-        log::info("Asset preloading took {}", util::format::formatDuration(took));
+    // a load started in a previous level may still be running
+    if (util::cocos::isLoadingAssetsAsync()) return;
 
-        gm->setAssetsPreloaded(true);
-    }
+    bool loadIcons = util::cocos::shouldTryToPreload(false);
 
     // load death effects if those were deferred too
     bool shouldLoadDeaths = settings.players.deathEffects && !settings.players.defaultDeathEffect;
+    bool loadDeaths = !util::cocos::forcedSkipPreload() && shouldLoadDeaths && !gm->getDeathEffectsPreloaded();
+
+    if (!loadIcons && !loadDeaths) {
+        util::cocos::cleanupThreadPool();
+        return;
+    }
+
+    using util::cocos::AssetPreloadStage;
+    auto stage = loadIcons ? (loadDeaths ? AssetPreloadStage::All : AssetPreloadStage::AllWithoutDeathEffects) : AssetPreloadStage::DeathEffect;
 
-    if (!util::cocos::forcedSkipPreload() && shouldLoadDeaths && !gm->getDeathEffectsPreloaded()) {
-        log::info("Preloading death effects (deferred)");
+    log::info("Preloading assets (deferred, icons: {}, death effects: {})", loadIcons, loadDeaths);
+
+    // the textures are created over multiple frames, so the game keeps running while they load
+    auto start = util::time::now();
+    util::cocos::preloadAssetsAsync(stage, [start, loadIcons, loadDeaths](util::cocos::AssetLoadProgress progress) {
+        if (!progress.finished()) return;
 
-        auto start = util::time::now();
-        util::cocos::preloadAssets(util::cocos::AssetPreloadStage::DeathEffect);
         auto took = util::time::now() - start;
+        log::info("Asset preloading took {} ({} images)", util::format::formatDuration(took), progress.total);
 
-        log::info("Death effect preloading took {}", util::format::formatDuration(took));
-        gm->setDeathEffectsPreloaded(true);
-    }
+        auto* gm = static_cast<HookedGameManager*>(GameManager::get());
+        if (loadIcons) gm->setAssetsPreloaded(true);
+        if (loadDeaths) gm->setDeathEffectsPreloaded(true);
 
-    util::cocos::cleanupThreadPool();
+        util::cocos::cleanupThreadPool();
+    });
 }
 
 void GlobedGJBGL::setupAudio() {
@@ -232,22 +249,31 @@ void GlobedGJBGL::setupPacketListeners() {
 
     nm.addListener<PlayerProfilesPacket>(this, [](std::shared_ptr<PlayerProfilesPacket> packet) {
         auto& pcm = ProfileCacheManager::get();
+        auto& ilm = IconLoadManager::get();
+        bool lazyIcons = ilm.isEnabled();
+
         for (auto& player : packet->players) {
             pcm.insert(player);
+
+            if (lazyIcons) {
+                ilm.requestIcons(player.icons);
+            }
         }
     });
 
     nm.addListener<LevelDataPacket>(this, [this](std::shared_ptr<LevelDataPacket> packet){
-        this->m_fields->lastServerUpdate = this->m_fields->timeCounter;
-
-        for (const auto& player : packet->players) {
-            if (!this->m_fields->players.contains(player.accountId)) {
-                // new player joined
-                this->handlePlayerJoin(player.accountId);
-            }
+        this->handleLevelData(packet->players);
+    });
 
-            this->m_fields->interpolator->updatePlayer(player.accountId, player.data, this->m_fields->lastServerUpdate);
+    nm.addListener<AckedLevelDataPacket>(this, [this](std::shared_ptr<AckedLevelDataPacket> packet){
+        if (packet->keyframeRequested) {
+            this->m_fields->playerDataStream.requestKeyframe();
+        } else {
+            this->m_fields->playerDataStream.acknowledge(packet->ack);
         }
+
+        // the quantized fields are already expanded into regular player data when decoding
+        this->handleLevelData(packet->data.players);
     });
 
     nm.addListener<LevelPlayerMetadataPacket>(this, [this](std::shared_ptr<LevelPlayerMetadataPacket> packet) {
@@ -274,13 +300,8 @@ void GlobedGJBGL::setupPacketListeners() {
         try {
             vpm.prepareStream(packet->sender);
 
-            vpm.setVolume(packet->sender, settings.communication.voiceVolume);
             this->updateProximityVolume(packet->sender);
-            auto result = vpm.playFrameStreamed(packet->sender, packet->frame);
-
-            if (result.isErr()) {
-                ErrorQueues::get().debugWarn(std::string("Failed to play a voice frame: ") + result.unwrapErr());
-            }
+            vpm.playFrameStreamed(packet->sender, packet->frame);
         } catch(const std::exception& e) {
             ErrorQueues::get().debugWarn(std::string("Failed to play a voice frame: ") + e.what());
         }
@@ -372,6 +393,8 @@ void GlobedGJBGL::setupMisc() {
         m_fields->configuredTps = nm.getServerTps();
     }
 
+    m_fields->sendRate.reset(m_fields->configuredTps);
+
     // interpolator
     m_fields->interpolator = std::make_unique<PlayerInterpolator>(InterpolatorSettings {
         .realtime = false,
@@ -491,13 +514,19 @@ void GlobedGJBGL::selSendPlayerData(float) {
     // if (!self->isCurrentPlayLayer()) return;
     if (!self->accountForSpeedhack(0, 1.0f / self->m_fields->configuredTps, 0.8f)) return;
 
-    self->m_fields->totalSentPackets++;
-    // additionally, if there are no players on the level, we drop down to 1 time per second as an optimization
-    // or if we are quitting the level
-    if ((self->m_fields->players.empty() && self->m_fields->totalSentPackets % 30 != 15) || self->m_fields->quitting) return;
+    if (self->m_fields->quitting) return;
 
     auto data = self->gatherPlayerData();
-    NetworkManager::get().send(PlayerDataPacket::create(data));
+
+    // if nothing is happening on the level, or there are no players, updates are sent less often
+    if (!self->m_fields->sendRate.shouldSend(data, !self->m_fields->players.empty())) return;
+
+    auto& nm = NetworkManager::get();
+    if (nm.supportsDeltaPlayerData()) {
+        nm.send(self->m_fields->playerDataStream.makePacket(data));
+    } else {
+        nm.send(PlayerDataPacket::create(data));
+    }
 }
 
 // selSendPlayerMetadata - runs every 10 seconds
@@ -520,6 +549,7 @@ void GlobedGJBGL::selPeriodicalUpdate(float) {
     // if (!self->isCurrentPlayLayer()) return;
 
     // update the overlay
+    self->m_fields->overlay->updateSendRate(self->m_fields->sendRate.getEffectiveRate());
     self->m_fields->overlay->updatePing(GameServerManager::get().getActivePing());
 
     auto& pcm = ProfileCacheManager::get();
@@ -618,6 +648,31 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
 
     self->m_fields->interpolator->tick(dt);
 
+    if (IconLoadManager::get().update() > 0) {
+        for (const auto& [_, remotePlayer] : self->m_fields->players) {
+            remotePlayer->player1->onIconsLoaded();
+            remotePlayer->player2->onIconsLoaded();
+        }
+    }
+
+    auto& iam = IconAtlasManager::get();
+    if (iam.shouldSync(dt)) {
+        // when disabled, syncing with no icons takes apart whatever was packed before
+        std::vector<PlayerIconData> icons;
+        if (iam.isEnabled()) {
+            for (const auto& [_, remotePlayer] : self->m_fields->players) {
+                icons.push_back(remotePlayer->getAccountData().icons);
+            }
+        }
+
+        if (iam.sync(icons)) {
+            for (const auto& [_, remotePlayer] : self->m_fields->players) {
+                remotePlayer->player1->refreshIconFrames();
+                remotePlayer->player2->refreshIconFrames();
+            }
+        }
+    }
+
     if (auto pl = PlayLayer::get()) {
         if (self->m_fields->progressBarWrapper->getParent() != nullptr) {
             self->m_fields->selfProgressIcon->updatePosition(pl->getCurrentPercent() / 100.f, self->m_isPracticeMode);
@@ -634,18 +689,52 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
     auto& vpm = VoicePlaybackManager::get();
     auto& settings = GlobedSettings::get();
 
+    // in the editor everyone is always rendered, and in two player mode the linked player must never be culled
+    bool canCull = !self->m_fields->twopstate.active && !typeinfo_cast<LevelEditorLayer*>(self);
+    uint32_t frame = self->m_fields->frameCounter++;
+    bool collision = self->m_fields->roomSettings.flags.collision;
+
     for (const auto [playerId, remotePlayer] : self->m_fields->players) {
+        // far away players are only refreshed every few frames, spread out so they don't all land on the same frame
+        if (remotePlayer->getCullLevel() == CullLevel::Far && (frame + static_cast<uint32_t>(playerId)) % FAR_PLAYER_UPDATE_INTERVAL != 0) {
+            continue;
+        }
+
         const auto& vstate = self->m_fields->interpolator->getPlayerState(playerId);
 
         auto frameFlags = self->m_fields->interpolator->swapFrameFlags(playerId);
 
-        bool isSpeaking = vpm.isSpeaking(playerId);
-        remotePlayer->updateData(
-            vstate,
-            frameFlags,
-            isSpeaking,
-            isSpeaking ? vpm.getLoudness(playerId) : 0.f
-        );
+        CullLevel cullLevel = CullLevel::Visible;
+        if (canCull) {
+            auto& camState = self->m_fields->camState;
+            cullLevel = camState.cullLevel(vstate.player1.position);
+            if (vstate.isDualMode) {
+                cullLevel = std::min(cullLevel, camState.cullLevel(vstate.player2.position));
+            }
+        }
+
+        // far away players are hidden and can't be reached this frame, so they are left out of collision checks
+        if (collision) {
+            if (cullLevel == CullLevel::Far) {
+                self->m_fields->collisionGrid.remove(playerId);
+            } else {
+                self->m_fields->collisionGrid.update(playerId, false, vstate.player1.position);
+                self->m_fields->collisionGrid.update(playerId, true, vstate.player2.position);
+            }
+        }
+
+        if (cullLevel == CullLevel::Far) {
+            remotePlayer->updateCulled(vstate);
+        } else {
+            bool isSpeaking = vpm.isSpeaking(playerId);
+            remotePlayer->updateData(
+                vstate,
+                frameFlags,
+                isSpeaking,
+                isSpeaking ? vpm.getLoudness(playerId) : 0.f,
+                cullLevel
+            );
+        }
 
         // update progress icons
         if (auto self = PlayLayer::get()) {
@@ -654,11 +743,10 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
                 remotePlayer->updateProgressIcon();
             }
         }
-
-        // update voice proximity
-        self->updateProximityVolume(playerId);
     }
 
+    self->updateProximityVolumes();
+
     if (self->m_fields->selfStatusIcons) {
         self->m_fields->selfStatusIcons->setPosition(self->m_player1->getPosition() + CCPoint{0.f, 25.f});
         bool recording = VoiceRecordingManager::get().isRecording();
@@ -694,8 +782,11 @@ void GlobedGJBGL::selUpdate(float timescaledDt) {
 void GlobedGJBGL::selUpdateEstimators(float dt) {
     auto* self = GlobedGJBGL::get();
 
-    // update volume estimators
-    VoicePlaybackManager::get().updateAllEstimators(dt);
+    auto& vpm = VoicePlaybackManager::get();
+
+    // play buffered voice frames that are due and update volume estimators
+    vpm.pumpAllStreams();
+    vpm.updateAllEstimators(dt);
 
     if (self->m_fields->voiceOverlay) {
         self->m_fields->voiceOverlay->updateOverlay();
@@ -881,29 +972,117 @@ bool GlobedGJBGL::shouldLetMessageThrough(int playerId) {
     return true;
 }
 
-void GlobedGJBGL::updateProximityVolume(int playerId) {
-    if (m_fields->deafened || !m_fields->isVoiceProximity) return;
+static float proximityVolume(CCPoint self, CCPoint other) {
+    float distance = cocos2d::ccpDistance(self, other);
+    return 1.f - std::clamp(distance, 0.01f, PROXIMITY_VOICE_LIMIT) / PROXIMITY_VOICE_LIMIT;
+}
+
+// `gain[i]` = proximity volume of a player at (`x[i]`, `y[i]`) multiplied by `gain[i]`.
+// kept as a plain loop over packed arrays, so that the compiler can vectorize it
+static void proximityVolumes(CCPoint self, const float* x, const float* y, float* gain, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float dx = x[i] - self.x;
+        float dy = y[i] - self.y;
+        float distance = std::sqrt(dx * dx + dy * dy);
 
+        gain[i] *= 1.f - std::clamp(distance, 0.01f, PROXIMITY_VOICE_LIMIT) / PROXIMITY_VOICE_LIMIT;
+    }
+}
+
+static bool shouldApplyGain(float current, float target) {
+    // always apply when going silent or coming back from silence, so nobody gets stuck slightly audible
+    return std::abs(target - current) > PROXIMITY_GAIN_THRESHOLD || (target == 0.f) != (current == 0.f);
+}
+
+void GlobedGJBGL::updateProximityVolume(int playerId) {
     auto& vpm = VoicePlaybackManager::get();
+    auto& settings = GlobedSettings::get();
 
-    if (!m_fields->interpolator->hasPlayer(playerId)) {
-        // if we have no knowledge on the player, set volume to 0
-        vpm.setVolume(playerId, 0.f);
+    if (!m_fields->isVoiceProximity) {
+        vpm.setVolume(playerId, settings.communication.voiceVolume);
         return;
     }
 
-    auto& vstate = m_fields->interpolator->getPlayerState(playerId);
+    if (m_fields->deafened) return;
 
-    float distance = cocos2d::ccpDistance(m_player1->getPosition(), vstate.player1.position);
-    float volume = 1.f - std::clamp(distance, 0.01f, PROXIMITY_VOICE_LIMIT) / PROXIMITY_VOICE_LIMIT;
-    if (vstate.isInEditor) {
-        volume = 1.f;
+    float volume;
+    if (!m_fields->interpolator->hasPlayer(playerId)) {
+        // if we have no knowledge on the player, set volume to 0
+        volume = 0.f;
+    } else {
+        auto& vstate = m_fields->interpolator->getPlayerState(playerId);
+        volume = vstate.isInEditor ? 1.f : proximityVolume(m_player1->getPosition(), vstate.player1.position);
+        volume *= settings.communication.voiceVolume;
     }
 
+    if (shouldApplyGain(vpm.getVolume(playerId), volume)) {
+        vpm.setVolume(playerId, volume);
+    }
+}
+
+void GlobedGJBGL::updateProximityVolumes() {
+#ifdef GLOBED_VOICE_SUPPORT
+    if (m_fields->deafened || !m_fields->isVoiceProximity) return;
+
+    auto& vpm = VoicePlaybackManager::get();
     auto& settings = GlobedSettings::get();
+    auto& batch = m_fields->proximity;
+
+    batch.streams.clear();
+    batch.x.clear();
+    batch.y.clear();
+    batch.gain.clear();
+
+    // silent streams are left alone, their volume is set again when their next voice frame arrives
+    float voiceVolume = settings.communication.voiceVolume;
+    CCPoint selfPos = m_player1->getPosition();
+
+    vpm.forEachStream([&](int playerId, AudioStream& stream) {
+        if (stream.starving) return;
+        if (!this->shouldLetMessageThrough(playerId)) return;
+
+        CCPoint pos;
+        float gain = voiceVolume;
+
+        if (!m_fields->interpolator->hasPlayer(playerId)) {
+            // if we have no knowledge on the player, set volume to 0
+            pos = selfPos;
+            gain = 0.f;
+        } else {
+            auto& vstate = m_fields->interpolator->getPlayerState(playerId);
+            // in the editor everyone can be heard at full volume
+            pos = vstate.isInEditor ? selfPos : vstate.player1.position;
+        }
+
+        batch.streams.push_back(&stream);
+        batch.x.push_back(pos.x);
+        batch.y.push_back(pos.y);
+        batch.gain.push_back(gain);
+    });
+
+    proximityVolumes(selfPos, batch.x.data(), batch.y.data(), batch.gain.data(), batch.gain.size());
 
-    if (this->shouldLetMessageThrough(playerId)) {
-        vpm.setVolume(playerId, volume * settings.communication.voiceVolume);
+    for (size_t i = 0; i < batch.streams.size(); i++) {
+        auto* stream = batch.streams[i];
+
+        if (shouldApplyGain(stream->getVolume(), batch.gain[i])) {
+            stream->setVolume(batch.gain[i]);
+        }
+    }
+#endif // GLOBED_VOICE_SUPPORT
+}
+
+void GlobedGJBGL::handleLevelData(const std::vector<AssociatedPlayerData>& players) {
+    m_fields->lastServerUpdate = m_fields->timeCounter;
+
+    for (const auto& player : players) {
+        if (!m_fields->players.contains(player.accountId)) {
+            // new player joined
+            this->handlePlayerJoin(player.accountId);
+        }
+
+        m_fields->interpolator->updatePlayer(player.accountId, player.data, m_fields->lastServerUpdate);
+        m_fields->sendRate.onPeerData(player.accountId, player.data);
     }
 }
 
@@ -975,6 +1154,8 @@ void GlobedGJBGL::handlePlayerLeave(int playerId) {
     m_fields->players.erase(playerId);
     m_fields->interpolator->removePlayer(playerId);
     m_fields->playerStore->removePlayer(playerId);
+    m_fields->sendRate.removePeer(playerId);
+    m_fields->collisionGrid.remove(playerId);
 
     // log::debug("Player removed: {}", playerId);
 }
@@ -1028,6 +1209,9 @@ void GlobedGJBGL::onQuitActions() {
 
     m_fields->quitting = true;
 
+    // give the icons their own textures back and free the atlas
+    IconAtlasManager::get().clear();
+
     if (m_fields->globedReady) {
         if (nm.established()) {
             // send LevelLeavePacket
@@ -1143,73 +1327,53 @@ int GlobedGJBGL::checkCollisions(PlayerObject* player, float dt, bool p2) {
 
     bool isSecond = player == gpl->m_player2;
 
-    for (const auto& [_, rp] : gpl->m_fields->players) {
-        auto* p1 = static_cast<PlayerObject*>(rp->player1->getPlayerObject());
-        auto* p2 = static_cast<PlayerObject*>(rp->player2->getPlayerObject());
-
-        auto& p1Rect = p1->getObjectRect();
-        auto& p2Rect = p2->getObjectRect();
-
-        auto& playerRect = player->getObjectRect();
+    auto setSticky = [&](ComplexVisualPlayer* vp, bool state) {
+        isSecond ? vp->setP2StickyState(state) : vp->setP1StickyState(state);
+    };
 
-        CCRect p1CollRect = p1Rect;
-        CCRect p2CollRect = p2Rect;
+    // only players that are actually touched get marked sticky, so only those have to be reset
+    auto& stickyPlayers = gpl->m_fields->stickyPlayers[isSecond ? 1 : 0];
+    for (int playerId : stickyPlayers) {
+        auto it = gpl->m_fields->players.find(playerId);
+        if (it == gpl->m_fields->players.end()) continue;
 
-        constexpr float padding = 2.f;
+        setSticky(it->second->player1, false);
+        setSticky(it->second->player2, false);
+    }
+    stickyPlayers.clear();
 
-        // p1CollRect.origin += CCPoint{padding, padding};
-        // p1CollRect.size -= CCSize{padding * 2, padding * 2};
+    CCRect queryRect = player->getObjectRect();
 
-        // p2CollRect.origin += CCPoint{padding, padding};
-        // p2CollRect.size -= CCSize{padding * 2, padding * 2};
+    gpl->m_fields->collisionGrid.query(queryRect, [&](int playerId, bool second) {
+        auto it = gpl->m_fields->players.find(playerId);
+        if (it == gpl->m_fields->players.end()) return;
 
-        bool intersectsP1 = playerRect.intersectsRect(p1CollRect);
-        bool intersectsP2 = playerRect.intersectsRect(p2CollRect);
+        auto* vp = second ? it->second->player2 : it->second->player1;
+        auto* obj = static_cast<PlayerObject*>(vp->getPlayerObject());
 
-        if (isSecond) {
-            rp->player1->setP2StickyState(false);
-            rp->player2->setP2StickyState(false);
-        } else {
-            rp->player1->setP1StickyState(false);
-            rp->player2->setP1StickyState(false);
-        }
+        auto& objRect = obj->getObjectRect();
+        auto& playerRect = player->getObjectRect();
+        CCRect collRect = objRect;
 
-        if (intersectsP1) {
-            auto prev = player->getPosition();
-            player->collidedWithObject(dt, p1, p1CollRect, false);
-            auto displacement = player->getPosition() - prev;
+        if (!playerRect.intersectsRect(collRect)) return;
 
-            // log::debug("p1 intersect, displacement: {}", displacement);
+        auto prev = player->getPosition();
+        player->collidedWithObject(dt, obj, collRect, false);
+        auto displacement = player->getPosition() - prev;
 
-            bool shouldRevert = shouldCorrectCollision(playerRect, p1Rect, displacement);
+        // log::debug("{} intersect, displacement: {}", second ? "p2" : "p1", displacement);
 
-            if (shouldRevert) {
-                player->setPosition(player->getPosition() + displacement);
-            }
+        bool shouldRevert = shouldCorrectCollision(playerRect, objRect, displacement);
 
-            if (std::abs(displacement.y) > 0.001f) {
-                isSecond ? rp->player1->setP2StickyState(true) : rp->player1->setP1StickyState(true);
-            }
+        if (shouldRevert) {
+            player->setPosition(player->getPosition() + displacement);
         }
 
-        if (intersectsP2) {
-            auto prev = player->getPosition();
-            player->collidedWithObject(dt, p2, p2CollRect, false);
-            auto displacement = player->getPosition() - prev;
-
-            // log::debug("p2 intersect, displacement: {}", displacement);
-
-            bool shouldRevert = shouldCorrectCollision(playerRect, p2Rect, displacement);
-
-            if (shouldRevert) {
-                player->setPosition(player->getPosition() + displacement);
-            }
-
-            if (std::abs(displacement.y) > 0.001f) {
-                isSecond ? rp->player2->setP2StickyState(true) : rp->player2->setP1StickyState(true);
-            }
+        if (std::abs(displacement.y) > 0.001f) {
+            setSticky(vp, true);
+            stickyPlayers.push_back(playerId);
         }
-    }
+    });
 
     return retval;
 }
@@ -4,9 +4,13 @@
 #include <Geode/modify/GJBaseGameLayer.hpp>
 #include "Geode/loader/Dispatch.hpp"
 
+#include <audio/stream.hpp>
 #include <data/types/room.hpp>
+#include <game/collision_grid.hpp>
 #include <game/interpolator.hpp>
+#include <game/player_data_stream.hpp>
 #include <game/player_store.hpp>
+#include <game/send_rate.hpp>
 #include <net/manager.hpp>
 #include <ui/game/player/remote_player.hpp>
 #include <ui/game/overlay/overlay.hpp>
@@ -27,11 +31,18 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
         // in game stuff
         bool deafened = false;
         bool isVoiceProximity = false;
-        uint32_t totalSentPackets = 0;
+        // scratch buffers for `updateProximityVolumes`, kept to avoid allocating every frame
+        struct ProximityBatch {
+            std::vector<AudioStream*> streams;
+            std::vector<float> x, y, gain;
+        } proximity;
         float timeCounter = 0.f;
+        uint32_t frameCounter = 0;
         float lastServerUpdate = 0.f;
         std::unique_ptr<PlayerInterpolator> interpolator;
         std::unique_ptr<PlayerStore> playerStore;
+        PlayerDataStream playerDataStream;
+        SendRateController sendRate;
         RoomSettings roomSettings;
         struct TwoPlayerModeState {
             bool active = false; // true when two player mode is enabled and linked to a player
@@ -43,6 +54,9 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
         bool shouldStopProgress = false;
         bool quitting = false;
         GameCameraState camState;
+        PlayerCollisionGrid collisionGrid;
+        // remote players that were marked sticky by the last collision check of our player 1 and 2
+        std::array<std::vector<int>, 2> stickyPlayers;
 
         std::optional<SpiderTeleportData> spiderTp1, spiderTp2;
         bool didJustJumpp1 = false, didJustJumpp2 = false;
@@ -130,8 +144,12 @@ class $modify(GlobedGJBGL, GJBaseGameLayer) {
     PlayerMetadata gatherPlayerMetadata();
 
     bool shouldLetMessageThrough(int playerId);
+    // Sets the volume of a single player's voice stream, based on how far away they are if proximity is enabled
     void updateProximityVolume(int playerId);
+    // Updates the proximity volume of everyone that is currently speaking
+    void updateProximityVolumes();
 
+    void handleLevelData(const std::vector<AssociatedPlayerData>& players);
     void handlePlayerJoin(int playerId);
     void handlePlayerLeave(int playerId);
 
@@ -0,0 +1,374 @@
+#include "icon_atlas.hpp"
+
+#include <hooks/game_manager.hpp>
+#include <managers/settings.hpp>
+#include <util/misc.hpp>
+
+#include <cmath>
+
+using namespace geode::prelude;
+
+// the sprite frame dictionary is needed to find all frames of a sheet
+#include <Geode/modify/CCSpriteFrameCache.hpp>
+class $modify(AtlasSpriteFrameCache, CCSpriteFrameCache) {
+    CCDictionary* getSpriteFrames() {
+        return m_pSpriteFrames;
+    }
+};
+
+// render textures are created as not premultiplied, but the sheets drawn into them are
+#include <Geode/modify/CCTexture2D.hpp>
+class $modify(AtlasTexture2D, CCTexture2D) {
+    void setHasPremultipliedAlpha(bool state) {
+        m_bHasPremultipliedAlpha = state;
+    }
+};
+
+static AtlasSpriteFrameCache* frameCache() {
+    return static_cast<AtlasSpriteFrameCache*>(CCSpriteFrameCache::sharedSpriteFrameCache());
+}
+
+bool IconAtlasManager::isEnabled() {
+    return GlobedSettings::get().players.iconAtlas;
+}
+
+bool IconAtlasManager::shouldSync(float dt) {
+    syncTimer += dt;
+    if (syncTimer < SYNC_INTERVAL) return false;
+
+    syncTimer = 0.f;
+    return true;
+}
+
+bool IconAtlasManager::sync(const std::vector<PlayerIconData>& icons) {
+    auto* gm = static_cast<HookedGameManager*>(GameManager::get());
+
+    std::unordered_set<SheetKey> wanted;
+    for (const auto& icon : icons) {
+        for (auto type = PlayerIconType::Cube; type <= PlayerIconType::Jetpack; type = (PlayerIconType)((int)type + 1)) {
+            wanted.insert(makeKey(util::misc::convertEnum<IconType>(type), util::misc::getIconWithType(icon, type)));
+        }
+    }
+
+    bool changed = false;
+
+    // put back the frames of sheets that nobody uses anymore
+    for (auto it = sheets.begin(); it != sheets.end();) {
+        if (wanted.contains(it->first)) {
+            ++it;
+            continue;
+        }
+
+        auto& sheet = it->second;
+        this->restoreFrames(sheet);
+
+        if (sheet.page) {
+            sheet.page->unusedArea += sheet.area;
+            sheet.page->sheetCount--;
+        }
+
+        it = sheets.erase(it);
+    }
+
+    // drop the pages that are mostly wasted, the sheets still in them get packed again below
+    std::erase_if(pages, [&](const std::unique_ptr<Page>& page) {
+        if (page->sheetCount != 0 && page->unusedArea <= page->usedArea * REBUILD_WASTE) {
+            return false;
+        }
+
+        for (auto& [_, sheet] : sheets) {
+            if (sheet.page == page.get()) {
+                sheet.page = nullptr;
+                sheet.area = 0;
+            }
+        }
+
+        return true;
+    });
+
+    // start tracking the newly used sheets that are loaded
+    std::vector<std::pair<SheetKey, Sheet*>> newSheets;
+
+    for (SheetKey key : wanted) {
+        if (sheets.contains(key) || unpackable.contains(key)) continue;
+
+        auto* texture = gm->getCachedIcon(key & 0xffff, key >> 16);
+        if (!texture) continue;
+
+        auto& sheet = sheets[key];
+        sheet.texture = texture;
+        newSheets.emplace_back(key, &sheet);
+    }
+
+    if (!newSheets.empty()) {
+        this->collectFrames(newSheets);
+    }
+
+    // pack everything that isn't in a page, the biggest sheets first
+    std::vector<std::pair<SheetKey, Sheet*>> pending;
+    for (auto& [key, sheet] : sheets) {
+        if (!sheet.page) pending.emplace_back(key, &sheet);
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const auto& a, const auto& b) {
+        return a.second->frames.front().height > b.second->frames.front().height;
+    });
+
+    std::unordered_map<Page*, std::vector<Sheet*>> toDraw;
+    std::unordered_set<Page*> createdPages;
+
+    for (auto& [key, sheet] : pending) {
+        bool packed = false;
+
+        for (auto& page : pages) {
+            if (this->allocate(*page, *sheet)) {
+                packed = true;
+                break;
+            }
+        }
+
+        if (!packed && pages.size() < MAX_PAGES) {
+            if (auto* page = this->createPage()) {
+                createdPages.insert(page);
+
+                if (this->allocate(*page, *sheet)) {
+                    packed = true;
+                } else {
+                    // doesn't fit even into an empty page
+                    log::warn("icon sheet too big for the atlas: type {}, id {}", key >> 16, key & 0xffff);
+                    unpackable.insert(key);
+                }
+            }
+        }
+
+        if (packed) {
+            toDraw[sheet->page].push_back(sheet);
+        }
+    }
+
+    for (auto& [page, pageSheets] : toDraw) {
+        this->draw(*page, pageSheets, createdPages.contains(page));
+
+        for (auto* sheet : pageSheets) {
+            this->replaceFrames(*sheet);
+        }
+
+        changed = true;
+    }
+
+    // sheets that didn't fit anywhere go back to their own textures
+    for (auto it = sheets.begin(); it != sheets.end();) {
+        auto& sheet = it->second;
+
+        if (sheet.page) {
+            ++it;
+            continue;
+        }
+
+        if (!sheet.frames.empty() && sheet.frames.front().packed) {
+            this->restoreFrames(sheet);
+            changed = true;
+        }
+
+        // unpackable sheets are forgotten, others are kept so their frames don't have to be found again
+        if (unpackable.contains(it->first)) {
+            it = sheets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // empty pages left over from a sheet that didn't fit
+    std::erase_if(pages, [](const std::unique_ptr<Page>& page) {
+        return page->sheetCount == 0;
+    });
+
+    return changed;
+}
+
+void IconAtlasManager::clear() {
+    for (auto& [_, sheet] : sheets) {
+        this->restoreFrames(sheet);
+    }
+
+    sheets.clear();
+    pages.clear();
+    syncTimer = 0.f;
+}
+
+void IconAtlasManager::reset() {
+    sheets.clear();
+    pages.clear();
+    unpackable.clear();
+    syncTimer = 0.f;
+}
+
+uint32_t IconAtlasManager::pageSize() {
+    return std::min<uint32_t>(PAGE_SIZE, CCConfiguration::sharedConfiguration()->getMaxTextureSize());
+}
+
+void IconAtlasManager::collectFrames(std::vector<std::pair<SheetKey, Sheet*>>& newSheets) {
+    std::unordered_map<CCTexture2D*, Sheet*> byTexture;
+    for (auto& [_, sheet] : newSheets) {
+        byTexture.emplace(sheet->texture.data(), sheet);
+    }
+
+    auto* frames = frameCache()->getSpriteFrames();
+
+    CCDictElement* element;
+    CCDICT_FOREACH(frames, element) {
+        auto* frame = static_cast<CCSpriteFrame*>(element->getObject());
+
+        auto it = byTexture.find(frame->getTexture());
+        if (it == byTexture.end()) continue;
+
+        const auto& rect = frame->getRectInPixels();
+
+        it->second->frames.push_back(PackedFrame {
+            .name = element->getStrKey(),
+            .original = frame,
+            .width = static_cast<uint32_t>(std::ceil(rect.size.width)),
+            .height = static_cast<uint32_t>(std::ceil(rect.size.height)),
+        });
+    }
+
+    for (auto& [key, sheet] : newSheets) {
+        if (sheet->frames.empty()) {
+            unpackable.insert(key);
+            sheets.erase(key);
+            continue;
+        }
+
+        // tallest first, packs better into shelves
+        std::sort(sheet->frames.begin(), sheet->frames.end(), [](const PackedFrame& a, const PackedFrame& b) {
+            return a.height > b.height;
+        });
+    }
+}
+
+bool IconAtlasManager::allocate(Page& page, Sheet& sheet) {
+    uint32_t size = pageSize();
+
+    // allocations are undone if the whole sheet doesn't fit
+    auto shelves = page.shelves;
+    uint32_t shelvesHeight = page.shelvesHeight;
+    size_t area = 0;
+
+    for (auto& frame : sheet.frames) {
+        uint32_t width = frame.width + PADDING;
+        uint32_t height = frame.height + PADDING;
+
+        bool placed = false;
+
+        for (auto& shelf : shelves) {
+            if (height <= shelf.height && shelf.used + width <= size) {
+                frame.x = shelf.used;
+                frame.y = shelf.y;
+                shelf.used += width;
+                placed = true;
+                break;
+            }
+        }
+
+        if (!placed) {
+            if (width > size || shelvesHeight + height > size) {
+                return false;
+            }
+
+            frame.x = 0;
+            frame.y = shelvesHeight;
+            shelves.push_back(Shelf { .y = shelvesHeight, .height = height, .used = width });
+            shelvesHeight += height;
+        }
+
+        area += static_cast<size_t>(width) * height;
+    }
+
+    page.shelves = std::move(shelves);
+    page.shelvesHeight = shelvesHeight;
+    page.usedArea += area;
+    page.sheetCount++;
+
+    sheet.page = &page;
+    sheet.area = area;
+
+    return true;
+}
+
+void IconAtlasManager::draw(Page& page, const std::vector<Sheet*>& pageSheets, bool clear) {
+    float scale = CC_CONTENT_SCALE_FACTOR();
+
+    if (clear) {
+        page.target->beginWithClear(0.f, 0.f, 0.f, 0.f);
+    } else {
+        page.target->begin();
+    }
+
+    for (auto* sheet : pageSheets) {
+        for (const auto& frame : sheet->frames) {
+            auto* original = frame.original.data();
+
+            auto* sprite = new CCSprite;
+            sprite->initWithTexture(original->getTexture(), original->getRect(), original->isRotated());
+            sprite->setAnchorPoint({0.f, 0.f});
+            sprite->setPosition({frame.x / scale, frame.y / scale});
+            // the first row of a render texture is at the bottom, sprite frames expect it at the top
+            sprite->setFlipY(true);
+            sprite->visit();
+            sprite->release();
+        }
+    }
+
+    page.target->end();
+}
+
+void IconAtlasManager::replaceFrames(Sheet& sheet) {
+    auto* texture = sheet.page->target->getSprite()->getTexture();
+    float scale = CC_CONTENT_SCALE_FACTOR();
+
+    for (auto& frame : sheet.frames) {
+        auto* original = frame.original.data();
+
+        CCRect rect(frame.x / scale, frame.y / scale, original->getRect().size.width, original->getRect().size.height);
+        frame.packed = CCSpriteFrame::createWithTexture(texture, rect, false, original->getOffset(), original->getOriginalSize());
+
+        frameCache()->addSpriteFrame(frame.packed, frame.name.c_str());
+    }
+}
+
+void IconAtlasManager::restoreFrames(Sheet& sheet) {
+    auto* cacheFrames = frameCache()->getSpriteFrames();
+
+    for (auto& frame : sheet.frames) {
+        if (!frame.packed) continue;
+
+        // don't overwrite the frame if something else replaced it in the meantime
+        if (cacheFrames->objectForKey(frame.name) == frame.packed.data()) {
+            frameCache()->addSpriteFrame(frame.original, frame.name.c_str());
+        }
+
+        frame.packed = nullptr;
+    }
+}
+
+IconAtlasManager::Page* IconAtlasManager::createPage() {
+    float scale = CC_CONTENT_SCALE_FACTOR();
+    float size = pageSize() / scale;
+
+    auto* target = CCRenderTexture::create(size, size, kCCTexture2DPixelFormat_RGBA8888);
+    if (!target) {
+        log::warn("failed to create an icon atlas page");
+        return nullptr;
+    }
+
+    static_cast<AtlasTexture2D*>(target->getSprite()->getTexture())->setHasPremultipliedAlpha(true);
+
+    auto& page = pages.emplace_back(std::make_unique<Page>());
+    page->target = target;
+
+    return page.get();
+}
+
+IconAtlasManager::SheetKey IconAtlasManager::makeKey(IconType type, int iconId) {
+    return (static_cast<uint32_t>(type) << 16) | static_cast<uint16_t>(iconId);
+}
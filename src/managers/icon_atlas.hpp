@@ -0,0 +1,94 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#include <data/types/gd.hpp>
+#include <util/singleton.hpp>
+
+/*
+* IconAtlasManager packs the icon sheets used by the players in a level into a few big textures (pages),
+* so that drawing many different icons doesn't need a texture switch for every player.
+*
+* The frames of a packed sheet are replaced in the sprite frame cache with frames that point into a page,
+* and the original frames are put back once the sheet is no longer used. New sheets are added into the free space
+* of existing pages, and a page is only rebuilt once most of it is taken by sheets that are no longer used.
+* Pages are never modified in places that are still in use, so sprites that still show an old frame stay correct.
+* Not thread safe.
+*/
+class IconAtlasManager : public SingletonBase<IconAtlasManager> {
+public:
+    // size of a page in pixels, smaller if the device doesn't support textures this big
+    static constexpr uint32_t PAGE_SIZE = 2048;
+    static constexpr size_t MAX_PAGES = 4;
+    // space between frames in pixels, so that linear filtering doesn't pick up the neighbours
+    static constexpr uint32_t PADDING = 2;
+    // a page is rebuilt once this much of the space used in it belongs to sheets that are no longer used
+    static constexpr float REBUILD_WASTE = 0.5f;
+    // how often the atlas is synced with the players in the level, in seconds
+    static constexpr float SYNC_INTERVAL = 1.f;
+
+    bool isEnabled();
+
+    // Advances the sync timer, returns `true` if `sync` should be called this frame
+    bool shouldSync(float dt);
+
+    // Packs the sheets of the given icons that aren't packed yet, and removes the ones that aren't used anymore.
+    // Sheets that aren't loaded yet are skipped and picked up by a later sync.
+    // Returns `true` if any sprite frames were replaced, in which case the players should update their frames.
+    bool sync(const std::vector<PlayerIconData>& icons);
+
+    // Puts back the original sprite frames and frees all pages
+    void clear();
+
+    // Forgets everything without touching the sprite frame cache, must be called when the game reloads its textures
+    void reset();
+
+private:
+    // icon type in the upper 16 bits, icon ID in the lower 16 bits
+    using SheetKey = uint32_t;
+
+    struct Page;
+
+    struct PackedFrame {
+        std::string name;
+        Ref<cocos2d::CCSpriteFrame> original;
+        // the frame that replaced the original one in the cache
+        Ref<cocos2d::CCSpriteFrame> packed;
+        uint32_t x = 0, y = 0, width = 0, height = 0;
+    };
+
+    struct Sheet {
+        Ref<cocos2d::CCTexture2D> texture;
+        std::vector<PackedFrame> frames;
+        Page* page = nullptr;
+        // area taken in the page, including padding
+        size_t area = 0;
+    };
+
+    struct Shelf {
+        uint32_t y, height, used;
+    };
+
+    struct Page {
+        Ref<cocos2d::CCRenderTexture> target;
+        std::vector<Shelf> shelves;
+        uint32_t shelvesHeight = 0;
+        size_t usedArea = 0, unusedArea = 0;
+        size_t sheetCount = 0;
+    };
+
+    std::unordered_map<SheetKey, Sheet> sheets;
+    std::vector<std::unique_ptr<Page>> pages;
+    // sheets that can't be packed (no frames found, or too big), not retried until `reset`
+    std::unordered_set<SheetKey> unpackable;
+    float syncTimer = 0.f;
+
+    uint32_t pageSize();
+    void collectFrames(std::vector<std::pair<SheetKey, Sheet*>>& newSheets);
+    bool allocate(Page& page, Sheet& sheet);
+    void draw(Page& page, const std::vector<Sheet*>& sheets, bool clear);
+    void replaceFrames(Sheet& sheet);
+    void restoreFrames(Sheet& sheet);
+    Page* createPage();
+
+    static SheetKey makeKey(IconType type, int iconId);
+};
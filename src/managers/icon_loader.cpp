@@ -0,0 +1,147 @@
+#include "icon_loader.hpp"
+
+#include <hooks/game_manager.hpp>
+#include <managers/settings.hpp>
+
+using namespace geode::prelude;
+
+bool IconLoadManager::isEnabled() {
+    return GlobedSettings::get().globed.lazyIconLoading;
+}
+
+bool IconLoadManager::requestIcons(const PlayerIconData& icons) {
+    bool ready = true;
+
+    forEachIcon(icons, [&](IconKey key) {
+        this->touchRecent(key);
+        this->request(key);
+
+        if (pending.contains(key)) ready = false;
+    });
+
+    return ready;
+}
+
+void IconLoadManager::requestRecentIcons() {
+    for (IconKey key : recent) {
+        this->request(key);
+    }
+}
+
+bool IconLoadManager::isReady(const PlayerIconData& icons) {
+    bool ready = true;
+
+    forEachIcon(icons, [&](IconKey key) {
+        if (pending.contains(key)) ready = false;
+    });
+
+    return ready;
+}
+
+size_t IconLoadManager::update() {
+    auto* gm = static_cast<HookedGameManager*>(GameManager::get());
+    size_t finished = 0;
+
+    while (finished < UPLOADS_PER_FRAME) {
+        auto result = decoded.tryPop();
+        if (!result) break;
+
+        auto& icon = result.value();
+
+        if (icon.generation != generation) {
+            if (icon.asset) {
+                util::cocos::freeAsset(icon.asset.value());
+            }
+
+            continue;
+        }
+
+        pending.erase(icon.key);
+        finished++;
+
+        CCTexture2D* texture = icon.asset ? util::cocos::uploadAsset(icon.asset.value()) : nullptr;
+
+        if (!texture) {
+            log::warn("failed to load icon: type {}, id {}", (int)keyType(icon.key), keyId(icon.key));
+            failed.insert(icon.key);
+            continue;
+        }
+
+        gm->setCachedIcon(keyId(icon.key), (int)keyType(icon.key), texture);
+    }
+
+    return finished;
+}
+
+void IconLoadManager::reset() {
+    generation++;
+    pending.clear();
+    failed.clear();
+}
+
+void IconLoadManager::request(IconKey key) {
+    if (pending.contains(key) || failed.contains(key)) return;
+
+    auto* gm = static_cast<HookedGameManager*>(GameManager::get());
+
+    int iconId = keyId(key);
+    int iconType = (int)keyType(key);
+
+    if (gm->getCachedIcon(iconId, iconType)) return;
+
+    std::string sheetName = gm->sheetNameForIcon(iconId, iconType);
+    if (sheetName.empty()) return;
+
+    // resolving paths is not thread safe, so it's done here rather than on the pool
+    auto path = util::cocos::fullPathForFilename(fmt::format("{}.png", sheetName));
+    auto plistPath = util::cocos::fullPathForFilename(fmt::format("{}.plist", sheetName));
+
+    if (path.empty() || plistPath.empty()) {
+        failed.insert(key);
+        return;
+    }
+
+    // decoding is cheap compared to reading and uploading, so a few threads are enough
+    if (!pool) {
+        size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+        pool = std::make_unique<asp::thread::ThreadPool>(threads);
+    }
+
+    pending.insert(key);
+
+    pool->pushTask([this, key, generation = generation, sheetName = std::move(sheetName), path = std::move(path), plistPath = std::move(plistPath)] {
+        decoded.push(DecodedIcon {
+            .key = key,
+            .generation = generation,
+            .asset = util::cocos::decodeAsset(sheetName, path, plistPath),
+        });
+    });
+}
+
+void IconLoadManager::touchRecent(IconKey key) {
+    auto it = recentLookup.find(key);
+    if (it != recentLookup.end()) {
+        recent.splice(recent.begin(), recent, it->second);
+        return;
+    }
+
+    recent.push_front(key);
+    recentLookup.emplace(key, recent.begin());
+
+    if (recent.size() > RECENT_ICON_LIMIT) {
+        recentLookup.erase(recent.back());
+        recent.pop_back();
+    }
+}
+
+IconLoadManager::IconKey IconLoadManager::makeKey(IconType type, int iconId) {
+    return (static_cast<uint32_t>(type) << 16) | static_cast<uint16_t>(iconId);
+}
+
+IconType IconLoadManager::keyType(IconKey key) {
+    return static_cast<IconType>(key >> 16);
+}
+
+int IconLoadManager::keyId(IconKey key) {
+    return static_cast<int>(key & 0xffff);
+}
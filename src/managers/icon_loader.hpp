@@ -0,0 +1,84 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#include <asp/sync.hpp>
+#include <asp/thread.hpp>
+
+#include <list>
+
+#include <data/types/gd.hpp>
+#include <util/cocos.hpp>
+#include <util/singleton.hpp>
+
+/*
+* IconLoadManager loads icon sheets on demand, as an alternative to preloading every icon in the game.
+*
+* Icons are requested once we know which ones the players on the level use. The sheets are read and decoded on a small
+* thread pool, and the decoded ones are turned into textures a few per frame in `update`, so no single frame takes a big hit.
+* The icons of recently seen players are remembered and requested again when joining a level, as they are likely to be needed again.
+* Not thread safe.
+*/
+class IconLoadManager : public SingletonBase<IconLoadManager> {
+public:
+    // how many decoded sheets are turned into textures each frame
+    static constexpr size_t UPLOADS_PER_FRAME = 4;
+    // how many recently seen icons are remembered
+    static constexpr size_t RECENT_ICON_LIMIT = 96;
+
+    bool isEnabled();
+
+    // Requests all icons of the player. Returns `true` if none of them are still loading.
+    bool requestIcons(const PlayerIconData& icons);
+    // Requests the icons of recently seen players
+    void requestRecentIcons();
+    // Returns `true` if none of the icons of the player are still loading
+    bool isReady(const PlayerIconData& icons);
+
+    // Creates textures from decoded sheets, must be called every frame on the main thread.
+    // Returns the amount of icons that finished loading (successfully or not).
+    size_t update();
+
+    // Forgets all pending requests, must be called when the game reloads its textures
+    void reset();
+
+private:
+    // icon type in the upper 16 bits, icon ID in the lower 16 bits
+    using IconKey = uint32_t;
+
+    struct DecodedIcon {
+        IconKey key;
+        uint32_t generation;
+        std::optional<util::cocos::DecodedAsset> asset;
+    };
+
+    std::unique_ptr<asp::thread::ThreadPool> pool;
+    asp::Channel<DecodedIcon> decoded;
+    // incremented on reset, results of requests made before that are thrown away
+    uint32_t generation = 0;
+
+    std::unordered_set<IconKey> pending, failed;
+
+    // most recently seen icon first
+    std::list<IconKey> recent;
+    std::unordered_map<IconKey, std::list<IconKey>::iterator> recentLookup;
+
+    void request(IconKey key);
+    void touchRecent(IconKey key);
+
+    static IconKey makeKey(IconType type, int iconId);
+    static IconType keyType(IconKey key);
+    static int keyId(IconKey key);
+
+    template <typename F>
+    static void forEachIcon(const PlayerIconData& icons, F&& func) {
+        func(makeKey(IconType::Cube, icons.cube));
+        func(makeKey(IconType::Ship, icons.ship));
+        func(makeKey(IconType::Ball, icons.ball));
+        func(makeKey(IconType::Ufo, icons.ufo));
+        func(makeKey(IconType::Wave, icons.wave));
+        func(makeKey(IconType::Robot, icons.robot));
+        func(makeKey(IconType::Spider, icons.spider));
+        func(makeKey(IconType::Swing, icons.swing));
+        func(makeKey(IconType::Jetpack, icons.jetpack));
+    }
+};
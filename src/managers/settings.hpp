@@ -143,6 +143,8 @@ public:
         LimitedSetting<int, 0, 0, 240> tpsCap;
         Setting<bool, true> preloadAssets;
         Setting<bool, false> deferPreloadAssets;
+        Setting<bool, false> lazyIconLoading;
+        Setting<bool, false> textureDiskCache;
         LimitedSetting<int, (int)InvitesFrom::Everyone, 0, 2> invitesFrom;
         Setting<bool, false> increaseLevelList;
         Setting<int, 60000> fragmentationLimit;
@@ -156,6 +158,7 @@ public:
         LimitedSetting<float, 0.3f, 0.f, 1.f> opacity;
         Setting<bool, true> hideConditionally;
         LimitedSetting<int, 3, 0, 3> position; // 0-3 topleft, topright, bottomleft, bottomright
+        Setting<bool, false> sendLatency;
     };
 
     struct Communication {
@@ -168,6 +171,8 @@ public:
         Setting<int, 0> audioDevice;
         Setting<bool, true> deafenNotification;
         Setting<bool, false> voiceLoopback; // TODO unimpl
+        Setting<bool, false> sharedVoiceMixer;
+        LimitedSetting<int, 8, 1, 32> mixedSpeakerLimit;
     };
 
     struct LevelUI {
@@ -175,6 +180,7 @@ public:
         Setting<bool, true> progressPointers; // unused
         LimitedSetting<float, 1.0f, 0.f, 1.f> progressOpacity;
         Setting<bool, true> voiceOverlay;
+        Setting<bool, false> voiceOverlayStats;
     };
 
     struct Players {
@@ -189,6 +195,7 @@ public:
         Setting<bool, false> forceVisibility;
         Setting<bool, false> ownName;
         Setting<bool, false> hidePracticePlayers;
+        Setting<bool, false> iconAtlas;
     };
 
     struct Advanced {};
@@ -265,23 +272,24 @@ public:
 /* Enable reflection */
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Globed, (
-    autoconnect, tpsCap, preloadAssets, deferPreloadAssets, increaseLevelList, fragmentationLimit, compressedPlayerCount, useDiscordRPC, isInvisible
+    autoconnect, tpsCap, preloadAssets, deferPreloadAssets, lazyIconLoading, textureDiskCache, increaseLevelList, fragmentationLimit, compressedPlayerCount, useDiscordRPC, isInvisible
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Overlay, (
-    enabled, opacity, hideConditionally, position
+    enabled, opacity, hideConditionally, position, sendLatency
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Communication, (
-    voiceEnabled, voiceProximity, classicProximity, voiceVolume, onlyFriends, lowerAudioLatency, deafenNotification, voiceLoopback
+    voiceEnabled, voiceProximity, classicProximity, voiceVolume, onlyFriends, lowerAudioLatency, deafenNotification, voiceLoopback,
+    sharedVoiceMixer, mixedSpeakerLimit
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::LevelUI, (
-    progressIndicators, progressPointers, progressOpacity, voiceOverlay
+    progressIndicators, progressPointers, progressOpacity, voiceOverlay, voiceOverlayStats
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Players, (
-    playerOpacity, showNames, dualName, nameOpacity, statusIcons, deathEffects, defaultDeathEffect, hideNearby, forceVisibility, ownName, hidePracticePlayers
+    playerOpacity, showNames, dualName, nameOpacity, statusIcons, deathEffects, defaultDeathEffect, hideNearby, forceVisibility, ownName, hidePracticePlayers, iconAtlas
 ));
 
 GLOBED_SERIALIZABLE_STRUCT(GlobedSettings::Advanced, ());
@@ -0,0 +1,32 @@
+#include "dispatch_table.hpp"
+
+PacketDispatchTable::PacketDispatchTable() {
+    auto st = storage.lock();
+    this->publish(*st, std::make_unique<Table>());
+}
+
+bool PacketDispatchTable::set(packetid_t id, Handler&& handler) {
+    auto index = server_packets::indexOf(id);
+    if (index == server_packets::INVALID_INDEX) return false;
+
+    auto st = storage.lock();
+
+    auto* newHandler = st->handlers.emplace_back(std::make_unique<Handler>(std::move(handler))).get();
+
+    auto table = std::make_unique<Table>(*current.load(std::memory_order::relaxed));
+    table->handlers[index] = newHandler;
+
+    this->publish(*st, std::move(table));
+
+    return true;
+}
+
+void PacketDispatchTable::clear() {
+    auto st = storage.lock();
+    this->publish(*st, std::make_unique<Table>());
+}
+
+void PacketDispatchTable::publish(Storage& st, std::unique_ptr<Table> table) {
+    current.store(table.get(), std::memory_order::release);
+    st.tables.push_back(std::move(table));
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <data/packets/all.hpp>
+#include <asp/sync.hpp>
+
+#include <array>
+
+// Dense indices for all server packets, generated at compile time from GLOBED_FOR_EACH_SERVER_PACKET.
+namespace server_packets {
+#define GLOBED_PACKET_ID(pt) pt::PACKET_ID,
+    inline constexpr packetid_t IDS[] = { GLOBED_FOR_EACH_SERVER_PACKET(GLOBED_PACKET_ID) };
+#undef GLOBED_PACKET_ID
+
+    inline constexpr size_t COUNT = std::size(IDS);
+
+    // all server packet IDs are 2xxxx
+    inline constexpr packetid_t FIRST_ID = 20000;
+    inline constexpr size_t ID_RANGE = 10000;
+    inline constexpr uint8_t INVALID_INDEX = 0xff;
+
+    inline constexpr auto INDICES = [] {
+        std::array<uint8_t, ID_RANGE> out {};
+        out.fill(INVALID_INDEX);
+
+        for (size_t i = 0; i < COUNT; i++) {
+            out[IDS[i] - FIRST_ID] = i;
+        }
+
+        return out;
+    }();
+
+    static_assert(COUNT < INVALID_INDEX, "too many server packets for an 8-bit index");
+    static_assert([] {
+        for (size_t i = 0; i < COUNT; i++) {
+            if (IDS[i] < FIRST_ID || IDS[i] >= FIRST_ID + ID_RANGE) return false;
+            if (INDICES[IDS[i] - FIRST_ID] != i) return false; // duplicate ID
+        }
+
+        return true;
+    }(), "server packet IDs must be unique and in the 2xxxx range");
+
+    // Returns the dense index of the packet, or `INVALID_INDEX` if it's not a server packet
+    constexpr uint8_t indexOf(packetid_t id) {
+        if (id < FIRST_ID || id >= FIRST_ID + ID_RANGE) return INVALID_INDEX;
+        return INDICES[id - FIRST_ID];
+    }
+}
+
+/*
+* PacketDispatchTable maps server packet IDs to the internal listener of that packet.
+*
+* Lookups are lock-free and wait-free: the table is a flat array indexed by `server_packets::indexOf`,
+* published through an atomic pointer. Modifying it copies the table and swaps the pointer (RCU-style).
+* Old tables and handlers are only freed when the dispatch table is destroyed, so a reader can never see a dangling pointer.
+* Listeners are only registered a handful of times during the lifetime of the game, so this costs barely any memory.
+*/
+class PacketDispatchTable {
+public:
+    using Callback = std::function<void(std::shared_ptr<Packet>)>;
+
+    struct Handler {
+        Callback callback;
+        bool isFinal;
+    };
+
+    PacketDispatchTable();
+
+    PacketDispatchTable(const PacketDispatchTable&) = delete;
+    PacketDispatchTable& operator=(const PacketDispatchTable&) = delete;
+
+    // Returns the handler for the packet, or nullptr if there is none. Lock-free, the handler is valid until the table is destroyed.
+    const Handler* get(packetid_t id) const {
+        auto index = server_packets::indexOf(id);
+        if (index == server_packets::INVALID_INDEX) return nullptr;
+
+        return current.load(std::memory_order::acquire)->handlers[index];
+    }
+
+    // Sets or replaces the handler for the packet. Returns false if the ID is not a server packet.
+    bool set(packetid_t id, Handler&& handler);
+
+    // Removes all handlers
+    void clear();
+
+private:
+    struct Table {
+        std::array<const Handler*, server_packets::COUNT> handlers {};
+    };
+
+    struct Storage {
+        std::vector<std::unique_ptr<Table>> tables;
+        std::vector<std::unique_ptr<Handler>> handlers;
+    };
+
+    std::atomic<const Table*> current;
+    // writers are serialized, this also owns everything that was ever published
+    asp::Mutex<Storage> storage;
+
+    void publish(Storage& st, std::unique_ptr<Table> table);
+};
@@ -15,12 +15,42 @@
 #endif
 
 constexpr size_t DATA_BUF_SIZE = 2 << 18;
+constexpr size_t SEND_ARENA_SIZE = 2 << 12;
+constexpr size_t UDP_SLOT_SIZE = DATA_BUF_SIZE / GameSocket::UDP_BATCH_SIZE;
+
+static_assert(UDP_SLOT_SIZE >= 65507, "udp batch slots must fit the largest possible datagram");
 
 using namespace util::data;
 using namespace util::debug;
 using PollResult = GameSocket::PollResult;
 using ReceivedPacket = GameSocket::ReceivedPacket;
 
+#ifdef GLOBED_DEBUG_PACKETS
+// Amount of players whose data is carried by the packet, for the bytes per player statistic.
+static size_t playerDataCount(Packet& packet) {
+    if (auto p = packet.tryDowncast<LevelDataPacket>()) {
+        return p->players.size();
+    } else if (auto p = packet.tryDowncast<AckedLevelDataPacket>()) {
+        return p->data.players.size();
+    }
+
+    return 0;
+}
+#endif
+
+// Returns an empty per-thread buffer for encoding outgoing packets into. It keeps its capacity between packets,
+// so in the steady state encoding a packet does not allocate.
+static ByteBuffer& sendArena() {
+    static thread_local ByteBuffer arena = [] {
+        ByteBuffer buf;
+        buf.reserve(SEND_ARENA_SIZE);
+        return buf;
+    }();
+
+    arena.clear();
+    return arena;
+}
+
 GameSocket::GameSocket() {
     dataBuffer = new byte[DATA_BUF_SIZE];
 }
@@ -62,18 +92,18 @@ bool GameSocket::isConnected() {
 }
 
 Result<std::shared_ptr<Packet>> GameSocket::recvPacketTCP() {
-    ByteBuffer bb;
-    bb.grow(4);
+    byte lengthBuf[sizeof(uint32_t)];
 
     // receive the packet length
-    GLOBED_UNWRAP(tcpSocket.recvExact(reinterpret_cast<char*>(bb.data().data()), 4));
+    GLOBED_UNWRAP(tcpSocket.recvExact(reinterpret_cast<char*>(lengthBuf), sizeof(lengthBuf)));
 
-    auto packetSize = bb.readU32().value_or(0); // must always be 4 bytes so cant error
+    auto packetSize = ByteBuffer::borrow(lengthBuf, sizeof(lengthBuf)).readU32().value_or(0); // must always be 4 bytes so cant error
     GLOBED_REQUIRE_SAFE(packetSize < DATA_BUF_SIZE, "packet is too big, rejecting")
 
     GLOBED_UNWRAP(tcpSocket.recvExact(reinterpret_cast<char*>(dataBuffer), packetSize));
 
-    ByteBuffer buf(dataBuffer, packetSize);
+    // decode straight from the receive buffer, no copies
+    auto buf = ByteBuffer::borrow(dataBuffer, packetSize);
 
     return this->decodePacket(buf);
 }
@@ -88,13 +118,45 @@ Result<ReceivedPacket> GameSocket::recvPacketUDP() {
         return Err("udp recv failed");
     }
 
-    ByteBuffer buf(dataBuffer, (size_t)recvResult.result);
+    auto buf = ByteBuffer::borrow(dataBuffer, (size_t)recvResult.result);
 
     GLOBED_UNWRAP_INTO(this->decodePacket(buf), out.packet);
 
     return Ok(std::move(out));
 }
 
+Result<> GameSocket::recvPacketsUDP(std::vector<Result<ReceivedPacket>>& out) {
+    UdpSocket::IncomingDatagram datagrams[UDP_BATCH_SIZE];
+
+    for (size_t i = 0; i < UDP_BATCH_SIZE; i++) {
+        datagrams[i].buffer = reinterpret_cast<char*>(dataBuffer + i * UDP_SLOT_SIZE);
+        datagrams[i].capacity = UDP_SLOT_SIZE;
+    }
+
+    for (size_t batch = 0; batch < MAX_UDP_BATCHES; batch++) {
+        GLOBED_UNWRAP_INTO(udpSocket.receiveBatch(datagrams), size_t count);
+
+        for (size_t i = 0; i < count; i++) {
+            auto buf = ByteBuffer::borrow(reinterpret_cast<byte*>(datagrams[i].buffer), (size_t) datagrams[i].size);
+            auto packet = this->decodePacket(buf);
+
+            if (packet.isErr()) {
+                out.push_back(Err(std::move(packet.unwrapErr())));
+            } else {
+                out.push_back(Ok(ReceivedPacket {
+                    .packet = std::move(packet.unwrap()),
+                    .fromConnected = datagrams[i].fromServer,
+                }));
+            }
+        }
+
+        // the socket has been drained
+        if (count < UDP_BATCH_SIZE) break;
+    }
+
+    return Ok();
+}
+
 Result<ReceivedPacket> GameSocket::recvPacket(int timeoutMs) {
     // negative value means poll indefinitely until either tcp or udp receives data
     GLOBED_UNWRAP_INTO(this->poll(timeoutMs), auto pollResult);
@@ -123,7 +185,7 @@ Result<ReceivedPacket> GameSocket::recvPacket() {
 Result<> GameSocket::sendPacket(std::shared_ptr<Packet> packet) {
     GLOBED_REQUIRE_SAFE(this->isConnected(), "attempting to send a packet while disconnected")
 
-    ByteBuffer buf;
+    auto& buf = sendArena();
     GLOBED_UNWRAP(this->encodePacket(*packet, buf))
 
     if (dumpPackets) {
@@ -131,9 +193,9 @@ Result<> GameSocket::sendPacket(std::shared_ptr<Packet> packet) {
     }
 
     if (packet->getUseTcp()) {
-        GLOBED_UNWRAP(tcpSocket.sendAll(reinterpret_cast<const char*>(buf.data().data()), buf.size()));
+        GLOBED_UNWRAP(tcpSocket.sendAll(reinterpret_cast<const char*>(buf.rawData()), buf.size()));
     } else {
-        GLOBED_UNWRAP(udpSocket.send(reinterpret_cast<const char*>(buf.data().data()), buf.size()));
+        GLOBED_UNWRAP(udpSocket.send(reinterpret_cast<const char*>(buf.rawData()), buf.size()));
     }
 
     return Ok();
@@ -142,14 +204,14 @@ Result<> GameSocket::sendPacket(std::shared_ptr<Packet> packet) {
 Result<> GameSocket::sendPacketTo(std::shared_ptr<Packet> packet, const NetworkAddress& address) {
     GLOBED_REQUIRE_SAFE(!packet->getUseTcp(), "cannot send a TCP packet to a UDP connection")
 
-    ByteBuffer buf;
+    auto& buf = sendArena();
     GLOBED_UNWRAP(this->encodePacket(*packet, buf))
 
     if (dumpPackets) {
         this->dumpPacket(packet->getPacketId(), buf, true);
     }
 
-    GLOBED_UNWRAP_INTO(udpSocket.sendTo(reinterpret_cast<const char*>(buf.data().data()), buf.size(), address), auto res)
+    GLOBED_UNWRAP_INTO(udpSocket.sendTo(reinterpret_cast<const char*>(buf.rawData()), buf.size(), address), auto res)
 
     GLOBED_REQUIRE_SAFE(
         res == buf.size(),
@@ -159,6 +221,44 @@ Result<> GameSocket::sendPacketTo(std::shared_ptr<Packet> packet, const NetworkA
     return Ok();
 }
 
+Result<> GameSocket::sendPacketsTo(std::span<const OutgoingPacket> packets) {
+    auto& buf = sendArena();
+
+    // encode everything back to back, the datagrams point into the buffer once it's done growing
+    std::vector<std::pair<size_t, size_t>> ranges;
+    ranges.reserve(packets.size());
+
+    for (auto& out : packets) {
+        GLOBED_REQUIRE_SAFE(!out.packet->getUseTcp(), "cannot send a TCP packet to a UDP connection")
+
+        size_t start = buf.size();
+        GLOBED_UNWRAP(this->encodePacket(*out.packet, buf))
+        ranges.emplace_back(start, buf.size() - start);
+
+        if (dumpPackets) {
+            auto view = ByteBuffer::borrow(buf.rawData() + start, buf.size() - start);
+            this->dumpPacket(out.packet->getPacketId(), view, true);
+        }
+    }
+
+    std::vector<UdpSocket::OutgoingDatagram> datagrams;
+    datagrams.reserve(packets.size());
+
+    for (size_t i = 0; i < packets.size(); i++) {
+        datagrams.push_back(UdpSocket::OutgoingDatagram {
+            .data = reinterpret_cast<const char*>(buf.rawData() + ranges[i].first),
+            .size = static_cast<unsigned int>(ranges[i].second),
+            .address = &packets[i].address,
+        });
+    }
+
+    GLOBED_UNWRAP_INTO(udpSocket.sendBatch(datagrams), size_t sent)
+
+    GLOBED_REQUIRE_SAFE(sent == datagrams.size(), fmt::format("only sent {} out of {} packets", sent, datagrams.size()))
+
+    return Ok();
+}
+
 Result<> GameSocket::sendRecoveryData(int accountId, uint32_t secretKey) {
     ByteBuffer bb;
     bb.writeI32(accountId);
@@ -179,27 +279,35 @@ void GameSocket::togglePacketLogging(bool state) {
     dumpPackets = state;
 }
 
-Result<PollResult> GameSocket::poll(int timeoutMs) {
-    if (!tcpSocket.connected) {
-        GLOBED_UNWRAP_INTO(udpSocket.poll(timeoutMs), auto res);
-        return Ok(res ? PollResult::Udp : PollResult::None);
-    }
+Result<PollResult> GameSocket::poll(int timeoutMs, const PollWakeup* wakeup) {
+    GLOBED_SOCKET_POLLFD fds[3];
+    size_t count = 0;
 
-    GLOBED_SOCKET_POLLFD fds[2];
+    // the tcp socket is only polled while connected
+    bool tcpConnected = tcpSocket.connected;
 
-    fds[0].fd = tcpSocket.socket_;
-    fds[0].events = POLLIN;
-    fds[1].fd = udpSocket.socket_;
-    fds[1].events = POLLIN;
+    fds[count].fd = udpSocket.socket_;
+    fds[count++].events = POLLIN;
 
-    int result = GLOBED_SOCKET_POLL(fds, 2, timeoutMs);
+    if (tcpConnected) {
+        fds[count].fd = tcpSocket.socket_;
+        fds[count++].events = POLLIN;
+    }
+
+    if (wakeup) {
+        fds[count].fd = wakeup->handle();
+        fds[count++].events = POLLIN;
+    }
+
+    int result = GLOBED_SOCKET_POLL(fds, count, timeoutMs);
 
     if (result == -1) {
         return Err(util::net::lastErrorString());
     }
 
-    bool tcp = fds[0].revents & POLLIN;
-    bool udp = fds[1].revents & POLLIN;
+    bool udp = fds[0].revents & POLLIN;
+    // a hangup has to be reported too, otherwise nothing ever reads the socket and notices it got closed
+    bool tcp = tcpConnected && (fds[1].revents & (POLLIN | POLLHUP | POLLERR));
 
     if (tcp && udp) {
         return Ok(PollResult::Both);
@@ -228,20 +336,23 @@ Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer) {
     }
 
     buffer.writeValue<PacketHeader>(header);
-    packet.encode(buffer);
 
-    if (packet.getEncrypted()) {
+    size_t payloadPos = buffer.getPosition();
+    bool encrypted = packet.getEncrypted();
+
+    if (encrypted) {
         GLOBED_REQUIRE_SAFE(cryptoBox.get() != nullptr, "attempted to encrypt a packet when no cryptobox is initialized")
 
-        // grow the vector by CryptoBox::PREFIX_LEN extra bytes to do in-place encryption
+        // leave room for the nonce and the mac, so the packet can be encrypted right where it's encoded
         buffer.grow(CryptoBox::PREFIX_LEN);
-        uint32_t headerSize = PacketHeader::SIZE;
-        if (tcp) {
-            headerSize += sizeof(uint32_t);
-        }
+        buffer.setPosition(payloadPos + CryptoBox::PREFIX_LEN);
+    }
+
+    packet.encode(buffer);
 
-        auto rawSize = buffer.size() - headerSize - startPos - CryptoBox::PREFIX_LEN;
-        cryptoBox->encryptInPlace(buffer.data().data() + startPos + headerSize, rawSize);
+    if (encrypted) {
+        auto rawSize = buffer.size() - payloadPos - CryptoBox::PREFIX_LEN;
+        cryptoBox->encryptWithHeadroom(buffer.rawData() + payloadPos, rawSize);
     }
 
     // write length
@@ -254,6 +365,10 @@ Result<> GameSocket::encodePacket(Packet& packet, ByteBuffer& buffer) {
         buffer.setPosition(lastPos);
     }
 
+#ifdef GLOBED_DEBUG_PACKETS
+    PacketLogger::get().record(header.id, header.encrypted, true, buffer.size() - startPos);
+#endif
+
     return Ok();
 }
 
@@ -264,7 +379,7 @@ Result<std::shared_ptr<Packet>> GameSocket::decodePacket(ByteBuffer& buffer) {
     // packet size without the header
     size_t messageLength = buffer.size() - buffer.getPosition();
 
-    auto packet = matchPacket(header.id);
+    auto packet = packetPool.acquire(header.id);
 
     GLOBED_REQUIRE_SAFE(packet.get() != nullptr, std::string("invalid server-side packet: ") + std::to_string(header.id))
 
@@ -274,9 +389,7 @@ Result<std::shared_ptr<Packet>> GameSocket::decodePacket(ByteBuffer& buffer) {
 
     if (header.encrypted) {
         GLOBED_REQUIRE_SAFE(cryptoBox.get() != nullptr, "attempted to decrypt a packet when no cryptobox is initialized")
-        bytevector& bufvec = buffer.data();
-
-        messageLength = cryptoBox->decryptInPlace(bufvec.data() + PacketHeader::SIZE, messageLength);
+        messageLength = cryptoBox->decryptInPlace(buffer.rawData() + PacketHeader::SIZE, messageLength);
         buffer.resize(messageLength + PacketHeader::SIZE);
     }
 
@@ -289,6 +402,10 @@ Result<std::shared_ptr<Packet>> GameSocket::decodePacket(ByteBuffer& buffer) {
         return Err(fmt::format("Decoding packet ID {} failed: {}", header.id, ByteBuffer::strerror(result.unwrapErr())));
     }
 
+#ifdef GLOBED_DEBUG_PACKETS
+    PacketLogger::get().record(header.id, header.encrypted, false, buffer.size(), playerDataCount(*packet));
+#endif
+
     return Ok(std::move(packet));
 }
 
@@ -306,6 +423,5 @@ void GameSocket::dumpPacket(packetid_t id, ByteBuffer& buffer, bool sending) {
 
     std::ofstream fs(filepath, std::ios::binary);
 
-    const auto& vec = buffer.data();
-    fs.write(reinterpret_cast<const char*>(vec.data()), vec.size());
+    fs.write(reinterpret_cast<const char*>(buffer.rawData()), buffer.size());
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "address.hpp"
 #include "udp_socket.hpp"
 #include "tcp_socket.hpp"
+#include "packet_pool.hpp"
+#include "wakeup.hpp"
 
 #include <data/packets/packet.hpp>
 #include <crypto/box.hpp>
@@ -30,6 +32,10 @@ public:
     // Try to receive a packet on the UDP socket
     Result<ReceivedPacket> recvPacketUDP();
 
+    // Receive all packets that are queued on the UDP socket, a batch of datagrams at a time.
+    // Each packet, or the error that occurred while decoding it, is appended to `out`. Returns Err if receiving itself failed.
+    Result<> recvPacketsUDP(std::vector<Result<ReceivedPacket>>& out);
+
     // Try to receive a packet
     Result<ReceivedPacket> recvPacket();
 
@@ -42,6 +48,14 @@ public:
     // Send a UDP packet to a specific address
     Result<> sendPacketTo(std::shared_ptr<Packet> packet, const NetworkAddress& address);
 
+    struct OutgoingPacket {
+        std::shared_ptr<Packet> packet;
+        sockaddr_in address;
+    };
+
+    // Send UDP packets to specific addresses, with as few syscalls as possible
+    Result<> sendPacketsTo(std::span<const OutgoingPacket> packets);
+
     Result<> sendRecoveryData(int accountId, uint32_t secretKey);
 
     void cleanupBox();
@@ -53,16 +67,23 @@ public:
         None, Tcp, Udp, Both
     };
 
-    Result<PollResult> poll(int timeoutMs);
+    // Wait until either socket is readable. If `wakeup` is given, also returns `None` early once it's notified.
+    Result<PollResult> poll(int timeoutMs, const PollWakeup* wakeup = nullptr);
 
 private:
     friend class NetworkManager;
 
+    // the receive buffer is split into this many slots when receiving udp packets in batches
+    static constexpr size_t UDP_BATCH_SIZE = 8;
+    // after this many full batches the rest is left for the next call, so tcp doesn't starve
+    static constexpr size_t MAX_UDP_BATCHES = 4;
+
     TcpSocket tcpSocket;
     UdpSocket udpSocket;
 
     std::unique_ptr<CryptoBox> cryptoBox;
     util::data::byte* dataBuffer;
+    PacketPool packetPool;
 
     bool dumpPackets = false;
 
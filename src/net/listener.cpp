@@ -4,7 +4,10 @@
 
 using namespace geode::prelude;
 
-PacketListener::~PacketListener() {}
+PacketListener::~PacketListener() {
+    // listeners are removed from the pool right away, instead of the pool scanning for dead ones every frame
+    NetworkManager::get().unregisterPacketListener(packetId, this);
+}
 
 bool PacketListener::init(packetid_t packetId, CallbackFn&& fn, CCObject* owner, int priority, bool isFinal) {
     this->callback = std::move(fn);
@@ -1,12 +1,15 @@
 #include "manager.hpp"
 
 #include "address.hpp"
+#include "dispatch_table.hpp"
 #include "listener.hpp"
 #include "game_socket.hpp"
+#include "wakeup.hpp"
 
 #include <Geode/ui/GeodeUI.hpp>
 #include <asp/sync.hpp>
 #include <asp/thread.hpp>
+#include <deque>
 
 #include <data/packets/all.hpp>
 #include <defs/minimal_geode.hpp>
@@ -20,6 +23,7 @@
 #include <managers/room.hpp>
 #include <managers/role.hpp>
 #include <util/cocos.hpp>
+#include <util/collections.hpp>
 #include <util/format.hpp>
 #include <util/time.hpp>
 #include <util/net.hpp>
@@ -30,6 +34,8 @@ using namespace geode::prelude;
 using ConnectionState = NetworkManager::ConnectionState;
 
 static constexpr uint16_t PROTOCOL_VERSION = 6;
+// first server protocol version that understands PlayerDataDeltaPacket, reported by the server in the handshake response
+static constexpr uint16_t DELTA_PLAYER_DATA_PROTOCOL = 7;
 
 // yes, really
 struct AtomicConnectionState {
@@ -75,6 +81,10 @@ public:
     PacketListenerPool& operator=(const PacketListenerPool&) = delete;
     PacketListenerPool& operator=(PacketListenerPool&&) = delete;
 
+    // max time spent delivering packets per frame, whatever doesn't fit is delivered in the next frame.
+    // at least one packet is always delivered, so a slow listener can't stall the queue.
+    static constexpr auto FRAME_BUDGET = util::time::micros(2000);
+
     static PacketListenerPool& get() {
         static PacketListenerPool instance;
         return instance;
@@ -82,40 +92,23 @@ public:
 
     // Must be called from the main thread. Delivers packets to all listeners that are tied to an object.
     void update(float dt) {
-        if (packetQueue.empty()) return;
+        while (auto packet = packetQueue.tryPop()) {
+            this->enqueue(std::move(packet.value()));
+        }
 
-        // clear any dead listeners
-        this->removeDeadListeners();
+        if (pending.empty()) return;
 
-        while (auto packet_ = packetQueue.tryPop()) {
-            auto& packet = packet_.value();
-            packetid_t id = packet->getPacketId();
+        auto start = util::time::now();
 
-            bool invoked = false;
-            auto& lsm = listeners[id];
+        do {
+            auto entry = std::move(pending.front());
+            pending.pop_front();
 
-            for (auto& listener : lsm) {
-                if (auto l = listener.lock()) {
-                    l->invokeCallback(packet);
-                }
-            }
-        }
-    }
+            // coalesced packets are taken out of their slot only now, so the newest one is delivered
+            auto packet = entry.packet ? std::move(entry.packet) : std::exchange(latest.at(entry.id), nullptr);
 
-    void removeDeadListeners() {
-        for (auto& [id, listeners] : listeners) {
-            for (int i = listeners.size() - 1; i >= 0; i--) {
-                auto addr = addrFromWeakRef(listeners[i]);
-
-                if (!listeners[i].valid()) {
-#ifdef GLOBED_DEBUG
-                    log::debug("Unregistering listener {} (id {})", addr, id);
-#endif
-                    // log::debug("removing listener for {}", id);
-                    listeners.erase(listeners.begin() + i);
-                }
-            }
-        }
+            this->deliver(packet);
+        } while (!pending.empty() && util::time::now() - start < FRAME_BUDGET);
     }
 
     void registerListener(packetid_t id, PacketListener* listener) {
@@ -125,21 +118,37 @@ public:
 
         auto& ls = listeners[id];
 
-        this->removeDeadListeners();
-
         // verify it's not a duplicate
-        bool duped = false;
         for (auto& l : ls) {
-            if (l.lock() == listener) {
-                duped = true;
-                break;
+            if (addrFromWeakRef(l) == listener) {
+                log::warn("duped listener ({}, id {}, owner {}), not adding again", listener, id, listener->owner);
+                return;
             }
         }
 
-        if (!duped) {
-            ls.push_back(WeakRef(listener));
-        } else {
-            log::warn("duped listener ({}, id {}, owner {}), not adding again", listener, id, listener->owner);
+        // keep the listeners sorted by priority, the ones with equal priority run in the order they were added
+        auto pos = std::upper_bound(ls.begin(), ls.end(), listener->priority, [](int priority, const auto& ref) {
+            auto* other = static_cast<PacketListener*>(addrFromWeakRef(ref));
+            return other && priority > other->priority;
+        });
+
+        ls.insert(pos, WeakRef(listener));
+    }
+
+    // Called when a listener is destroyed
+    void unregisterListener(packetid_t id, PacketListener* listener) {
+        auto it = listeners.find(id);
+        if (it == listeners.end()) return;
+
+        auto& ls = it->second;
+        for (size_t i = 0; i < ls.size(); i++) {
+            if (addrFromWeakRef(ls[i]) == listener) {
+#ifdef GLOBED_DEBUG
+                log::debug("Unregistering listener {} (id {})", static_cast<void*>(listener), id);
+#endif
+                ls.erase(ls.begin() + i);
+                return;
+            }
         }
     }
 
@@ -149,12 +158,105 @@ public:
     }
 
 private:
+    struct PendingPacket {
+        packetid_t id;
+        std::shared_ptr<Packet> packet; // nullptr if the packet is coalesced, then it's in `latest`
+    };
+
     std::unordered_map<packetid_t, std::vector<WeakRef<PacketListener>>> listeners;
     asp::Channel<std::shared_ptr<Packet>> packetQueue;
 
+    // packets that were received but not delivered yet, only touched on the main thread
+    std::deque<PendingPacket> pending;
+    // the undelivered packet of each type that newer packets of the same type are folded into, see `coalesce`
+    std::unordered_map<packetid_t, std::shared_ptr<Packet>> latest;
+    std::vector<WeakRef<PacketListener>> deliveryScratch;
+    std::unordered_map<int, size_t> mergeScratch;
+
     PacketListenerPool() {
+        for (packetid_t id : {LevelDataPacket::PACKET_ID, AckedLevelDataPacket::PACKET_ID, LevelPlayerMetadataPacket::PACKET_ID}) {
+            latest[id] = nullptr;
+        }
+
         CCScheduler::get()->scheduleSelector(schedule_selector(PacketListenerPool::update), this, 0.f, false);
     }
+
+    void enqueue(std::shared_ptr<Packet>&& packet) {
+        packetid_t id = packet->getPacketId();
+
+        auto slot = latest.find(id);
+        if (slot == latest.end()) {
+            pending.push_back(PendingPacket { .id = id, .packet = std::move(packet) });
+            return;
+        }
+
+        // if an older one is still waiting, fold the new one into it without changing its place in the queue
+        if (slot->second) {
+            this->coalesce(*slot->second, *packet);
+            return;
+        }
+
+        slot->second = std::move(packet);
+        pending.push_back(PendingPacket { .id = id, .packet = nullptr });
+    }
+
+    // Folds `next` into the undelivered packet `queued` of the same type.
+    void coalesce(Packet& queued, Packet& next) {
+        // the server splits the players of one tick over multiple level data packets on big levels, so those are merged
+        if (auto* level = queued.tryDowncast<LevelDataPacket>()) {
+            this->mergePlayers(level->players, static_cast<LevelDataPacket&>(next).players);
+        } else if (auto* level = queued.tryDowncast<AckedLevelDataPacket>()) {
+            auto& nextLevel = static_cast<AckedLevelDataPacket&>(next);
+            this->mergePlayers(level->data.players, nextLevel.data.players);
+
+            // keep the newest ack, it's ignored anyway if any of the packets asked for a keyframe
+            if (static_cast<int16_t>(nextLevel.ack - level->ack) > 0) {
+                level->ack = nextLevel.ack;
+            }
+
+            level->keyframeRequested |= nextLevel.keyframeRequested;
+        } else if (auto* meta = queued.tryDowncast<LevelPlayerMetadataPacket>()) {
+            // always has everyone on the level
+            std::swap(meta->players, static_cast<LevelPlayerMetadataPacket&>(next).players);
+        }
+    }
+
+    // Adds the players from `from` to `into`, replacing the older data of players that are in both.
+    void mergePlayers(std::vector<AssociatedPlayerData>& into, std::vector<AssociatedPlayerData>& from) {
+        mergeScratch.clear();
+        for (size_t i = 0; i < into.size(); i++) {
+            mergeScratch[into[i].accountId] = i;
+        }
+
+        for (auto& player : from) {
+            auto [it, inserted] = mergeScratch.try_emplace(player.accountId, into.size());
+
+            if (inserted) {
+                into.push_back(std::move(player));
+            } else {
+                into[it->second] = std::move(player);
+            }
+        }
+    }
+
+    void deliver(const std::shared_ptr<Packet>& packet) {
+        auto it = listeners.find(packet->getPacketId());
+        if (it == listeners.end()) return;
+
+        // a callback may add or remove listeners, so iterate over a copy
+        deliveryScratch.assign(it->second.begin(), it->second.end());
+
+        for (auto& listener : deliveryScratch) {
+            auto l = listener.lock();
+            if (!l) continue;
+
+            l->invokeCallback(packet);
+
+            if (l->isFinal) break;
+        }
+
+        deliveryScratch.clear();
+    }
 };
 
 class NetworkManager::Impl {
@@ -163,29 +265,30 @@ protected:
     friend class PacketListenerPool;
 
     static constexpr int BUILTIN_LISTENER_PRIORITY = -10000000;
+    // upper bound on how long the network thread sleeps in poll, even if no timer is due
+    static constexpr int MAX_POLL_TIMEOUT_MS = 1000;
+    static constexpr size_t SEND_LATENCY_SAMPLES = 1024;
 
     struct TaskPingServers {};
     struct TaskSendPacket {
         std::shared_ptr<Packet> packet;
+        util::time::time_point queuedAt;
     };
     struct TaskPingActive {};
 
-    struct GlobalListener {
-        packetid_t packetId;
-        bool isFinal;
-        PacketListener::CallbackFn callback;
-    };
-
     using Task = std::variant<TaskPingServers, TaskSendPacket, TaskPingActive>;
 
     AtomicConnectionState state;
     GameSocket socket;
-    asp::Thread<NetworkManager::Impl*> threadRecv, threadMain;
+    asp::Thread<NetworkManager::Impl*> threadNet;
     asp::Channel<Task> taskQueue;
+    // wakes up the network thread when it's waiting in poll and there are new tasks
+    PollWakeup wakeup;
+    // how long the recently sent packets have been waiting in the task queue
+    asp::Mutex<util::collections::CappedQueue<util::time::micros, SEND_LATENCY_SAMPLES>> sendLatencies;
 
-    // Note that we intentionally don't use Ref here,
-    // as we use the destructor to know if the object owning the listener has been destroyed.
-    asp::Mutex<std::unordered_map<packetid_t, GlobalListener>> listeners;
+    // internal listeners, read by the network thread without locking
+    PacketDispatchTable listeners;
     asp::Mutex<std::unordered_map<packetid_t, util::time::system_time_point>> suppressed;
 
     // these fields are only used by us and in a safe manner, so they don't need a mutex
@@ -194,11 +297,15 @@ protected:
     util::time::time_point lastReceivedPacket;
     util::time::time_point lastSentKeepalive;
     util::time::time_point lastTcpExchange;
+    util::time::time_point nextRecoveryAttempt;
+    std::vector<Result<GameSocket::ReceivedPacket>> udpPackets;
 
+    AtomicBool stopping;
     AtomicBool suspended;
     AtomicBool standalone;
     AtomicBool recovering;
     AtomicBool handshakeDone;
+    AtomicU16 serverProtocol;
     AtomicU8 recoverAttempt;
     AtomicBool ignoreProtocolMismatch;
     AtomicBool wasFromRecovery;
@@ -212,26 +319,23 @@ protected:
 
         this->setupGlobalListeners();
 
-        // start up the threads
-
-        threadRecv.setLoopFunction(&NetworkManager::Impl::threadRecvFunc);
-        threadRecv.setStartFunction([] { geode::utils::thread::setName("Network Thread (in)"); });
-        threadRecv.start(this);
+        this->resetConnectionState();
 
-        threadMain.setLoopFunction(&NetworkManager::Impl::threadMainFunc);
-        threadMain.setStartFunction([] { geode::utils::thread::setName("Network Thread (out)"); });
-        threadMain.start(this);
+        // start up the thread
 
-        this->resetConnectionState();
+        threadNet.setLoopFunction(&NetworkManager::Impl::threadNetFunc);
+        threadNet.setStartFunction([] { geode::utils::thread::setName("Network Thread"); });
+        threadNet.start(this);
     }
 
     ~Impl() {
         // remove all listeners
         this->removeAllListeners();
 
-        log::debug("waiting for network threads to terminate..");
-        threadRecv.stopAndWait();
-        threadMain.stopAndWait();
+        log::debug("waiting for the network thread to terminate..");
+        stopping = true;
+        wakeup.notify();
+        threadNet.stopAndWait();
 
         if (state != ConnectionState::Disconnected) {
             log::debug("disconnecting from the server..");
@@ -252,6 +356,7 @@ protected:
         standalone = false;
         recovering = false;
         handshakeDone = false;
+        serverProtocol = ServerProtocolVersion::LEGACY;
         recoverAttempt = 0;
         wasFromRecovery = false;
         cancellingRecovery = false;
@@ -260,6 +365,7 @@ protected:
         lastReceivedPacket = {};
         lastSentKeepalive = {};
         lastTcpExchange = {};
+        nextRecoveryAttempt = {};
     }
 
     /* connection and tasks */
@@ -295,6 +401,7 @@ protected:
         state = ConnectionState::TcpConnecting;
 
         // actual connection is deferred - the network thread does DNS resolution and TCP connection.
+        wakeup.notify();
 
         return Ok();
     }
@@ -326,24 +433,55 @@ protected:
 
     void cancelReconnect() {
         cancellingRecovery = true;
+        wakeup.notify();
     }
 
     void onConnectionError(const std::string_view reason) {
         ErrorQueues::get().debugWarn(reason);
     }
 
+    void pushTask(Task&& task) {
+        taskQueue.push(std::move(task));
+        wakeup.notify();
+    }
+
     void send(std::shared_ptr<Packet> packet) {
-        taskQueue.push(TaskSendPacket {
-            .packet = std::move(packet)
+        this->pushTask(TaskSendPacket {
+            .packet = std::move(packet),
+            .queuedAt = util::time::now(),
         });
     }
 
     void pingServers() {
-        taskQueue.push(TaskPingServers {});
+        this->pushTask(TaskPingServers {});
     }
 
     void updateServerPing() {
-        taskQueue.push(TaskPingActive {});
+        this->pushTask(TaskPingActive {});
+    }
+
+    NetworkManager::SendQueueStats getSendQueueStats() {
+        auto samples = sendLatencies.lock()->extract();
+
+        NetworkManager::SendQueueStats stats = {};
+        stats.samples = samples.size();
+
+        if (samples.empty()) {
+            return stats;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        auto percentile = [&](size_t p) {
+            return samples[(samples.size() - 1) * p / 100];
+        };
+
+        stats.p50 = percentile(50);
+        stats.p95 = percentile(95);
+        stats.p99 = percentile(99);
+        stats.max = samples.back();
+
+        return stats;
     }
 
     ConnectionState getConnectionState() {
@@ -381,6 +519,7 @@ protected:
     }
 
     void unregisterPacketListener(packetid_t packet, PacketListener* listener, bool suppressUnhandled) {
+        PacketListenerPool::get().unregisterListener(packet, listener);
     }
 
     void suppressUnhandledUntil(packetid_t id, util::time::system_time_point point) {
@@ -388,7 +527,7 @@ protected:
     }
 
     void removeAllListeners() {
-        listeners.lock()->clear();
+        listeners.clear();
     }
 
     // adds a global listener, with same fairness as all other listeners
@@ -406,13 +545,16 @@ protected:
 
     // adds a global listener, which always runs NOT on the main thread and always before other listeners
     void addInternalListener(packetid_t id, PacketCallback&& callback) {
-        GlobalListener listener {
-            .packetId = id,
-            .isFinal = false,
+        bool added = listeners.set(id, PacketDispatchTable::Handler {
             .callback = std::move(callback),
-        };
+            .isFinal = false,
+        });
+
+        if (!added) {
+            log::warn("Tried to add an internal listener for {}, which is not a server packet", id);
+            return;
+        }
 
-        (*listeners.lock())[id] = std::move(listener);
 #ifdef GLOBED_DEBUG
         log::debug("Registered internal listener (id = {})", id);
 #endif
@@ -591,6 +733,7 @@ protected:
     void onCryptoHandshakeResponse(std::shared_ptr<CryptoHandshakeResponsePacket> packet) {
         log::debug("handshake successful, logging in");
         handshakeDone = true;
+        serverProtocol = packet->protocol.version;
 
         auto key = packet->data.key;
 
@@ -721,6 +864,10 @@ protected:
         return ignoreProtocolMismatch ? 0xffff : PROTOCOL_VERSION;
     }
 
+    bool supportsDeltaPlayerData() {
+        return serverProtocol >= DELTA_PLAYER_DATA_PROTOCOL;
+    }
+
     uint32_t getServerTps() {
         return established() ? serverTps.load() : 0;
     }
@@ -741,31 +888,116 @@ protected:
 
     void resume() {
         suspended = false;
+        wakeup.notify();
     }
 
-    /* worker threads */
+    /* network thread */
 
-    void threadRecvFunc() {
-        if (this->suspended || state == ConnectionState::TcpConnecting) {
-            std::this_thread::sleep_for(util::time::millis(100));
+    // Single event loop that runs the connection state machine, sends queued packets and receives packets from both sockets.
+    // It only ever blocks in poll, which returns as soon as a socket is readable, a task is queued or the next timer is due.
+    void threadNetFunc() {
+        if (stopping) {
+            std::this_thread::yield();
             return;
         }
 
-        auto packet_ = socket.recvPacket(100);
-        if (packet_.isErr()) {
-            auto error = std::move(packet_.unwrapErr());
-            if (error != "timed out") {
-                this->onConnectionError(error);
+        // reset the wakeup before looking for work, so that anything queued from now on wakes up the poll below
+        wakeup.consume();
+
+        if (this->suspended) {
+            wakeup.wait(-1);
+            return;
+        }
+
+        this->updateConnectionState();
+
+        if (this->established()) {
+            this->maybeSendKeepalive();
+        }
+
+        while (auto task_ = taskQueue.tryPop()) {
+            auto task = std::move(task_.value());
+
+            if (std::holds_alternative<TaskPingServers>(task)) {
+                this->handlePingTask();
+            } else if (std::holds_alternative<TaskSendPacket>(task)) {
+                this->handleSendPacketTask(std::move(std::get<TaskSendPacket>(task)));
+            } else if (std::holds_alternative<TaskPingActive>(task)) {
+                this->handlePingActive();
             }
+        }
 
+        auto pollResult_ = socket.poll(this->nextPollTimeout(), &wakeup);
+        if (pollResult_.isErr()) {
+            this->onConnectionError(pollResult_.unwrapErr());
             return;
         }
 
-        // this is awesome
-        auto packet__ = packet_.unwrap();
-        auto packet = std::move(packet__.packet);
-        bool fromServer = packet__.fromConnected;
+        auto pollResult = pollResult_.unwrap();
+
+        // prioritize TCP
+        if (pollResult == GameSocket::PollResult::Tcp || pollResult == GameSocket::PollResult::Both) {
+            auto packet = socket.recvPacketTCP();
+            if (packet.isErr()) {
+                this->onConnectionError(packet.unwrapErr());
+            } else {
+                this->handleReceivedPacket(std::move(packet.unwrap()), true);
+            }
+        }
 
+        if (pollResult == GameSocket::PollResult::Udp || pollResult == GameSocket::PollResult::Both) {
+            // drain everything that's queued, bursts of level data and ping responses come in at once
+            auto result = socket.recvPacketsUDP(udpPackets);
+            if (result.isErr()) {
+                this->onConnectionError(result.unwrapErr());
+            }
+
+            for (auto& packet : udpPackets) {
+                if (packet.isErr()) {
+                    this->onConnectionError(packet.unwrapErr());
+                } else {
+                    auto& received = packet.unwrap();
+                    this->handleReceivedPacket(std::move(received.packet), received.fromConnected);
+                }
+            }
+
+            udpPackets.clear();
+        }
+    }
+
+    // Returns how long the network thread can wait in poll before some timer is due
+    int nextPollTimeout() {
+        auto now = util::time::now();
+        util::time::time_point deadline = now + util::time::millis(MAX_POLL_TIMEOUT_MS);
+
+        switch (state) {
+            case ConnectionState::Disconnected: break;
+            case ConnectionState::TcpConnecting: {
+                deadline = recovering ? std::min(deadline, nextRecoveryAttempt) : now;
+            } break;
+            case ConnectionState::Authenticating: {
+                deadline = std::min(deadline, lastReceivedPacket + util::time::seconds(5));
+            } break;
+            case ConnectionState::Established: {
+                // see `maybeSendKeepalive`
+                deadline = std::min({
+                    deadline,
+                    lastReceivedPacket + util::time::seconds(20),
+                    std::max(lastReceivedPacket + util::time::seconds(10), lastSentKeepalive + util::time::seconds(3)),
+                    lastTcpExchange + util::time::seconds(60),
+                });
+            } break;
+        }
+
+        if (deadline <= now) {
+            return 0;
+        }
+
+        // round up, the timers only fire once their time has strictly passed
+        return std::min<int>(util::time::asMillis(deadline - now) + 1, MAX_POLL_TIMEOUT_MS);
+    }
+
+    void handleReceivedPacket(std::shared_ptr<Packet>&& packet, bool fromServer) {
         packetid_t id = packet->getPacketId();
 
         if (id == PingResponsePacket::PACKET_ID) {
@@ -784,18 +1016,12 @@ protected:
     }
 
     void callListener(std::shared_ptr<Packet>&& packet) {
-        packetid_t packetId = packet->getPacketId();
-
         // go through internal listeners
-        auto ls = listeners.lock();
-        if (ls->contains(packetId)) {
-            auto listener = ls->at(packetId);
-            listener.callback(packet);
-            if (listener.isFinal) return;
+        if (auto* listener = listeners.get(packet->getPacketId())) {
+            listener->callback(packet);
+            if (listener->isFinal) return;
         }
 
-        ls.unlock();
-
         // call other listeners
         PacketListenerPool::get().pushPacket(std::move(packet));
     }
@@ -806,12 +1032,7 @@ protected:
         }
     }
 
-    void threadMainFunc() {
-        if (this->suspended) {
-            std::this_thread::sleep_for(util::time::millis(100));
-            return;
-        }
-
+    void updateConnectionState() {
         // Initial tcp connection.
         if (state == ConnectionState::TcpConnecting && !recovering) {
             // try to connect
@@ -841,6 +1062,19 @@ protected:
         }
         // Connection recovery loop itself
         else if (state == ConnectionState::TcpConnecting && recovering) {
+            if (cancellingRecovery) {
+                log::debug("recovery attempts were cancelled.");
+                recovering = false;
+                recoverAttempt = 0;
+                state = ConnectionState::Disconnected;
+                return;
+            }
+
+            // still backing off after the last failed attempt
+            if (util::time::now() < nextRecoveryAttempt) {
+                return;
+            }
+
             log::debug("recovery attempt {}", recoverAttempt.load());
 
             // initiate TCP connection
@@ -876,25 +1110,12 @@ protected:
                     return;
                 }
 
-                auto sleepPeriod = util::time::millis(10000) * attemptNumber;
-
-                log::debug("tcp connect failed, sleeping for {} before trying again", util::format::formatDuration(sleepPeriod));
-
-                // wait for a bit before trying again
+                auto backoff = util::time::millis(10000) * attemptNumber;
 
-                // we sleep 50 times because we want to check if the user cancelled the recovery
-                for (size_t i = 0; i < 50; i++) {
-                    std::this_thread::sleep_for(sleepPeriod / 50);
-
-                    if (cancellingRecovery) {
-                        log::debug("recovery attempts were cancelled.");
-                        recovering = false;
-                        recoverAttempt = 0;
-                        state = ConnectionState::Disconnected;
-                        return;
-                    }
-                }
+                log::debug("tcp connect failed, trying again in {}", util::format::formatDuration(backoff));
 
+                // the network thread keeps running meanwhile, `nextPollTimeout` wakes it up when it's time to try again
+                nextRecoveryAttempt = util::time::now() + backoff;
                 return;
             }
         }
@@ -906,6 +1127,7 @@ protected:
             recovering = true;
             cancellingRecovery = false;
             recoverAttempt = 0;
+            nextRecoveryAttempt = {};
             return;
         }
         // Detect if we disconnected while authenticating, likely the server doesn't expect us
@@ -928,26 +1150,6 @@ protected:
             ));
             return;
         }
-
-        if (this->established()) {
-            this->maybeSendKeepalive();
-        }
-
-        // poll for any incoming packets
-
-        while (auto task_ = taskQueue.popTimeout(util::time::millis(50))) {
-            auto task = task_.value();
-
-            if (std::holds_alternative<TaskPingServers>(task)) {
-                this->handlePingTask();
-            } else if (std::holds_alternative<TaskSendPacket>(task)) {
-                this->handleSendPacketTask(std::move(std::get<TaskSendPacket>(task)));
-            } else if (std::holds_alternative<TaskPingActive>(task)) {
-                this->handlePingActive();
-            }
-        }
-
-        std::this_thread::yield();
     }
 
     void maybeSendKeepalive() {
@@ -992,27 +1194,45 @@ protected:
         auto& gsm = GameServerManager::get();
         auto active = gsm.getActiveId();
 
+        std::vector<GameSocket::OutgoingPacket> pings;
+
         for (auto& [serverId, server] : gsm.getAllServers()) {
             if (serverId == active) continue;
 
             NetworkAddress addr(server.address);
 
+            auto resolved = addr.resolve();
+            if (resolved.isErr()) {
+                log::debug("failed to resolve {}: {}", server.address, resolved.unwrapErr());
+                ErrorQueues::get().warn(resolved.unwrapErr());
+                continue;
+            }
+
 #ifdef GLOBED_DEBUG
             auto addrString = addr.resolveToString().value_or("<unresolved>");
             log::debug("sending ping to {}", addrString);
 #endif
 
             auto pingId = gsm.startPing(serverId);
-            auto result = socket.sendPacketTo(PingPacket::create(pingId), addr);
+            pings.push_back(GameSocket::OutgoingPacket {
+                .packet = PingPacket::create(pingId),
+                .address = resolved.unwrap(),
+            });
+        }
 
-            if (result.isErr()) {
-                log::debug("failed to send ping: {}", result.unwrapErr());
-                ErrorQueues::get().warn(result.unwrapErr());
-            }
+        // all pings go out in one batch
+        auto result = socket.sendPacketsTo(pings);
+
+        if (result.isErr()) {
+            log::debug("failed to send ping: {}", result.unwrapErr());
+            ErrorQueues::get().warn(result.unwrapErr());
         }
     }
 
     void handleSendPacketTask(TaskSendPacket task) {
+        auto waited = util::time::as<util::time::micros>(util::time::now() - task.queuedAt);
+        sendLatencies.lock()->push(std::move(waited));
+
         if (task.packet->getUseTcp()) {
             lastTcpExchange = util::time::now();
         }
@@ -1094,6 +1314,10 @@ void NetworkManager::updateServerPing() {
     impl->updateServerPing();
 }
 
+NetworkManager::SendQueueStats NetworkManager::getSendQueueStats() {
+    return impl->getSendQueueStats();
+}
+
 void NetworkManager::addListener(CCNode* target, packetid_t id, PacketListener* listener) {
     impl->addListener(target, listener);
 }
@@ -1119,6 +1343,10 @@ uint16_t NetworkManager::getUsedProtocol() {
     return impl->getUsedProtocol();
 }
 
+bool NetworkManager::supportsDeltaPlayerData() {
+    return impl->supportsDeltaPlayerData();
+}
+
 uint32_t NetworkManager::getServerTps() {
     return impl->getServerTps();
 }
@@ -3,6 +3,7 @@
 #include <Geode/utils/Result.hpp>
 
 #include <util/singleton.hpp>
+#include <util/time.hpp>
 
 using packetid_t = uint16_t;
 
@@ -39,6 +40,12 @@ public:
         Established,     // fully connected to a server
     };
 
+    // Time that recently sent packets spent in the send queue before hitting the socket
+    struct SendQueueStats {
+        size_t samples;
+        util::time::micros p50, p95, p99, max;
+    };
+
     // Connect to a server
     geode::Result<> connect(const NetworkAddress& address, const std::string_view serverId, bool standalone);
 
@@ -66,6 +73,9 @@ public:
     // If connected, pings the active server if there have been no pings for >5 seconds.
     void updateServerPing();
 
+    // Returns the send queue latency percentiles over the last 1024 sent packets
+    SendQueueStats getSendQueueStats();
+
     // Registers a packet listener and adds it to `target`
     void addListener(cocos2d::CCNode* target, packetid_t id, PacketListener* listener);
 
@@ -100,6 +110,9 @@ public:
     // Returns the protocol version of this client
     uint16_t getUsedProtocol();
 
+    // Returns whether the server accepts delta compressed player data (PlayerDataDeltaPacket), based on the protocol version it reported in the handshake
+    bool supportsDeltaPlayerData();
+
     // Get the TPS of the currently connected server, or 0
     uint32_t getServerTps();
 
@@ -115,9 +128,9 @@ public:
     // Returns whether we are currently trying to reconnect to a server due to an earlier connection break.
     bool reconnecting();
 
-    // Pause all network threads
+    // Pause the network thread
     void suspend();
-    // Resume all network threads
+    // Resume the network thread
     void resume();
 
 private:
@@ -0,0 +1,81 @@
+#include "packet_pool.hpp"
+
+#include <data/packets/all.hpp>
+
+// only packets that are received often and hold no external resources are worth pooling
+static constexpr packetid_t POOLED_PACKETS[] = {
+    PingResponsePacket::PACKET_ID,
+    KeepaliveResponsePacket::PACKET_ID,
+    LevelDataPacket::PACKET_ID,
+    AckedLevelDataPacket::PACKET_ID,
+    LevelPlayerMetadataPacket::PACKET_ID,
+};
+
+// like `matchPacket`, but the packet is not owned by a shared_ptr yet
+static std::unique_ptr<Packet> createPacket(packetid_t id) {
+#define PACKET(pt) case pt::PACKET_ID: return std::make_unique<pt>();
+    switch (id) {
+        GLOBED_FOR_EACH_SERVER_PACKET(PACKET)
+
+        default:
+            return nullptr;
+    }
+#undef PACKET
+}
+
+PacketPool::PacketPool() : freeList(std::make_shared<asp::Mutex<FreeList>>()) {
+    auto list = freeList->lock();
+
+    // preallocate everything so that acquiring and releasing never touches the map structure
+    for (packetid_t id : POOLED_PACKETS) {
+        (*list)[id].reserve(MAX_POOLED_PER_ID);
+    }
+}
+
+std::shared_ptr<Packet> PacketPool::acquire(packetid_t id) {
+    std::unique_ptr<Packet> packet;
+
+    {
+        auto list = freeList->lock();
+
+        auto it = list->find(id);
+        if (it == list->end()) {
+            return matchPacket(id);
+        }
+
+        // the mutex orders this with the release of the previous owner, so all its writes are visible to us
+        if (!it->second.empty()) {
+            packet = std::move(it->second.back());
+            it->second.pop_back();
+        }
+    }
+
+    if (!packet) {
+        packet = createPacket(id);
+    }
+
+    return std::shared_ptr<Packet>(packet.release(), [freeList = freeList](Packet* packet) {
+        release(*freeList, packet);
+    });
+}
+
+void PacketPool::clear() {
+    auto list = freeList->lock();
+
+    for (auto& [_, entries] : *list) {
+        entries.clear();
+    }
+}
+
+void PacketPool::release(asp::Mutex<FreeList>& freeList, Packet* packet) {
+    std::unique_ptr<Packet> owned(packet);
+
+    auto list = freeList.lock();
+    auto& entries = list->at(packet->getPacketId());
+
+    if (entries.size() < MAX_POOLED_PER_ID) {
+        entries.push_back(std::move(owned));
+    }
+
+    // otherwise the pool is full and `owned` deletes the packet after unlocking
+}
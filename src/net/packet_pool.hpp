@@ -0,0 +1,34 @@
+#pragma once
+
+#include <asp/sync.hpp>
+
+#include <data/packets/packet.hpp>
+
+/*
+* PacketPool recycles packet objects of frequently received packets (i.e. LevelDataPacket),
+* so that receiving them in the steady state does not allocate a new packet every time.
+*
+* Pooled packets are handed out with a deleter that puts them back into the pool once the last reference is dropped,
+* which can happen on any thread. The free packets are shared with those deleters, so handed out packets may outlive the pool.
+* Packets that are not pooled are simply created with `matchPacket`.
+*/
+class PacketPool {
+public:
+    PacketPool();
+
+    // Returns an instance of the packet with the given ID, reusing a previous one if possible.
+    // The returned packet holds stale data and must be fully decoded before use. Returns nullptr if the ID is invalid.
+    std::shared_ptr<Packet> acquire(packetid_t id);
+
+    // Drops all free pooled packets. Packets that are still in use are put back once released.
+    void clear();
+
+private:
+    static constexpr size_t MAX_POOLED_PER_ID = 8;
+
+    using FreeList = std::unordered_map<packetid_t, std::vector<std::unique_ptr<Packet>>>;
+
+    std::shared_ptr<asp::Mutex<FreeList>> freeList;
+
+    static void release(asp::Mutex<FreeList>& freeList, Packet* packet);
+};
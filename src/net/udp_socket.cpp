@@ -2,13 +2,16 @@
 
 #include "address.hpp"
 #include <defs/assert.hpp>
+#include <defs/net.hpp>
 #include <util/net.hpp>
 
 #ifdef GEODE_IS_WINDOWS
 # include <Ws2tcpip.h>
 #else
 # include <sys/socket.h>
+# include <sys/uio.h>
 # include <netinet/in.h>
+# include <cerrno>
 # include <unistd.h>
 # include <poll.h>
 #endif
@@ -65,6 +68,134 @@ Result<int> UdpSocket::sendTo(const char* data, unsigned int dataSize, const Net
     return Ok(retval);
 }
 
+#ifdef GLOBED_HAS_MMSG
+
+Result<size_t> UdpSocket::sendBatch(std::span<const OutgoingDatagram> datagrams) {
+    sockaddr_in addrs[MAX_BATCH];
+    iovec iovs[MAX_BATCH];
+    mmsghdr msgs[MAX_BATCH];
+
+    size_t sent = 0;
+
+    while (sent < datagrams.size()) {
+        size_t count = std::min(datagrams.size() - sent, MAX_BATCH);
+
+        for (size_t i = 0; i < count; i++) {
+            auto& dg = datagrams[sent + i];
+
+            if (!dg.address) {
+                GLOBED_REQUIRE_SAFE(connected, "attempting to call UdpSocket::sendBatch on a disconnected socket")
+            }
+
+            addrs[i] = dg.address ? *dg.address : *destAddr_;
+
+            iovs[i].iov_base = const_cast<char*>(dg.data);
+            iovs[i].iov_len = dg.size;
+
+            std::memset(&msgs[i], 0, sizeof(mmsghdr));
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int retval = sendmmsg(socket_, msgs, count, 0);
+
+        if (retval == -1) {
+            return Err(util::net::lastErrorString());
+        }
+
+        sent += retval;
+
+        // the kernel stopped early, the socket buffer is probably full
+        if ((size_t) retval < count) break;
+    }
+
+    return Ok(sent);
+}
+
+Result<size_t> UdpSocket::receiveBatch(std::span<IncomingDatagram> datagrams) {
+    sockaddr_in addrs[MAX_BATCH];
+    iovec iovs[MAX_BATCH];
+    mmsghdr msgs[MAX_BATCH];
+
+    size_t count = std::min(datagrams.size(), MAX_BATCH);
+
+    for (size_t i = 0; i < count; i++) {
+        iovs[i].iov_base = datagrams[i].buffer;
+        iovs[i].iov_len = datagrams[i].capacity;
+
+        std::memset(&msgs[i], 0, sizeof(mmsghdr));
+        msgs[i].msg_hdr.msg_name = &addrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int retval = recvmmsg(socket_, msgs, count, MSG_DONTWAIT, nullptr);
+
+    if (retval == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return Ok(0);
+        }
+
+        return Err(util::net::lastErrorString());
+    }
+
+    for (size_t i = 0; i < (size_t) retval; i++) {
+        datagrams[i].size = msgs[i].msg_len;
+        datagrams[i].fromServer = this->connected && util::net::sameSockaddr(addrs[i], *destAddr_);
+    }
+
+    return Ok(retval);
+}
+
+#else // GLOBED_HAS_MMSG
+
+Result<size_t> UdpSocket::sendBatch(std::span<const OutgoingDatagram> datagrams) {
+    size_t sent = 0;
+
+    for (auto& dg : datagrams) {
+        if (!dg.address) {
+            GLOBED_REQUIRE_SAFE(connected, "attempting to call UdpSocket::sendBatch on a disconnected socket")
+        }
+
+        auto* addr = dg.address ? dg.address : destAddr_.get();
+        int retval = sendto(socket_, dg.data, dg.size, 0, reinterpret_cast<const struct sockaddr*>(addr), sizeof(sockaddr_in));
+
+        if (retval == -1) {
+            return Err(util::net::lastErrorString());
+        }
+
+        sent++;
+    }
+
+    return Ok(sent);
+}
+
+Result<size_t> UdpSocket::receiveBatch(std::span<IncomingDatagram> datagrams) {
+    size_t received = 0;
+
+    for (auto& dg : datagrams) {
+        // the socket is blocking, only receive what's already there
+        GLOBED_UNWRAP_INTO(this->poll(0), bool readable);
+        if (!readable) break;
+
+        auto result = this->receive(dg.buffer, dg.capacity);
+        if (result.result < 0) {
+            return Err(util::net::lastErrorString());
+        }
+
+        dg.size = result.result;
+        dg.fromServer = result.fromServer;
+        received++;
+    }
+
+    return Ok(received);
+}
+
+#endif // GLOBED_HAS_MMSG
+
 void UdpSocket::disconnect() {
     connected = false;
 }
@@ -4,10 +4,28 @@
 #include <defs/platform.hpp>
 #include <asp/sync.hpp>
 
+#include <span>
+
 struct sockaddr_in;
 
 class UdpSocket : public Socket {
 public:
+    // max datagrams handled by a single syscall in the batch functions
+    static constexpr size_t MAX_BATCH = 32;
+
+    struct OutgoingDatagram {
+        const char* data;
+        unsigned int size;
+        const sockaddr_in* address; // nullptr sends to the connected address
+    };
+
+    struct IncomingDatagram {
+        char* buffer;
+        unsigned int capacity;
+        int size; // set by `receiveBatch`
+        bool fromServer; // set by `receiveBatch`
+    };
+
     using Socket::send;
     UdpSocket();
     ~UdpSocket();
@@ -16,6 +34,13 @@ public:
     Result<int> send(const char* data, unsigned int dataSize) override;
     Result<int> sendTo(const char* data, unsigned int dataSize, const NetworkAddress& address);
     RecvResult receive(char* buffer, int bufferSize) override;
+
+    // Send multiple datagrams, with one syscall per `MAX_BATCH` datagrams where supported. Returns the amount of datagrams sent.
+    Result<size_t> sendBatch(std::span<const OutgoingDatagram> datagrams);
+    // Receive up to `datagrams.size()` datagrams that are already queued on the socket, never blocks.
+    // Returns the amount of datagrams received.
+    Result<size_t> receiveBatch(std::span<IncomingDatagram> datagrams);
+
     bool close() override;
     virtual void disconnect();
     Result<bool> poll(int msDelay, bool in = true) override;
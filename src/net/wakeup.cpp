@@ -0,0 +1,115 @@
+#include "wakeup.hpp"
+
+#include <defs/assert.hpp>
+#include <defs/net.hpp>
+#include <util/net.hpp>
+
+#ifdef GEODE_IS_WINDOWS
+# include <WinSock2.h>
+#else
+# include <fcntl.h>
+# include <poll.h>
+# include <unistd.h>
+#endif
+
+#ifdef GLOBED_IS_UNIX
+
+PollWakeup::PollWakeup() {
+    int fds[2];
+    GLOBED_REQUIRE(::pipe(fds) == 0, "failed to create a wakeup pipe: pipe failed");
+
+    readFd = fds[0];
+    writeFd = fds[1];
+
+    // neither side may ever block, a full pipe is already readable anyway
+    for (int fd : fds) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+}
+
+PollWakeup::~PollWakeup() {
+    ::close(readFd);
+    ::close(writeFd);
+}
+
+void PollWakeup::notify() {
+    if (pending.exchange(true)) return;
+
+    char byte = 0;
+    (void) ::write(writeFd, &byte, 1);
+}
+
+void PollWakeup::consume() {
+    char buf[64];
+    while (::read(readFd, buf, sizeof(buf)) > 0) {}
+
+    // only reset after draining, otherwise the byte of a notify that comes in between would be drained
+    // while the flag stays set, and no further notify would write anything.
+    // the exchange also makes the work queued before any skipped notify visible to us
+    (void) pending.exchange(false);
+}
+
+int PollWakeup::handle() const {
+    return readFd;
+}
+
+#else // GLOBED_IS_UNIX
+
+PollWakeup::PollWakeup() {
+    SOCKET sock = ::socket(AF_INET, SOCK_DGRAM, 0);
+    GLOBED_REQUIRE(sock != INVALID_SOCKET, "failed to create a wakeup socket: socket failed");
+
+    socket_ = sock;
+
+    // bind to a random loopback port and connect to ourselves
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    int addrLen = sizeof(addr);
+
+    GLOBED_REQUIRE(::bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0, "failed to create a wakeup socket: bind failed");
+    GLOBED_REQUIRE(::getsockname(sock, reinterpret_cast<sockaddr*>(&addr), &addrLen) == 0, "failed to create a wakeup socket: getsockname failed");
+    GLOBED_REQUIRE(::connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0, "failed to create a wakeup socket: connect failed");
+
+    u_long nonBlocking = 1;
+    ioctlsocket(sock, FIONBIO, &nonBlocking);
+}
+
+PollWakeup::~PollWakeup() {
+    ::closesocket(socket_);
+}
+
+void PollWakeup::notify() {
+    if (pending.exchange(true)) return;
+
+    char byte = 0;
+    (void) ::send(socket_, &byte, 1, 0);
+}
+
+void PollWakeup::consume() {
+    char buf[64];
+    while (::recv(socket_, buf, sizeof(buf), 0) > 0) {}
+
+    // only reset after draining, otherwise the byte of a notify that comes in between would be drained
+    // while the flag stays set, and no further notify would write anything.
+    // the exchange also makes the work queued before any skipped notify visible to us
+    (void) pending.exchange(false);
+}
+
+size_t PollWakeup::handle() const {
+    return socket_;
+}
+
+#endif // GLOBED_IS_UNIX
+
+void PollWakeup::wait(int timeoutMs) {
+    GLOBED_SOCKET_POLLFD fds[1];
+
+    fds[0].fd = this->handle();
+    fds[0].events = POLLIN;
+
+    (void) GLOBED_SOCKET_POLL(fds, 1, timeoutMs);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <defs/platform.hpp>
+#include <defs/minimal_geode.hpp>
+#include <asp/sync.hpp>
+
+/*
+* PollWakeup is a readable handle that can be added to a poll set, so that a thread blocked in poll can be woken up by another thread.
+* On unix it's a pipe, on windows (where WSAPoll only accepts sockets) it's a udp socket connected to itself.
+* Notifications are coalesced, until `consume` is called any further `notify` calls are free.
+*/
+class PollWakeup {
+public:
+    PollWakeup();
+    ~PollWakeup();
+
+    PollWakeup(const PollWakeup&) = delete;
+    PollWakeup& operator=(const PollWakeup&) = delete;
+
+    // Make the handle readable. Thread safe.
+    void notify();
+
+    // Reset the handle to not readable. Must be called by the polling thread before it checks for new work.
+    void consume();
+
+    // Block until `notify` is called or the timeout passes. Negative timeout waits indefinitely.
+    void wait(int timeoutMs);
+
+#ifdef GLOBED_IS_UNIX
+    int handle() const;
+#else
+    size_t handle() const;
+#endif
+
+private:
+    asp::AtomicBool pending = false;
+
+#ifdef GLOBED_IS_UNIX
+    int readFd = -1, writeFd = -1;
+#else
+    size_t socket_ = 0;
+#endif
+};
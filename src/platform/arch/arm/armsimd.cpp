@@ -32,4 +32,45 @@ float globed::simd::arm::pcmVolume(const float* pcm, std::size_t samples) {
 #endif
 }
 
+void globed::simd::arm::pcmMix(float* dest, const float* src, std::size_t samples, float gain) {
+#ifdef GLOBED_ARM64
+    size_t alignedSamples = samples / 4 * 4;
+
+    for (size_t i = 0; i < alignedSamples; i += 4) {
+        float32x4_t destVec = vld1q_f32(dest + i);
+        destVec = vmlaq_n_f32(destVec, vld1q_f32(src + i), gain);
+        vst1q_f32(dest + i, destVec);
+    }
+
+    for (size_t i = alignedSamples; i < samples; i++) {
+        dest[i] += src[i] * gain;
+    }
+#else
+    util::misc::pcmMixSlow(dest, src, samples, gain);
+#endif
+}
+
+void globed::simd::arm::evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, std::size_t count) {
+#ifdef GLOBED_ARM64
+    size_t alignedCount = count / 4 * 4;
+
+    for (size_t i = 0; i < alignedCount; i += 4) {
+        float32x4_t tVec = vld1q_f32(t + i);
+
+        float32x4_t acc = vld1q_f32(c3 + i);
+        acc = vmlaq_f32(vld1q_f32(c2 + i), acc, tVec);
+        acc = vmlaq_f32(vld1q_f32(c1 + i), acc, tVec);
+        acc = vmlaq_f32(vld1q_f32(c0 + i), acc, tVec);
+
+        vst1q_f32(out + i, acc);
+    }
+
+    if (alignedCount < count) {
+        util::misc::evalCubicSlow(out + alignedCount, c0 + alignedCount, c1 + alignedCount, c2 + alignedCount, c3 + alignedCount, t + alignedCount, count - alignedCount);
+    }
+#else
+    util::misc::evalCubicSlow(out, c0, c1, c2, c3, t, count);
+#endif
+}
+
 #endif
\ No newline at end of file
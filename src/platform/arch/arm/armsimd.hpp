@@ -8,6 +8,8 @@
 
 namespace globed::simd::arm {
     float pcmVolume(const float* pcm, std::size_t samples);
+    void pcmMix(float* dest, const float* src, std::size_t samples, float gain);
+    void evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, std::size_t count);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "x86simd.hpp"
+
+#ifdef GLOBED_X86
+
+namespace globed::simd::x86 {
+    // horner's method, ((c3 * t + c2) * t + c1) * t + c0
+
+    static inline float evalCubicScalar(float c0, float c1, float c2, float c3, float t) {
+        return ((c3 * t + c2) * t + c1) * t + c0;
+    }
+
+    void evalCubicSSE(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+        size_t alignedCount = count / 4 * 4;
+
+        for (size_t i = 0; i < alignedCount; i += 4) {
+            __m128 tVec = _mm_loadu_ps(t + i);
+
+            __m128 acc = _mm_loadu_ps(c3 + i);
+            acc = _mm_add_ps(_mm_mul_ps(acc, tVec), _mm_loadu_ps(c2 + i));
+            acc = _mm_add_ps(_mm_mul_ps(acc, tVec), _mm_loadu_ps(c1 + i));
+            acc = _mm_add_ps(_mm_mul_ps(acc, tVec), _mm_loadu_ps(c0 + i));
+
+            _mm_storeu_ps(out + i, acc);
+        }
+
+        for (size_t i = alignedCount; i < count; i++) {
+            out[i] = evalCubicScalar(c0[i], c1[i], c2[i], c3[i], t[i]);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 evalCubicAVX2(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+        size_t alignedCount = count / 8 * 8;
+
+        for (size_t i = 0; i < alignedCount; i += 8) {
+            __m256 tVec = _mm256_loadu_ps(t + i);
+
+            __m256 acc = _mm256_loadu_ps(c3 + i);
+            acc = _mm256_add_ps(_mm256_mul_ps(acc, tVec), _mm256_loadu_ps(c2 + i));
+            acc = _mm256_add_ps(_mm256_mul_ps(acc, tVec), _mm256_loadu_ps(c1 + i));
+            acc = _mm256_add_ps(_mm256_mul_ps(acc, tVec), _mm256_loadu_ps(c0 + i));
+
+            _mm256_storeu_ps(out + i, acc);
+        }
+
+        for (size_t i = alignedCount; i < count; i++) {
+            out[i] = evalCubicScalar(c0[i], c1[i], c2[i], c3[i], t[i]);
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 evalCubicAVX512(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+        size_t alignedCount = count / 16 * 16;
+
+        for (size_t i = 0; i < alignedCount; i += 16) {
+            __m512 tVec = _mm512_loadu_ps(t + i);
+
+            __m512 acc = _mm512_loadu_ps(c3 + i);
+            acc = _mm512_add_ps(_mm512_mul_ps(acc, tVec), _mm512_loadu_ps(c2 + i));
+            acc = _mm512_add_ps(_mm512_mul_ps(acc, tVec), _mm512_loadu_ps(c1 + i));
+            acc = _mm512_add_ps(_mm512_mul_ps(acc, tVec), _mm512_loadu_ps(c0 + i));
+
+            _mm512_storeu_ps(out + i, acc);
+        }
+
+        for (size_t i = alignedCount; i < count; i++) {
+            out[i] = evalCubicScalar(c0[i], c1[i], c2[i], c3[i], t[i]);
+        }
+    }
+}
+
+#endif
@@ -66,6 +66,51 @@ namespace globed::simd::x86 {
 
         return sum / samples;
     }
+
+    void pcmMixSSE(float* dest, const float* src, size_t samples, float gain) {
+        size_t alignedSamples = samples / 4 * 4;
+
+        __m128 gainVec = _mm_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 4) {
+            __m128 srcVec = _mm_mul_ps(_mm_loadu_ps(src + i), gainVec);
+            _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), srcVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX2 pcmMixAVX2(float* dest, const float* src, size_t samples, float gain) {
+        size_t alignedSamples = samples / 8 * 8;
+
+        __m256 gainVec = _mm256_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 8) {
+            __m256 srcVec = _mm256_mul_ps(_mm256_loadu_ps(src + i), gainVec);
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), srcVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    void GLOBED_FEATURE_AVX512 pcmMixAVX512(float* dest, const float* src, size_t samples, float gain) {
+        size_t alignedSamples = samples / 16 * 16;
+
+        __m512 gainVec = _mm512_set1_ps(gain);
+
+        for (size_t i = 0; i < alignedSamples; i += 16) {
+            __m512 srcVec = _mm512_mul_ps(_mm512_loadu_ps(src + i), gainVec);
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(_mm512_loadu_ps(dest + i), srcVec));
+        }
+
+        for (size_t i = alignedSamples; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
 }
 
 #endif
\ No newline at end of file
@@ -125,6 +125,30 @@ namespace globed::simd::x86 {
             return pcmVolumeSSE(pcm, samples);
         }
     }
+
+    void pcmMix(float* dest, const float* src, size_t samples, float gain) {
+        const auto& features = getFeatures();
+
+        if (features.avx512) {
+            pcmMixAVX512(dest, src, samples, gain);
+        } else if (features.avx2) {
+            pcmMixAVX2(dest, src, samples, gain);
+        } else {
+            pcmMixSSE(dest, src, samples, gain);
+        }
+    }
+
+    void evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+        const auto& features = getFeatures();
+
+        if (features.avx512) {
+            evalCubicAVX512(out, c0, c1, c2, c3, t, count);
+        } else if (features.avx2) {
+            evalCubicAVX2(out, c0, c1, c2, c3, t, count);
+        } else {
+            evalCubicSSE(out, c0, c1, c2, c3, t, count);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
@@ -44,6 +44,12 @@ namespace globed::simd::x86 {
     // Calculate the volume of pcm samples, picking the fastest possible implementation.
     float pcmVolume(const float* pcm, size_t samples);
 
+    // Add `src` multiplied by `gain` onto `dest`, picking the fastest possible implementation.
+    void pcmMix(float* dest, const float* src, size_t samples, float gain);
+
+    // out[i] = c0[i] + c1[i] * t[i] + c2[i] * t[i]^2 + c3[i] * t[i]^3, picking the fastest possible implementation.
+    void evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count);
+
 
     /* Functions written with a specific algorithm */
 
@@ -51,6 +57,14 @@ namespace globed::simd::x86 {
     float pcmVolumeSSE(const float* pcm, size_t samples);
     float GLOBED_FEATURE_AVX2 pcmVolumeAVX2(const float* pcm, size_t samples);
     float GLOBED_FEATURE_AVX512DQ pcmVolumeAVX512(const float* pcm, size_t samples);
+
+    void pcmMixSSE(float* dest, const float* src, size_t samples, float gain);
+    void GLOBED_FEATURE_AVX2 pcmMixAVX2(float* dest, const float* src, size_t samples, float gain);
+    void GLOBED_FEATURE_AVX512 pcmMixAVX512(float* dest, const float* src, size_t samples, float gain);
+
+    void evalCubicSSE(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count);
+    void GLOBED_FEATURE_AVX2 evalCubicAVX2(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count);
+    void GLOBED_FEATURE_AVX512 evalCubicAVX512(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count);
 }
 
 #endif
\ No newline at end of file
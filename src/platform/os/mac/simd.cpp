@@ -16,3 +16,19 @@ float util::simd::calcPcmVolume(const float *pcm, size_t samples) {
     return globed::simd::x86::pcmVolume(pcm, samples);
 #endif
 }
+
+void util::simd::mixPcm(float* dest, const float* src, size_t samples, float gain) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::pcmMix(dest, src, samples, gain);
+#else
+    globed::simd::x86::pcmMix(dest, src, samples, gain);
+#endif
+}
+
+void util::simd::evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+#ifdef GEODE_IS_ARM_MAC
+    globed::simd::arm::evalCubic(out, c0, c1, c2, c3, t, count);
+#else
+    globed::simd::x86::evalCubic(out, c0, c1, c2, c3, t, count);
+#endif
+}
@@ -6,3 +6,11 @@
 float util::simd::calcPcmVolume(const float *pcm, size_t samples) {
     return globed::simd::x86::pcmVolume(pcm, samples);
 }
+
+void util::simd::mixPcm(float* dest, const float* src, size_t samples, float gain) {
+    globed::simd::x86::pcmMix(dest, src, samples, gain);
+}
+
+void util::simd::evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+    globed::simd::x86::evalCubic(out, c0, c1, c2, c3, t, count);
+}
@@ -1,6 +1,7 @@
 #include "overlay.hpp"
 
 #include <managers/settings.hpp>
+#include <net/manager.hpp>
 
 using namespace geode::prelude;
 
@@ -45,6 +46,15 @@ bool GlobedOverlay::init() {
         .parent(this)
         .id("ping-label"_spr);
 
+    if (settings.sendLatency) {
+        Build<CCLabelBMFont>::create("", "bigFont.fnt")
+            .opacity(static_cast<uint8_t>(settings.opacity * 255))
+            .scale(0.6f)
+            .store(latencyLabel)
+            .parent(this)
+            .id("latency-label"_spr);
+    }
+
 #ifdef GLOBED_DEBUG
     std::string versionStr = Mod::get()->getVersion().toVString();
     Build<CCLabelBMFont>::create(versionStr.c_str(), "bigFont.fnt")
@@ -66,10 +76,21 @@ void GlobedOverlay::updatePing(uint32_t ms) {
 
     auto fmted = fmt::format("{} ms", ms);
     pingLabel->setString(fmted.c_str());
+
+    if (latencyLabel) {
+        auto stats = NetworkManager::get().getSendQueueStats();
+        auto latency = fmt::format("send {:.1f} / {:.1f} ms, {:.0f}/s", stats.p50.count() / 1000.f, stats.p99.count() / 1000.f, sendRate);
+        latencyLabel->setString(latency.c_str());
+    }
+
     this->setVisible(true);
     this->updateLayout();
 }
 
+void GlobedOverlay::updateSendRate(float rate) {
+    sendRate = rate;
+}
+
 void GlobedOverlay::updateWithDisconnected() {
     auto& settings = GlobedSettings::get();
     if (!settings.overlay.enabled) return;
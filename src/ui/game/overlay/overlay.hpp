@@ -6,6 +6,7 @@ public:
     bool init();
 
     void updatePing(uint32_t ms);
+    void updateSendRate(float rate);
     void updateWithDisconnected();
     void updateWithEditor();
 
@@ -14,5 +15,8 @@ public:
 private:
     cocos2d::CCLabelBMFont
         *pingLabel = nullptr,
+        *latencyLabel = nullptr,
         *versionLabel = nullptr;
+
+    float sendRate = 0.f;
 };
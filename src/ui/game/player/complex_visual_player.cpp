@@ -2,6 +2,7 @@
 
 #include "remote_player.hpp"
 #include <hooks/game_manager.hpp>
+#include <managers/icon_loader.hpp>
 #include <managers/settings.hpp>
 #include <util/misc.hpp>
 #include <util/rng.hpp>
@@ -18,7 +19,6 @@ bool ComplexVisualPlayer::init(RemotePlayer* parent, bool isSecond) {
 
     this->gameLayer = GJBaseGameLayer::get();
     this->isPlatformer = gameLayer->m_level->isPlatformer();
-    this->isEditor = typeinfo_cast<LevelEditorLayer*>(this->gameLayer) != nullptr;
 
     auto& data = parent->getAccountData();
 
@@ -93,10 +93,19 @@ void ComplexVisualPlayer::updateIcons(const PlayerIconData& icons) {
         storedIcons.deathEffect = 1;
     }
 
+    waitingForIcons = false;
+
     // android is funny and quirky
     if (static_cast<HookedGameManager*>(gm)->getAssetsPreloaded() GEODE_ANDROID(|| true)) {
         this->updatePlayerObjectIcons(true);
         this->updateIconType(playerIconType);
+    } else if (IconLoadManager::get().isEnabled()) {
+        if (IconLoadManager::get().requestIcons(storedIcons)) {
+            this->updatePlayerObjectIcons(true);
+            this->updateIconType(playerIconType);
+        } else {
+            waitingForIcons = true;
+        }
     } else {
         this->tryLoadIconsAsync();
     }
@@ -123,7 +132,7 @@ void ComplexVisualPlayer::updateIcons(const PlayerIconData& icons) {
 void ComplexVisualPlayer::updateData(
         const SpecificIconData& data,
         const VisualPlayerState& playerData,
-        const GameCameraState& camState,
+        CullLevel cullLevel,
         bool isSpeaking,
         float loudness
 ) {
@@ -131,7 +140,7 @@ void ComplexVisualPlayer::updateData(
 
     wasRotating = data.isRotating;
 
-    bool isNearby = this->isPlayerNearby(camState);
+    bool isNearby = cullLevel != CullLevel::Far;
     bool cameNearby = isNearby && !wasNearby;
     wasNearby = isNearby;
 
@@ -215,7 +224,7 @@ void ComplexVisualPlayer::updateData(
         this->updateOpacity();
     }
 
-    if (statusIcons && isNearby) {
+    if (statusIcons && cullLevel == CullLevel::Visible) {
         statusIcons->updateStatus(playerData.isPaused, playerData.isPracticing, isSpeaking, playerData.isInEditor, loudness);
     }
 
@@ -432,6 +441,13 @@ void ComplexVisualPlayer::setForciblyHidden(bool state) {
     isForciblyHidden = state;
 }
 
+void ComplexVisualPlayer::cull() {
+    this->setVisible(false);
+
+    // replay the animations once they come back
+    wasNearby = false;
+}
+
 static inline ccColor3B lerpColor(ccColor3B from, ccColor3B to, float delta) {
     delta = std::clamp(delta, 0.f, 1.f);
 
@@ -667,6 +683,22 @@ RemotePlayer* ComplexVisualPlayer::getRemotePlayer() {
     return parent;
 }
 
+void ComplexVisualPlayer::onIconsLoaded() {
+    if (!waitingForIcons || !IconLoadManager::get().isReady(storedIcons)) return;
+
+    waitingForIcons = false;
+
+    this->updatePlayerObjectIcons(true);
+    this->updateIconType(playerIconType);
+}
+
+void ComplexVisualPlayer::refreshIconFrames() {
+    if (waitingForIcons || playerIconType == PlayerIconType::Unknown) return;
+
+    // other gamemodes look up their frames when the player switches to them
+    this->callUpdateWith(playerIconType, util::misc::getIconWithType(storedIcons, playerIconType));
+}
+
 void ComplexVisualPlayer::setP1StickyState(bool state) {
     p1sticky = state;
 }
@@ -773,34 +805,6 @@ void ComplexVisualPlayer::disableTrail() {
     // playerIcon->fadeOutStreak2(0.2f);
 }
 
-bool ComplexVisualPlayer::isPlayerNearby(const GameCameraState& camState) {
-    // always render them in editor (cause im lazy)
-    if (isEditor) return true;
-
-    // check if they are inside 3 screens
-    constexpr float fullScaleMult = 3.f;
-    constexpr float originMoveMult = (fullScaleMult - 1.f) / 2.f; // magic
-    CCSize origCoverage = camState.cameraCoverage();
-    CCSize cameraCoverage = origCoverage * fullScaleMult;
-    CCPoint cameraOrigin = camState.cameraOrigin - origCoverage * originMoveMult;
-
-    float cameraLeft = cameraOrigin.x;
-    float cameraRight = cameraOrigin.x + cameraCoverage.width;
-    float cameraBottom = cameraOrigin.y;
-    float cameraTop = cameraOrigin.y + cameraCoverage.height;
-
-    const auto& playerPosition = this->getPlayerPosition();
-
-    bool inCameraCoverage = (
-        playerPosition.x >= cameraLeft &&
-        playerPosition.x <= cameraRight &&
-        playerPosition.y >= cameraBottom &&
-        playerPosition.y <= cameraTop
-    );
-
-    return inCameraCoverage;
-}
-
 ComplexVisualPlayer* ComplexVisualPlayer::create(RemotePlayer* parent, bool isSecond) {
     auto ret = new ComplexVisualPlayer;
     if (ret->init(parent, isSecond)) {
@@ -21,7 +21,7 @@ public:
     void updateData(
         const SpecificIconData& data,
         const VisualPlayerState& playerData,
-        const GameCameraState& camState,
+        CullLevel cullLevel,
         bool isSpeaking,
         float loudness
     );
@@ -30,10 +30,17 @@ public:
     void playSpiderTeleport(const SpiderTeleportData& data);
     void playJump();
     void setForciblyHidden(bool state);
+    // Hide the player while they are too far away to be updated
+    void cull();
     const cocos2d::CCPoint& getPlayerPosition();
     cocos2d::CCNode* getPlayerObject();
     RemotePlayer* getRemotePlayer();
 
+    // Called when icons requested from `IconLoadManager` finish loading, updates the icons if it was waiting for them
+    void onIconsLoaded();
+    // Looks up the sprite frames of the current icon again, called when `IconAtlasManager` moved them into a different texture
+    void refreshIconFrames();
+
     void setP1StickyState(bool state);
     void setP2StickyState(bool state);
 
@@ -60,7 +67,6 @@ protected:
     PlayerIconType playerIconType = PlayerIconType::Unknown;
     Ref<PlayerStatusIcons> statusIcons;
     bool isPlatformer;
-    bool isEditor;
 
     // these 3 used in robot and spider anims
     bool wasGrounded = false;
@@ -103,6 +109,8 @@ protected:
     };
 
     int iconsLoaded = 0;
+    // true if waiting for `IconLoadManager` to load the icons
+    bool waitingForIcons = false;
     std::unordered_map<int, AsyncLoadRequest> asyncLoadRequests;
 
     static constexpr int ROBOT_FIRE_ACTION = 1000727;
@@ -130,5 +138,4 @@ protected:
     void enableTrail();
     void disableTrail();
 
-    bool isPlayerNearby(const GameCameraState& camState);
 };
\ No newline at end of file
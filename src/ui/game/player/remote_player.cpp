@@ -53,10 +53,13 @@ void RemotePlayer::updateData(
         const VisualPlayerState& data,
         FrameFlags frameFlags,
         bool speaking,
-        float loudness
+        float loudness,
+        CullLevel cullLevel
 ) {
-    player1->updateData(data.player1, data, *gameCameraState, speaking, loudness);
-    player2->updateData(data.player2, data, *gameCameraState, speaking, loudness);
+    this->cullLevel = cullLevel;
+
+    player1->updateData(data.player1, data, cullLevel, speaking, loudness);
+    player2->updateData(data.player2, data, cullLevel, speaking, loudness);
 
     isEditorBuilding = data.isEditorBuilding;
 
@@ -90,6 +93,26 @@ void RemotePlayer::updateData(
     }
 }
 
+void RemotePlayer::updateCulled(const VisualPlayerState& data) {
+    if (cullLevel != CullLevel::Far) {
+        cullLevel = CullLevel::Far;
+        player1->cull();
+        player2->cull();
+    }
+
+    isEditorBuilding = data.isEditorBuilding;
+
+    lastPercentage = data.currentPercentage;
+    lastFrameFlags = {};
+    lastVisualState = data;
+
+    wasPracticing = data.isPracticing;
+}
+
+CullLevel RemotePlayer::getCullLevel() const {
+    return cullLevel;
+}
+
 void RemotePlayer::updateProgressIcon() {
     if (progressIcon) {
         progressIcon->updatePosition(lastPercentage, wasPracticing);
@@ -98,7 +121,8 @@ void RemotePlayer::updateProgressIcon() {
             progressIcon->setVisible(false);
         }
     } else if (progressArrow) {
-        progressArrow->updatePosition(*gameCameraState, player1->getPlayerPosition());
+        // the icon is not moved while the player is culled, so use the state instead
+        progressArrow->updatePosition(*gameCameraState, lastVisualState.player1.position);
 
         if (isForciblyHidden || isEditorBuilding) {
             progressArrow->setVisible(false);
@@ -18,8 +18,12 @@ public:
         const VisualPlayerState& data,
         FrameFlags frameFlags,
         bool speaking,
-        float loudness
+        float loudness,
+        CullLevel cullLevel
     );
+    // Like `updateData`, but for players that are too far away to be seen. Only remembers the state and hides the player.
+    void updateCulled(const VisualPlayerState& data);
+    CullLevel getCullLevel() const;
     void updateProgressIcon();
     void updateProgressArrow(
         cocos2d::CCPoint cameraOrigin,
@@ -58,6 +62,7 @@ protected:
     bool wasPracticing = false;
     bool isForciblyHidden = false;
     bool isEditorBuilding = false;
+    CullLevel cullLevel = CullLevel::Visible;
 
 
     GameCameraState* gameCameraState;
@@ -4,6 +4,7 @@
 #include <audio/voice_playback_manager.hpp>
 #include <hooks/gjbasegamelayer.hpp>
 #include <managers/profile_cache.hpp>
+#include <managers/settings.hpp>
 
 using namespace geode::prelude;
 
@@ -31,7 +32,13 @@ void GlobedVoiceOverlay::addPlayer(int accountId) {
         accdata = data.value();
     }
 
-    auto* cell = VoiceOverlayCell::create(accdata);
+    VoiceJitterStats stats;
+    bool showStats = GlobedSettings::get().levelUi.voiceOverlayStats;
+    if (showStats) {
+        stats = VoicePlaybackManager::get().getJitterStats(accountId);
+    }
+
+    auto* cell = VoiceOverlayCell::create(accdata, showStats ? &stats : nullptr);
     this->addChild(cell);
 }
 
@@ -39,17 +46,50 @@ void GlobedVoiceOverlay::updateOverlay() {
 #ifdef GLOBED_VOICE_SUPPORT
     auto& vpm = VoicePlaybackManager::get();
 
-    this->removeAllChildren();
-
     bool isProximity = GlobedGJBGL::get()->m_fields->isVoiceProximity;
 
-    vpm.forEachStream([this, isProximity = isProximity](int accountId, AudioStream& stream) {
+    std::vector<int> speaking;
+    vpm.forEachStream([&speaking, isProximity = isProximity](int accountId, AudioStream& stream) {
         if (!stream.starving && (!isProximity || stream.getVolume() > 0.005f)) {
-            this->addPlayer(accountId);
+            speaking.push_back(accountId);
         }
     });
 
-    this->updateLayout();
+    bool showStats = GlobedSettings::get().levelUi.voiceOverlayStats;
+    bool changed = false;
+
+    // keep the cells of players that are still speaking, and refresh their stats
+    std::unordered_set<int> existing;
+    std::vector<VoiceOverlayCell*> stopped;
+
+    for (auto* cell : CCArrayExt<VoiceOverlayCell*>(this->getChildren())) {
+        if (std::find(speaking.begin(), speaking.end(), cell->accountId) == speaking.end()) {
+            stopped.push_back(cell);
+            continue;
+        }
+
+        existing.insert(cell->accountId);
+
+        if (showStats) {
+            changed |= cell->updateStats(vpm.getJitterStats(cell->accountId));
+        }
+    }
+
+    for (auto* cell : stopped) {
+        cell->removeFromParent();
+        changed = true;
+    }
+
+    for (int accountId : speaking) {
+        if (!existing.contains(accountId)) {
+            this->addPlayer(accountId);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        this->updateLayout();
+    }
 #endif // GLOBED_VOICE_SUPPORT
 }
 
@@ -7,7 +7,7 @@
 using namespace geode::prelude;
 using namespace util::ui;
 
-bool VoiceOverlayCell::init(const PlayerAccountData& data) {
+bool VoiceOverlayCell::init(const PlayerAccountData& data, const VoiceJitterStats* stats) {
     if (!CCNode::init()) return false;
 
     Build<CCNode>::create()
@@ -30,57 +30,94 @@ bool VoiceOverlayCell::init(const PlayerAccountData& data) {
     // username
     ccColor3B nameColor = util::ui::getNameColor(data.specialUserData);
 
-    auto nameLabel = Build<CCLabelBMFont>::create(data.name.c_str(), "bigFont.fnt")
+    Build<CCLabelBMFont>::create(data.name.c_str(), "bigFont.fnt")
         .scale(0.35f)
         .color(nameColor)
         .parent(nodeWrapper)
-        .collect();
+        .store(nameLabel);
 
     // player icon
     auto gm = GameManager::get();
     auto color1 = gm->colorForIdx(data.icons.color1);
     auto color2 = gm->colorForIdx(data.icons.color2);
 
-    auto playerIcon = Build<GlobedSimplePlayer>::create(data.icons)
+    Build<GlobedSimplePlayer>::create(data.icons)
         .scale(0.45f)
         .pos(0.f, 0.f)
         .anchorPoint(0.5f, 0.5f)
         .parent(nodeWrapper)
-        .collect();
+        .store(playerIcon);
 
-    const float heightMult = 1.3f;
-    const float widthMult = 1.1f;
-
-    nodeWrapper->setContentWidth(playerIcon->getScaledContentSize().width + 5.f + nameLabel->getScaledContentSize().width + 5.f + visualizer->getScaledContentSize().width);
-    nodeWrapper->setContentHeight(playerIcon->getScaledContentSize().height * heightMult);
-    nodeWrapper->updateLayout();
+    if (stats) {
+        Build<CCLabelBMFont>::create("", "chatFont.fnt")
+            .scale(0.4f)
+            .parent(nodeWrapper)
+            .store(statsLabel);
+    }
 
     // background
-    auto sizeScale = 4.f;
-    auto cc9s = Build<CCScale9Sprite>::create("square02_001.png")
-        .contentSize(nodeWrapper->getScaledContentSize() * sizeScale + CCPoint{37.f, 25.f})
+    const float sizeScale = 4.f;
+    Build<CCScale9Sprite>::create("square02_001.png")
         .scaleX(1.f / sizeScale)
         .scaleY(1.f / sizeScale)
         .opacity(80)
         .zOrder(-1)
         .anchorPoint(0.f, 0.f)
         .parent(this)
-        .collect();
-
-    this->setContentSize(cc9s->getScaledContentSize());
+        .store(background);
 
-    nodeWrapper->setPosition({this->getScaledContentSize().width - nodeWrapper->getScaledContentSize().width - 5.f, 3.5f});
+    if (stats) {
+        this->updateStats(*stats);
+    } else {
+        this->relayout();
+    }
 
     return true;
 }
 
+void VoiceOverlayCell::relayout() {
+    const float heightMult = 1.3f;
+    const float sizeScale = 4.f;
+
+    float statsWidth = statsLabel ? statsLabel->getScaledContentSize().width + 5.f : 0.f;
+
+    nodeWrapper->setContentWidth(statsWidth + playerIcon->getScaledContentSize().width + 5.f + nameLabel->getScaledContentSize().width + 5.f + visualizer->getScaledContentSize().width);
+    nodeWrapper->setContentHeight(playerIcon->getScaledContentSize().height * heightMult);
+    nodeWrapper->updateLayout();
+
+    background->setContentSize(nodeWrapper->getScaledContentSize() * sizeScale + CCPoint{37.f, 25.f});
+
+    this->setContentSize(background->getScaledContentSize());
+
+    nodeWrapper->setPosition({this->getScaledContentSize().width - nodeWrapper->getScaledContentSize().width - 5.f, 3.5f});
+}
+
 void VoiceOverlayCell::updateVolume(float vol) {
     visualizer->setVolume(vol);
 }
 
-VoiceOverlayCell* VoiceOverlayCell::create(const PlayerAccountData& data) {
+bool VoiceOverlayCell::updateStats(const VoiceJitterStats& stats) {
+    if (!statsLabel) return false;
+
+    auto text = fmt::format(
+        "{}ms jitter, {}ms delay\n{} late, {} lost, {} concealed",
+        (int) (stats.jitter * 1000.f), (int) (stats.targetDelay * 1000.f), stats.late, stats.lost, stats.concealed
+    );
+
+    // the width only changes with the text, don't relayout every time
+    if (text == statsLabel->getString()) return false;
+
+    auto oldSize = this->getContentSize();
+
+    statsLabel->setString(text.c_str());
+    this->relayout();
+
+    return this->getContentSize() != oldSize;
+}
+
+VoiceOverlayCell* VoiceOverlayCell::create(const PlayerAccountData& data, const VoiceJitterStats* stats) {
     auto ret = new VoiceOverlayCell;
-    if (ret->init(data)) {
+    if (ret->init(data, stats)) {
         ret->autorelease();
         return ret;
     }
@@ -1,19 +1,30 @@
 #pragma once
 #include <defs/all.hpp>
 
+#include <audio/jitter_buffer.hpp>
 #include <data/types/gd.hpp>
 #include <ui/general/audio_visualizer.hpp>
 
+class GlobedSimplePlayer;
+
 class VoiceOverlayCell : public cocos2d::CCNode {
 public:
-    static VoiceOverlayCell* create(const PlayerAccountData& data);
+    // if `stats` is not null, they are shown next to the player
+    static VoiceOverlayCell* create(const PlayerAccountData& data, const VoiceJitterStats* stats = nullptr);
     void updateVolume(float vol);
+    // does nothing if the cell was created without stats. returns `true` if the size of the cell changed
+    bool updateStats(const VoiceJitterStats& stats);
 
     int accountId;
 
 private:
     GlobedAudioVisualizer* visualizer;
     cocos2d::CCNode* nodeWrapper;
+    GlobedSimplePlayer* playerIcon;
+    cocos2d::CCLabelBMFont* nameLabel;
+    cocos2d::CCLabelBMFont* statsLabel = nullptr;
+    cocos2d::extension::CCScale9Sprite* background;
 
-    bool init(const PlayerAccountData& data);
+    bool init(const PlayerAccountData& data, const VoiceJitterStats* stats);
+    void relayout();
 };
\ No newline at end of file
@@ -12,7 +12,8 @@ enum {
     TAG_COLLISION = 454,
     TAG_TWO_PLAYER,
     TAG_PUBLIC_INVITES,
-    TAG_INVITE_ONLY
+    TAG_INVITE_ONLY,
+    TAG_PRECISE_POSITIONS
 };
 
 #define MAKE_SETTING(name, desc, tag, storage) \
@@ -29,6 +30,7 @@ bool RoomSettingsPopup::setup() {
     MAKE_SETTING("Private Room", "While enabled, the room can not be found on the public room listing and can only be joined by entering the room ID", TAG_INVITE_ONLY, cellInviteOnly);
     MAKE_SETTING("Open Invites", "While enabled, all players in the room can invite players instead of just the room owner", TAG_PUBLIC_INVITES, cellPublicInvites);
     MAKE_SETTING("Collision", "While enabled, players can collide with each other", TAG_COLLISION, cellCollision);
+    MAKE_SETTING("Precise Positions", "While enabled, the server sends exact positions of other players instead of slightly rounded ones. Uses more bandwidth.", TAG_PRECISE_POSITIONS, cellPrecisePositions);
 
 #ifdef GLOBED_DEBUG
     MAKE_SETTING("2-Player Mode", "While enabled, players can link with another player to play a 2-player enabled level together", TAG_TWO_PLAYER, cellTwoPlayer);
@@ -65,6 +67,7 @@ void RoomSettingsPopup::onSettingClicked(cocos2d::CCObject* sender) {
         case TAG_PUBLIC_INVITES: currentSettings.flags.publicInvites = enabled; break;
         case TAG_COLLISION: currentSettings.flags.collision = enabled; break;
         case TAG_TWO_PLAYER: currentSettings.flags.twoPlayerMode = enabled; break;
+        case TAG_PRECISE_POSITIONS: currentSettings.flags.precisePositions = enabled; break;
     }
 
     // if we are not the room owner, just revert the changes next frame
@@ -84,6 +87,7 @@ void RoomSettingsPopup::updateCheckboxes() {
     cellInviteOnly->setToggled(currentSettings.flags.isHidden);
     cellPublicInvites->setToggled(currentSettings.flags.publicInvites);
     cellCollision->setToggled(currentSettings.flags.collision);
+    cellPrecisePositions->setToggled(currentSettings.flags.precisePositions);
 #ifdef GLOBED_DEBUG
     cellTwoPlayer->setToggled(currentSettings.flags.twoPlayerMode);
 #endif
@@ -95,6 +99,7 @@ void RoomSettingsPopup::enableCheckboxes(bool enabled) {
     cellInviteOnly->setEnabled(enabled);
     cellPublicInvites->setEnabled(enabled);
     cellCollision->setEnabled(enabled);
+    cellPrecisePositions->setEnabled(enabled);
 
 #ifdef GLOBED_DEBUG
     cellTwoPlayer->setEnabled(enabled);
@@ -27,7 +27,8 @@ private:
         *cellInviteOnly,
         *cellCollision,
         *cellTwoPlayer,
-        *cellPublicInvites
+        *cellPublicInvites,
+        *cellPrecisePositions
         ;
 
     bool setup() override;
@@ -215,6 +215,8 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.globed.autoconnect, "Autoconnect", "Automatically connect to the last connected server on launch.");
             registerSetting(cat, settings.globed.preloadAssets, "Preload assets", "Increases the loading times but prevents most lagspikes in a level.");
             registerSetting(cat, settings.globed.deferPreloadAssets, "Defer preloading", "Instead of making the loading screen longer, load assets only when you join a level while connected.");
+            registerSetting(cat, settings.globed.lazyIconLoading, "Load icons on demand", "Instead of preloading every icon in the game, only load the icons of players you meet, in the background. Makes loading much faster and uses less memory, but icons may briefly show up as default ones.");
+            registerSetting(cat, settings.globed.textureDiskCache, "Cache decoded textures", "Saves decoded icon sheets to disk, making preloading faster next time at the cost of some disk space. Takes effect after restarting the game.");
             registerSetting(cat, settings.globed.invitesFrom, "Receive invites from", "Controls who can invite you into a room.", Type::InvitesFrom);
             registerSetting(cat, settings.globed.fragmentationLimit, "Packet limit", "Press the \"Test\" button to calibrate the maximum packet size. Should fix some of the issues with players not appearing in a level.", Type::PacketFragmentation);
             registerSetting(cat, settings.globed.tpsCap, "TPS cap", "Maximum amount of packets per second sent between the client and the server. Useful only for very silly things.");
@@ -244,6 +246,8 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.communication.lowerAudioLatency, "Lower audio latency", "Decreases the audio buffer size by 2 times, reducing the latency but potentially causing audio issues.");
             registerSetting(cat, settings.communication.deafenNotification, "Deafen notification", "Shows a notification when you deafen & undeafen.");
             registerSetting(cat, settings.communication.audioDevice, "Audio device", "The input device used for recording your voice.", Type::AudioDevice);
+            registerSetting(cat, settings.communication.sharedVoiceMixer, "Shared voice mixer", "Plays all voices through a single audio stream instead of one per player. Recommended when many people talk at once. Applies to the next level you join.");
+            registerSetting(cat, settings.communication.mixedSpeakerLimit, "Speaker limit", "When using the shared voice mixer, the maximum amount of players that can be heard at the same time. The loudest ones are picked.");
             // MAKE_SETTING(communication, voiceLoopback, "Voice loopback", "When enabled, you will hear your own voice as you speak.");
 #endif // GLOBED_VOICE_SUPPORT
         } break;
@@ -252,12 +256,14 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.levelUi.progressIndicators, "Progress icons", "Show small icons under the progressbar (or at the edge of the screen in platformer), indicating how far other players are in the level.");
             registerSetting(cat, settings.levelUi.progressOpacity, "Indicator opacity", "Changes the opacity of the icons that represent other players.");
             registerSetting(cat, settings.levelUi.voiceOverlay, "Voice overlay", "Show a small overlay in the bottom right indicating currently speaking players.");
+            registerSetting(cat, settings.levelUi.voiceOverlayStats, "Voice overlay stats", "Show connection stats of every speaking player in the voice overlay: jitter, playout delay, and how many voice frames arrived late, got lost or had to be concealed.");
 
             this->addHeader(category, "Ping overlay");
             registerSetting(cat, settings.overlay.enabled, "Enabled", "Show a small overlay when in a level, displaying the current latency to the server.");
             registerSetting(cat, settings.overlay.opacity, "Opacity", "Opacity of the displayed overlay.");
             registerSetting(cat, settings.overlay.hideConditionally, "Hide conditionally", "Hide the ping overlay when not connected to a server or in a non-uploaded level, instead of showing a substitute message.");
             registerSetting(cat, settings.overlay.position, "Position", "Position of the overlay on the screen.", Type::Corner);
+            registerSetting(cat, settings.overlay.sendLatency, "Send latency", "Also show how long outgoing packets wait before being sent (median / 99th percentile) and how many position updates are sent per second. Useful for diagnosing network issues.");
         } break;
 
         case TAG_TAB_PLAYERS: {
@@ -271,6 +277,7 @@ void GlobedSettingsLayer::createSettingsCells(int category) {
             registerSetting(cat, settings.players.hideNearby, "Hide nearby players", "Increases the transparency of players as they get closer to you, so that they don't obstruct your view.");
             registerSetting(cat, settings.players.statusIcons, "Status icons", "Show an icon above a player if they are paused, in practice mode, or currently speaking.");
             registerSetting(cat, settings.players.hidePracticePlayers, "Hide players in practice", "Hide players that are in practice mode.");
+            registerSetting(cat, settings.players.iconAtlas, "Icon atlas", "Combines the icons of players in the level into a few big textures, which can improve performance when there are many players with different icons. Uses some extra video memory.");
         } break;
     }
 }
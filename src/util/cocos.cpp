@@ -4,12 +4,17 @@
 #include <managers/settings.hpp>
 #include <hooks/game_manager.hpp>
 #include <util/format.hpp>
+#include <util/texture_cache.hpp>
 #include <util/debug.hpp>
 #include <asp/thread.hpp>
 
 using namespace geode::prelude;
 
-constexpr size_t THREAD_COUNT = 25;
+// decoding is CPU bound, more threads than cores only adds contention.
+// on android reads are serialized anyway, so a few threads are enough to keep the reader busy.
+static size_t preloadThreadCount() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+}
 
 // all of this is needed to disrespect the privacy of ccfileutils
 #include <Geode/modify/CCFileUtils.hpp>
@@ -65,7 +70,7 @@ namespace util::cocos {
 
         void ensurePoolExists() {
             if (!threadPool) {
-                threadPool = std::make_unique<asp::thread::ThreadPool>(THREAD_COUNT);
+                threadPool = std::make_unique<asp::thread::ThreadPool>(preloadThreadCount());
             }
         }
 
@@ -122,7 +127,16 @@ namespace util::cocos {
             idx++;
         }
 
-        state.threadPool = std::make_unique<asp::thread::ThreadPool>(THREAD_COUNT);
+        state.threadPool = std::make_unique<asp::thread::ThreadPool>(preloadThreadCount());
+
+        // cached textures are only valid for the same mod version, texture quality and texture packs
+        std::string fingerprint = fmt::format("{};{}", Mod::get()->getVersion().toString(), (int)state.texQuality);
+        for (const auto& path : CCFileUtils::get()->getSearchPaths()) {
+            fingerprint += ';';
+            fingerprint += std::string_view(path);
+        }
+
+        texcache::init(GlobedSettings::get().globed.textureDiskCache, std::hash<std::string>{}(fingerprint));
 
         log::debug("initialized preload state in {}", util::format::formatDuration(util::time::now() - startTime));
         log::debug("texture quality: {}", state.texQuality == TextureQuality::High ? "High" : (state.texQuality == TextureQuality::Medium ? "Medium" : "Low"));
@@ -131,34 +145,60 @@ namespace util::cocos {
             state.gameSearchPathIdx == -1 ? "<not found>" : HookedFileUtils::get().getSearchPath(state.gameSearchPathIdx));
     }
 
-    void loadAssetsParallel(const std::vector<std::string>& images) {
-        auto& state = getPreloadState();
-        state.ensurePoolExists();
+    // guards the sprite frame cache and the list of loaded frames. on android, also guards reading files
+    static asp::Mutex<> cocosWorkMutex;
+
+    // Time spent in each stage of loading assets, summed over all threads
+    struct AssetLoadTimings {
+        size_t images = 0;
+        size_t fromCache = 0;
+        util::time::micros cacheRead{0};
+        util::time::micros fileRead{0};
+        util::time::micros pngDecode{0};
+        util::time::micros plistLoad{0};
+        util::time::micros cacheWrite{0};
+        util::time::micros upload{0}; // main thread only
+    };
 
-        auto& threadPool = *state.threadPool.get();
+    static asp::Mutex<AssetLoadTimings> loadTimings;
 
-        log::debug("preload: preparing {} textures", images.size());
+    template <typename F>
+    static auto timed(util::time::micros& total, F&& func) {
+        auto start = util::time::now();
+        auto result = func();
+        total += util::time::as<util::time::micros>(util::time::now() - start);
+        return result;
+    }
 
-        static asp::Mutex<> cocosWorkMutex;
+    // Logs the stage timings of all images decoded since the last call
+    static void logLoadTimings(util::time::micros took) {
+        auto t = std::exchange(*loadTimings.lock(), AssetLoadTimings{});
+        if (t.images == 0) return;
 
-        auto textureCache = CCTextureCache::sharedTextureCache();
-        auto sfCache  = CCSpriteFrameCache::sharedSpriteFrameCache();
+        using util::format::formatDuration;
 
-        auto& fileUtils = HookedFileUtils::get();
+        log::debug(
+            "preload: {} images ({} from disk cache) in {} on {} threads; cache read {}, file read {}, png decode {}, plist {}, cache write {}, upload {}",
+            t.images, t.fromCache, formatDuration(took), preloadThreadCount(),
+            formatDuration(t.cacheRead), formatDuration(t.fileRead), formatDuration(t.pngDecode), formatDuration(t.plistLoad), formatDuration(t.cacheWrite),
+            formatDuration(t.upload)
+        );
+    }
 
-        struct ImageLoadState {
-            std::string key;
-            gd::string path;
-            CCTexture2D* texture = nullptr;
-        };
+    struct ImageLoadRequest {
+        std::string key;
+        gd::string path;
+        gd::string plistPath;
+    };
+
+    // Resolves the paths of the images that aren't loaded yet. Must be called on the main thread.
+    static std::vector<ImageLoadRequest> prepareLoadRequests(const std::vector<std::string>& images) {
+        auto textureCache = CCTextureCache::sharedTextureCache();
 
-        asp::Mutex<std::vector<ImageLoadState>> imgStates;
+        std::vector<ImageLoadRequest> requests;
 
-        auto _imguard = imgStates.lock();
         for (const auto& imgkey : images) {
-            auto pathKey = fmt::format("{}.png", imgkey);
-
-            gd::string fullpath = fullPathForFilename(pathKey);
+            gd::string fullpath = fullPathForFilename(fmt::format("{}.png", imgkey));
 
             if (fullpath.empty()) {
                 continue;
@@ -168,247 +208,525 @@ namespace util::cocos {
                 continue;
             }
 
-            _imguard->emplace_back(ImageLoadState {
+            gd::string plistPath = fullPathForFilename(fmt::format("{}.plist", imgkey));
+
+            if (plistPath.empty()) {
+                log::warn("failed to find the plist for {}.", fullpath);
+                continue;
+            }
+
+            requests.emplace_back(ImageLoadRequest {
                 .key = imgkey,
-                .path = fullpath,
-                .texture = nullptr
+                .path = std::move(fullpath),
+                .plistPath = std::move(plistPath),
             });
         }
 
-        size_t imgCount = _imguard->size();
-        _imguard.unlock();
+        return requests;
+    }
 
-        if (imgCount == 0) {
-            log::debug("preload: all textures already loaded, skipping pass");
-            return;
+    /*
+    * Runs the loads started with `loadAssetsAsync`. The images are decoded on the preload thread pool,
+    * and `update` turns them into textures on the main thread, as many as fit into the frame budget.
+    * Not thread safe, except for the decoded images channel.
+    */
+    class AsyncAssetLoader : public CCObject {
+    public:
+        // max time spent creating textures per frame, whatever doesn't fit is done in the next frame.
+        // at least one texture is always created, so a load can't stall.
+        static constexpr auto FRAME_BUDGET = util::time::micros(4000);
+
+        static AsyncAssetLoader& get() {
+            static AsyncAssetLoader instance;
+            return instance;
         }
 
-        log::debug("preload: loading images ({} total)", imgCount);
+        void load(std::vector<ImageLoadRequest> requests, AssetLoadedCallback onLoaded, AssetProgressCallback onProgress) {
+            if (requests.empty()) {
+                if (onProgress) onProgress(AssetLoadProgress { .loaded = 0, .total = 0 });
+                return;
+            }
 
-        asp::Channel<std::pair<size_t, CCImage*>> textureInitRequests;
+            auto& state = getPreloadState();
+            state.ensurePoolExists();
 
-        for (size_t i = 0; i < imgCount; i++) {
-            threadPool.pushTask([i, &fileUtils, &textureInitRequests, &imgStates] {
-                // this is a dangling reference, but we do not modify imgStates in any way, so it's not a big deal.
-                auto& imgState = imgStates.lock()->at(i);
+            uint32_t jobId = nextJobId++;
 
-                // on android, resources are read from the apk file, so it's NOT thread safe. add a lock.
-#ifdef GEODE_IS_ANDROID
-                auto _rguard = cocosWorkMutex.lock();
-#endif
+            jobs.emplace(jobId, Job {
+                .progress = { .loaded = 0, .total = requests.size() },
+                .startedAt = util::time::now(),
+                .onLoaded = std::move(onLoaded),
+                .onProgress = std::move(onProgress),
+            });
 
-                unsigned long filesize = 0;
-                unsigned char* buffer = fileUtils.getFileData(imgState.path.c_str(), "rb", &filesize);
+            for (auto& request : requests) {
+                state.threadPool->pushTask([this, jobId, request = std::move(request)] {
+                    decoded.push(DecodedImage {
+                        .jobId = jobId,
+                        .key = request.key,
+                        .asset = decodeAsset(request.key, request.path, request.plistPath),
+                    });
+                });
+            }
+        }
 
-#ifdef GEODE_IS_ANDROID
-                _rguard.unlock();
-#endif
+        bool isLoading() {
+            return !jobs.empty();
+        }
+
+        // Forgets all loads in progress, must be called when the game reloads its textures
+        void cancel() {
+            jobs.clear();
+        }
+
+    private:
+        struct Job {
+            AssetLoadProgress progress;
+            util::time::time_point startedAt;
+            AssetLoadedCallback onLoaded;
+            AssetProgressCallback onProgress;
+            bool progressed = false;
+        };
+
+        struct DecodedImage {
+            uint32_t jobId;
+            std::string key;
+            std::optional<DecodedAsset> asset;
+        };
+
+        std::unordered_map<uint32_t, Job> jobs;
+        asp::Channel<DecodedImage> decoded;
+        uint32_t nextJobId = 0;
+
+        AsyncAssetLoader() {
+            CCScheduler::get()->scheduleSelector(schedule_selector(AsyncAssetLoader::update), this, 0.f, false);
+        }
+
+        void update(float dt) {
+            if (decoded.empty()) return;
 
-                std::unique_ptr<unsigned char[]> buf(buffer);
+            auto start = util::time::now();
 
-                if (!buffer || filesize == 0) {
-                    log::warn("failed to read image file: {}", imgState.path);
-                    return;
+            do {
+                auto result = decoded.tryPop();
+                if (!result) break;
+
+                auto& image = result.value();
+
+                auto it = jobs.find(image.jobId);
+                if (it == jobs.end()) {
+                    // the load was cancelled
+                    if (image.asset) freeAsset(image.asset.value());
+                    continue;
                 }
 
-                auto* image = new CCImage;
-                if (!image->initWithImageData(buf.get(), filesize, cocos2d::CCImage::kFmtPng)) {
-                    delete image;
-                    log::warn("failed to init image: {}", imgState.path);
-                    return;
+                CCTexture2D* texture = image.asset ? uploadAsset(image.asset.value()) : nullptr;
+
+                auto& job = it->second;
+                job.progress.loaded++;
+                job.progressed = true;
+
+                if (job.onLoaded) job.onLoaded(image.key, texture);
+            } while (util::time::now() - start < FRAME_BUDGET);
+
+            // callbacks can start new loads, so they are called only after we're done with the jobs
+            std::vector<std::pair<AssetProgressCallback, AssetLoadProgress>> progressed;
+
+            for (auto it = jobs.begin(); it != jobs.end();) {
+                auto& job = it->second;
+
+                if (job.progressed) {
+                    job.progressed = false;
+
+                    if (job.progress.finished()) {
+                        logLoadTimings(util::time::as<util::time::micros>(util::time::now() - job.startedAt));
+                        progressed.emplace_back(std::move(job.onProgress), job.progress);
+                        it = jobs.erase(it);
+                        continue;
+                    }
+
+                    progressed.emplace_back(job.onProgress, job.progress);
                 }
 
-                textureInitRequests.push(std::make_pair(i, image));
-            });
+                ++it;
+            }
+
+            for (auto& [callback, progress] : progressed) {
+                if (callback) callback(progress);
+            }
+        }
+    };
+
+    void loadAssetsParallel(const std::vector<std::string>& images) {
+        auto& state = getPreloadState();
+        state.ensurePoolExists();
+
+        auto& threadPool = *state.threadPool.get();
+
+        log::debug("preload: preparing {} textures", images.size());
+
+        auto startTime = util::time::now();
+        auto requests = prepareLoadRequests(images);
+
+        if (requests.empty()) {
+            log::debug("preload: all textures already loaded, skipping pass");
+            return;
         }
 
-        log::debug("preload: initializing gl textures");
+        log::debug("preload: loading images ({} total)", requests.size());
+
+        asp::Channel<DecodedAsset> decoded;
+
+        for (auto& request : requests) {
+            threadPool.pushTask([request = std::move(request), &decoded] {
+                auto asset = decodeAsset(request.key, request.path, request.plistPath);
 
-        // initialize all the textures (must be done on the main thread)
+                if (asset) {
+                    decoded.push(std::move(asset.value()));
+                }
+            });
+        }
+
+        // initialize the textures and add the sprite frames (must be done on the main thread)
         while (true) {
-            if (textureInitRequests.empty()) {
+            if (decoded.empty()) {
                 if (threadPool.isDoingWork()) {
                     std::this_thread::yield();
                     continue;
-                } else if (textureInitRequests.empty()) {
+                } else if (decoded.empty()) {
                     break;
                 }
             }
 
-            auto [idx, image] = textureInitRequests.popNow();
+            auto asset = decoded.popNow();
+            uploadAsset(asset);
+        }
 
-            auto texture = new CCTexture2D;
-            if (!texture->initWithImage(image)) {
-                delete texture;
-                image->release();
-                log::warn("failed to init CCTexture2D: {}", imgStates.lock()->at(idx).path);
-                continue;
+        log::debug("preload: initialized textures and sprite frames. done.");
+        logLoadTimings(util::time::as<util::time::micros>(util::time::now() - startTime));
+    }
+
+    // Parses the sprite frames in the dictionary of a .plist file, the same way `CCSpriteFrameCache` does.
+    // Returns false if the file uses a format or a feature (aliases) that isn't supported here.
+    static bool parseSpriteFrames(CCDictionary* dict, std::vector<SpriteFrameData>& out) {
+        auto* metadataDict = static_cast<CCDictionary*>(dict->objectForKey("metadata"));
+        auto* framesDict = static_cast<CCDictionary*>(dict->objectForKey("frames"));
+
+        if (!framesDict) return false;
+
+        int format = metadataDict ? metadataDict->valueForKey("format")->intValue() : 0;
+        if (format < 1 || format > 3) return false;
+
+        CCDictElement* element;
+        CCDICT_FOREACH(framesDict, element) {
+            auto* frameDict = static_cast<CCDictionary*>(element->getObject());
+            SpriteFrameData& frame = out.emplace_back();
+            frame.name = element->getStrKey();
+
+            if (format == 3) {
+                auto* aliases = static_cast<CCArray*>(frameDict->objectForKey("aliases"));
+                if (aliases && aliases->count() > 0) return false;
+
+                CCRect textureRect = CCRectFromString(frameDict->valueForKey("textureRect")->getCString());
+                frame.origin = textureRect.origin;
+                frame.size = CCSizeFromString(frameDict->valueForKey("spriteSize")->getCString());
+                frame.offset = CCPointFromString(frameDict->valueForKey("spriteOffset")->getCString());
+                frame.sourceSize = CCSizeFromString(frameDict->valueForKey("spriteSourceSize")->getCString());
+                frame.rotated = frameDict->valueForKey("textureRotated")->boolValue();
+            } else {
+                CCRect rect = CCRectFromString(frameDict->valueForKey("frame")->getCString());
+                frame.origin = rect.origin;
+                frame.size = rect.size;
+                frame.offset = CCPointFromString(frameDict->valueForKey("offset")->getCString());
+                frame.sourceSize = CCSizeFromString(frameDict->valueForKey("sourceSize")->getCString());
+                frame.rotated = format == 2 && frameDict->valueForKey("rotated")->boolValue();
             }
+        }
 
-            auto imguard = imgStates.lock();
-            imguard->at(idx).texture = texture;
-            textureCache->m_pTextures->setObject(texture, imguard->at(idx).path);
-            imguard.unlock();
+        return true;
+    }
 
-            texture->release();
-            image->release();
+    struct FileData {
+        std::unique_ptr<unsigned char[]> data;
+        unsigned long size = 0;
+    };
+
+    // I/O stage, reads the png file. On android, files are read from the apk, which is not thread safe.
+    static FileData readImageFile(const gd::string& path) {
+        auto& fileUtils = HookedFileUtils::get();
+
+#ifdef GEODE_IS_ANDROID
+        auto _ = cocosWorkMutex.lock();
+#endif
+
+        FileData file;
+        file.data.reset(fileUtils.getFileData(path.c_str(), "rb", &file.size));
+
+        return file;
+    }
+
+    // I/O stage, reads and parses the plist. The two can't be separated, cocos only parses plists from files.
+    static CCDictionary* loadPlist(const gd::string& plistPath) {
+#ifdef GEODE_IS_ANDROID
+        auto _ = cocosWorkMutex.lock();
+#endif
+
+        return CCDictionary::createWithContentsOfFileThreadSafe(plistPath.c_str());
+    }
+
+    // CPU stage, decodes the png
+    static CCImage* decodeImage(const FileData& file) {
+        auto* image = new CCImage;
+        if (!image->initWithImageData(file.data.get(), file.size, cocos2d::CCImage::kFmtPng)) {
+            delete image;
+            return nullptr;
         }
 
-        log::debug("preload: initialized textures, adding sprite frames");
+        return image;
+    }
 
-        // now, add sprite frames
-        for (size_t i = 0; i < imgCount; i++) {
-            // this is the slow code but is essentially equivalent to the code below
-            // auto imgState = imgStates.lock()->at(i);
-            // auto plistKey = fmt::format("{}.plist", imgState.key);
-            // auto fp = CCFileUtils::sharedFileUtils()->fullPathForFilename(plistKey.c_str(), false);
-            // sfCache->addSpriteFramesWithFile(fp.c_str());
+    std::optional<DecodedAsset> decodeAsset(std::string key, gd::string path, const gd::string& plistPath) {
+        AssetLoadTimings t;
+        t.images = 1;
+
+        auto _ = util::misc::scopeDestructor([&] {
+            auto total = loadTimings.lock();
+            total->images += t.images;
+            total->fromCache += t.fromCache;
+            total->cacheRead += t.cacheRead;
+            total->fileRead += t.fileRead;
+            total->pngDecode += t.pngDecode;
+            total->plistLoad += t.plistLoad;
+            total->cacheWrite += t.cacheWrite;
+        });
 
-            threadPool.pushTask([=, &imgStates] {
-                // this is a dangling reference, but we do not modify imgStates in any way, so it's not a big deal.
-                auto& imgState = imgStates.lock()->at(i);
+        if (auto cached = timed(t.cacheRead, [&] { return texcache::load(path); })) {
+            t.fromCache = 1;
 
-                if (!imgState.texture) return;
+            return DecodedAsset {
+                .key = std::move(key),
+                .path = std::move(path),
+                .image = cached->image,
+                .frames = std::move(cached->frames),
+            };
+        }
 
-                auto plistKey = fmt::format("{}.plist", imgState.key);
+        auto file = timed(t.fileRead, [&] { return readImageFile(path); });
+        if (!file.data || file.size == 0) {
+            log::warn("failed to read image file: {}", path);
+            return std::nullopt;
+        }
 
-                {
-                    auto _ = cocosWorkMutex.lock();
+        auto* image = timed(t.pngDecode, [&] { return decodeImage(file); });
+        if (!image) {
+            log::warn("failed to init image: {}", path);
+            return std::nullopt;
+        }
 
-                    if (static_cast<HookedGameManager*>(GameManager::get())->m_fields->loadedFrames.contains(plistKey)) {
-                        log::debug("already contains, skipping");
-                        return;
-                    }
-                }
+        // not needed anymore, don't hold onto it while the plist loads
+        file.data.reset();
+
+        auto* dict = timed(t.plistLoad, [&] { return loadPlist(plistPath); });
+        if (!dict) {
+            log::warn("failed to find the plist for {}.", path);
+            image->release();
+            return std::nullopt;
+        }
 
-                auto pathsv = std::string_view(imgState.path);
-                std::string fullPlistPath = std::string(pathsv.substr(0, pathsv.find(".png"))) + ".plist";
+        DecodedAsset asset {
+            .key = std::move(key),
+            .path = std::move(path),
+            .image = image,
+        };
 
-                // file reading is not thread safe on android.
+        if (parseSpriteFrames(dict, asset.frames)) {
+            dict->release();
 
-#ifdef GEODE_IS_ANDROID
-                auto _ccdlock = cocosWorkMutex.lock();
-#endif
+            auto start = util::time::now();
+            texcache::store(asset.path, image, asset.frames);
+            t.cacheWrite = util::time::as<util::time::micros>(util::time::now() - start);
+        } else {
+            asset.frames.clear();
+            asset.frameDict = dict;
+        }
 
-                CCDictionary* dict = CCDictionary::createWithContentsOfFileThreadSafe(fullPlistPath.c_str());
-                if (!dict) {
-                    log::debug("dict is nullptr for: {}, trying slower fallback option", fullPlistPath);
-                    gd::string fallbackPath;
-                    {
-#ifndef GEODE_IS_ANDROID
-                        auto _ = cocosWorkMutex.lock();
-#endif
-                        fallbackPath = fullPathForFilename(plistKey.c_str());
-                    }
+        return asset;
+    }
 
-                    log::debug("attempted fallback: {}", fallbackPath);
-                    dict = CCDictionary::createWithContentsOfFileThreadSafe(fallbackPath.c_str());
-                }
+    CCTexture2D* uploadAsset(DecodedAsset& asset) {
+        auto startTime = util::time::now();
 
-                if (!dict) {
-                    log::warn("failed to find the plist for {}.", imgState.path);
+        auto* textureCache = CCTextureCache::sharedTextureCache();
+        auto* sfCache = CCSpriteFrameCache::sharedSpriteFrameCache();
 
-#ifndef GEODE_IS_ANDROID
-                    auto _ = cocosWorkMutex.lock();
-#endif
+        // the game might have loaded the same texture by itself in the meantime
+        auto* texture = static_cast<CCTexture2D*>(textureCache->m_pTextures->objectForKey(asset.path));
 
-                    // remove the texture.
-                    textureCache->m_pTextures->removeObjectForKey(imgState.path);
-                    return;
-                }
+        if (!texture) {
+            texture = new CCTexture2D;
+            if (!texture->initWithImage(asset.image)) {
+                delete texture;
+                log::warn("failed to init CCTexture2D: {}", asset.path);
+                texture = nullptr;
+            } else {
+                textureCache->m_pTextures->setObject(texture, asset.path);
+                texture->release();
+            }
+        }
 
-#ifdef GEODE_IS_ANDROID
-                _ccdlock.unlock();
-#endif
+        if (texture) {
+            auto plistKey = fmt::format("{}.plist", asset.key);
+            auto _ = cocosWorkMutex.lock();
+
+            auto& loadedFrames = static_cast<HookedGameManager*>(GameManager::get())->m_fields->loadedFrames;
+            if (!loadedFrames.contains(plistKey)) {
+                if (asset.frameDict) {
+                    _addSpriteFramesWithDictionary(asset.frameDict, texture);
+                } else {
+                    for (const auto& frame : asset.frames) {
+                        // like CCSpriteFrameCache, never replace existing frames
+                        if (sfCache->spriteFrameByName(frame.name.c_str())) continue;
 
-                {
-                    auto _ = cocosWorkMutex.lock();
+                        CCRect rect(frame.origin.x, frame.origin.y, frame.size.width, frame.size.height);
+                        auto* spriteFrame = CCSpriteFrame::createWithTexture(texture, rect, frame.rotated, frame.offset, frame.sourceSize);
 
-                    _addSpriteFramesWithDictionary(dict, imgState.texture);
-                    static_cast<HookedGameManager*>(GameManager::get())->m_fields->loadedFrames.insert(plistKey);
+                        sfCache->addSpriteFrame(spriteFrame, frame.name.c_str());
+                    }
                 }
 
-                dict->release();
-            });
+                loadedFrames.insert(plistKey);
+            }
         }
 
-        // wait for the creation of sprite frames to finish.
-        threadPool.join();
+        freeAsset(asset);
 
-        log::debug("preload: initialized sprite frames. done.");
+        loadTimings.lock()->upload += util::time::as<util::time::micros>(util::time::now() - startTime);
+
+        return texture;
     }
 
-    void preloadAssets(AssetPreloadStage stage) {
-        using BatchedIconRange = HookedGameManager::BatchedIconRange;
+    void freeAsset(DecodedAsset& asset) {
+        if (asset.image) asset.image->release();
+        if (asset.frameDict) asset.frameDict->release();
 
-        log::debug("preloadAssets stage: {}", (int)stage);
+        asset.image = nullptr;
+        asset.frameDict = nullptr;
+        asset.frames.clear();
+    }
 
-        auto* gm = static_cast<HookedGameManager*>(GameManager::get());
+    using BatchedIconRange = HookedGameManager::BatchedIconRange;
+
+    // Collects the images and the icons that are loaded in the given stage
+    static void collectPreloadAssets(AssetPreloadStage stage, std::vector<std::string>& images, std::vector<BatchedIconRange>& icons) {
+        auto addIcons = [&](IconType type, int startId, int endId) {
+            icons.push_back(BatchedIconRange {
+                .iconType = (int)type,
+                .startId = startId,
+                .endId = endId
+            });
+        };
 
         switch (stage) {
             case AssetPreloadStage::DeathEffect: {
-                std::vector<std::string> images;
-
                 for (size_t i = 1; i < 20; i++) {
-                    auto key = fmt::format("PlayerExplosion_{:02}", i);
-                    images.push_back(key);
+                    images.push_back(fmt::format("PlayerExplosion_{:02}", i));
                 }
-
-                loadAssetsParallel(images);
             } break;
-            case AssetPreloadStage::Cube: gm->loadIconsBatched((int)IconType::Cube, 0, 484); break;
+            case AssetPreloadStage::Cube: addIcons(IconType::Cube, 0, 484); break;
 
             // There are actually 169 ship icons, but for some reason, loading the last icon causes
             // a very strange bug when you have the Default mini icons option enabled.
             // I have no idea how loading a ship icon can cause a ball icon to become a cube,
             // and honestly I don't care enough.
             // https://github.com/dankmeme01/globed2/issues/93
-            case AssetPreloadStage::Ship: gm->loadIconsBatched((int)IconType::Ship, 1, 168); break;
-            case AssetPreloadStage::Ball: gm->loadIconsBatched((int)IconType::Ball, 0, 118); break;
-            case AssetPreloadStage::Ufo: gm->loadIconsBatched((int)IconType::Ufo, 1, 149); break;
-            case AssetPreloadStage::Wave: gm->loadIconsBatched((int)IconType::Wave, 1, 96); break;
+            case AssetPreloadStage::Ship: addIcons(IconType::Ship, 1, 168); break;
+            case AssetPreloadStage::Ball: addIcons(IconType::Ball, 0, 118); break;
+            case AssetPreloadStage::Ufo: addIcons(IconType::Ufo, 1, 149); break;
+            case AssetPreloadStage::Wave: addIcons(IconType::Wave, 1, 96); break;
             case AssetPreloadStage::Other: {
-                std::vector<BatchedIconRange> ranges = {
-                    BatchedIconRange{
-                        .iconType = (int)IconType::Robot,
-                        .startId = 1,
-                        .endId = 68
-                    },
-                    BatchedIconRange{
-                        .iconType = (int)IconType::Spider,
-                        .startId = 1,
-                        .endId = 69
-                    },
-                    BatchedIconRange{
-                        .iconType = (int)IconType::Swing,
-                        .startId = 1,
-                        .endId = 43
-                    },
-                    BatchedIconRange{
-                        .iconType = (int)IconType::Jetpack,
-                        .startId = 1,
-                        .endId = 5
-                    },
-                };
-
-                gm->loadIconsBatched(ranges);
-
+                addIcons(IconType::Robot, 1, 68);
+                addIcons(IconType::Spider, 1, 69);
+                addIcons(IconType::Swing, 1, 43);
+                addIcons(IconType::Jetpack, 1, 5);
             } break;
             case AssetPreloadStage::AllWithoutDeathEffects: [[fallthrough]];
             case AssetPreloadStage::All: {
                 if (stage != AssetPreloadStage::AllWithoutDeathEffects) {
-                    preloadAssets(AssetPreloadStage::DeathEffect);
+                    collectPreloadAssets(AssetPreloadStage::DeathEffect, images, icons);
                 }
-                preloadAssets(AssetPreloadStage::Cube);
-                preloadAssets(AssetPreloadStage::Ship);
-                preloadAssets(AssetPreloadStage::Ball);
-                preloadAssets(AssetPreloadStage::Ufo);
-                preloadAssets(AssetPreloadStage::Wave);
-                preloadAssets(AssetPreloadStage::Other);
+                collectPreloadAssets(AssetPreloadStage::Cube, images, icons);
+                collectPreloadAssets(AssetPreloadStage::Ship, images, icons);
+                collectPreloadAssets(AssetPreloadStage::Ball, images, icons);
+                collectPreloadAssets(AssetPreloadStage::Ufo, images, icons);
+                collectPreloadAssets(AssetPreloadStage::Wave, images, icons);
+                collectPreloadAssets(AssetPreloadStage::Other, images, icons);
             } break;
         }
     }
 
+    void preloadAssets(AssetPreloadStage stage) {
+        log::debug("preloadAssets stage: {}", (int)stage);
+
+        auto* gm = static_cast<HookedGameManager*>(GameManager::get());
+
+        std::vector<std::string> images;
+        std::vector<BatchedIconRange> icons;
+        collectPreloadAssets(stage, images, icons);
+
+        if (!images.empty()) {
+            loadAssetsParallel(images);
+        }
+
+        if (!icons.empty()) {
+            gm->loadIconsBatched(icons);
+        }
+    }
+
+    void loadAssetsAsync(const std::vector<std::string>& images, AssetLoadedCallback onLoaded, AssetProgressCallback onProgress) {
+        AsyncAssetLoader::get().load(prepareLoadRequests(images), std::move(onLoaded), std::move(onProgress));
+    }
+
+    void preloadAssetsAsync(AssetPreloadStage stage, AssetProgressCallback onProgress) {
+        log::debug("preloadAssetsAsync stage: {}", (int)stage);
+
+        auto* gm = static_cast<HookedGameManager*>(GameManager::get());
+
+        std::vector<std::string> images;
+        std::vector<BatchedIconRange> icons;
+        collectPreloadAssets(stage, images, icons);
+
+        // sheet name -> (icon type, icon id)
+        std::unordered_map<std::string, std::pair<int, int>> iconSheets;
+
+        for (const auto& range : icons) {
+            for (int id = range.startId; id <= range.endId; id++) {
+                auto sheetName = gm->sheetNameForIcon(id, range.iconType);
+                if (sheetName.empty()) continue;
+
+                images.push_back(sheetName);
+                iconSheets.emplace(std::move(sheetName), std::make_pair(range.iconType, id));
+            }
+        }
+
+        loadAssetsAsync(images, [iconSheets = std::move(iconSheets)](const std::string& key, CCTexture2D* texture) {
+            auto it = iconSheets.find(key);
+            if (it == iconSheets.end()) return;
+
+            auto [iconType, iconId] = it->second;
+
+            if (!texture) {
+                log::warn("icon failed to preload: type {}, id {}", iconType, iconId);
+                return;
+            }
+
+            static_cast<HookedGameManager*>(GameManager::get())->setCachedIcon(iconId, iconType, texture);
+        }, std::move(onProgress));
+    }
+
+    bool isLoadingAssetsAsync() {
+        return AsyncAssetLoader::get().isLoading();
+    }
+
     bool forcedSkipPreload() {
         auto& settings = GlobedSettings::get();
 
@@ -428,6 +746,11 @@ namespace util::cocos {
 
         auto& settings = GlobedSettings::get();
 
+        // icons are loaded as they are needed instead
+        if (settings.globed.lazyIconLoading) {
+            return false;
+        }
+
         // if we are on the loading screen, only load if not deferred
         if (onLoading) {
             return !settings.globed.deferPreloadAssets;
@@ -458,11 +781,16 @@ namespace util::cocos {
     }
 
     void resetPreloadState() {
+        AsyncAssetLoader::get().cancel();
+
         auto& state = getPreloadState();
         initPreloadState(state);
     }
 
     void cleanupThreadPool() {
+        // still in use, it gets cleaned up once the async loads are done
+        if (isLoadingAssetsAsync()) return;
+
         getPreloadState().destroyPool();
     }
 
@@ -1,5 +1,9 @@
 #pragma once
 #include <cocos2d.h>
+#include <functional>
+#include <optional>
+
+#include <util/texture_cache.hpp>
 
 namespace util::cocos {
     // Loads the given images in separate threads, in parallel. Blocks the thread until all images have been loaded.
@@ -20,6 +24,54 @@ namespace util::cocos {
 
     void preloadAssets(AssetPreloadStage stage);
 
+    struct AssetLoadProgress {
+        size_t loaded; // includes images that failed to load
+        size_t total;
+
+        bool finished() const {
+            return loaded == total;
+        }
+    };
+
+    // Called for every image of an async load, with the created texture or nullptr if it failed to load
+    using AssetLoadedCallback = std::function<void(const std::string& key, cocos2d::CCTexture2D* texture)>;
+    // Called after every frame in which an async load made progress, the last call has `progress.finished() == true`
+    using AssetProgressCallback = std::function<void(AssetLoadProgress progress)>;
+
+    // Like `loadAssetsParallel`, but doesn't block. The images are decoded on the preload thread pool,
+    // while the textures are created and the sprite frames added on the main thread, a few every frame within a time budget.
+    // All callbacks are called on the main thread. If there is nothing to load, `onProgress` is called immediately.
+    void loadAssetsAsync(const std::vector<std::string>& images, AssetLoadedCallback onLoaded, AssetProgressCallback onProgress);
+
+    // Like `preloadAssets`, but doesn't block, see `loadAssetsAsync`
+    void preloadAssetsAsync(AssetPreloadStage stage, AssetProgressCallback onProgress);
+
+    // Whether any async loads are still in progress
+    bool isLoadingAssetsAsync();
+
+    // An image with its sprite frames, read and decoded by `decodeAsset`, ready to be passed to `uploadAsset`
+    struct DecodedAsset {
+        std::string key;
+        gd::string path;
+        cocos2d::CCImage* image = nullptr;
+        // if the sprite frames couldn't be parsed, `frameDict` holds the contents of the .plist instead
+        std::vector<SpriteFrameData> frames;
+        cocos2d::CCDictionary* frameDict = nullptr;
+    };
+
+    // Reads and decodes the image and the sprite frames of `key`, given the full paths of its .png and .plist files.
+    // Uses the texture disk cache if possible. Can be called from any thread,
+    // but the paths must be resolved on the main thread with `fullPathForFilename`.
+    // Returns `std::nullopt` if either file failed to load.
+    std::optional<DecodedAsset> decodeAsset(std::string key, gd::string path, const gd::string& plistPath);
+
+    // Creates the texture of a decoded asset and adds its sprite frames. Must be called on the main thread.
+    // Frees the decoded data. Returns the texture, or nullptr if it could not be created.
+    cocos2d::CCTexture2D* uploadAsset(DecodedAsset& asset);
+
+    // Frees the decoded data of an asset that won't be uploaded
+    void freeAsset(DecodedAsset& asset);
+
     bool forcedSkipPreload();
     bool shouldTryToPreload(bool onLoading);
 
@@ -1,4 +1,9 @@
 #pragma once
+#include <atomic>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
 #include <vector>
 #include <queue>
 #include <map>
@@ -64,6 +69,137 @@ protected:
     std::queue<T> queue;
 };
 
+/*
+* SpscQueue is a fixed-capacity lock-free ring buffer for exactly one producer thread and one consumer thread.
+* Neither side ever blocks or allocates, elements that don't fit are rejected by `push`.
+* Moving is not thread-safe and must only be done when neither side is in use.
+*/
+
+template <typename T> requires std::is_trivially_copyable_v<T>
+class SpscQueue {
+public:
+    // capacity is rounded up to a power of two
+    SpscQueue(size_t capacity) : capacity_(std::bit_ceil(std::max<size_t>(capacity, 1))), storage(new T[capacity_]) {}
+    SpscQueue() : SpscQueue(1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    SpscQueue(SpscQueue&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    SpscQueue& operator=(SpscQueue&& other) noexcept {
+        if (this != &other) {
+            capacity_ = other.capacity_;
+            storage = std::move(other.storage);
+            head.store(other.head.load(std::memory_order::relaxed), std::memory_order::relaxed);
+            tail.store(other.tail.load(std::memory_order::relaxed), std::memory_order::relaxed);
+            producerHead = other.producerHead;
+            consumerTail = other.consumerTail;
+
+            other.capacity_ = 0;
+            other.head.store(0, std::memory_order::relaxed);
+            other.tail.store(0, std::memory_order::relaxed);
+            other.producerHead = other.consumerTail = 0;
+        }
+
+        return *this;
+    }
+
+    // Producer side. Pushes as many elements as there is room for and returns the amount.
+    size_t push(const T* data, size_t count) {
+        size_t t = tail.load(std::memory_order::relaxed);
+
+        // only reload the consumer position if our cached one says we are out of room
+        if (capacity_ - (t - producerHead) < count) {
+            producerHead = head.load(std::memory_order::acquire);
+        }
+
+        size_t n = std::min(count, capacity_ - (t - producerHead));
+        if (n == 0) return 0;
+
+        size_t idx = t & (capacity_ - 1);
+        size_t first = std::min(n, capacity_ - idx);
+
+        std::memcpy(storage.get() + idx, data, first * sizeof(T));
+        std::memcpy(storage.get(), data + first, (n - first) * sizeof(T));
+
+        tail.store(t + n, std::memory_order::release);
+        return n;
+    }
+
+    bool push(const T& value) {
+        return this->push(&value, 1) == 1;
+    }
+
+    // Consumer side. Pops up to `count` elements into `dest` and returns the amount.
+    size_t pop(T* dest, size_t count) {
+        size_t h = head.load(std::memory_order::relaxed);
+
+        if (consumerTail - h < count) {
+            consumerTail = tail.load(std::memory_order::acquire);
+        }
+
+        size_t n = std::min(count, consumerTail - h);
+        if (n == 0) return 0;
+
+        size_t idx = h & (capacity_ - 1);
+        size_t first = std::min(n, capacity_ - idx);
+
+        std::memcpy(dest, storage.get() + idx, first * sizeof(T));
+        std::memcpy(dest + first, storage.get(), (n - first) * sizeof(T));
+
+        head.store(h + n, std::memory_order::release);
+        return n;
+    }
+
+    // Consumer side. Discards up to `count` of the oldest elements and returns the amount.
+    size_t skip(size_t count) {
+        size_t h = head.load(std::memory_order::relaxed);
+
+        if (consumerTail - h < count) {
+            consumerTail = tail.load(std::memory_order::acquire);
+        }
+
+        size_t n = std::min(count, consumerTail - h);
+        head.store(h + n, std::memory_order::release);
+        return n;
+    }
+
+    // Consumer side. Discards everything that is currently in the queue.
+    void clear() {
+        consumerTail = tail.load(std::memory_order::acquire);
+        head.store(consumerTail, std::memory_order::release);
+    }
+
+    // Safe to call from either side, but the result may already be outdated.
+    size_t size() const {
+        // head must be loaded first, otherwise it could get ahead of the loaded tail
+        size_t h = head.load(std::memory_order::acquire);
+        return tail.load(std::memory_order::acquire) - h;
+    }
+
+    bool empty() const {
+        return this->size() == 0;
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    size_t capacity_;
+    std::unique_ptr<T[]> storage;
+
+    // the positions only ever grow, they are wrapped when indexing. each side owns one and caches the other,
+    // and they are kept on separate cache lines so the two threads don't invalidate each other's caches.
+    alignas(64) std::atomic<size_t> head = 0; // written by the consumer
+    size_t consumerTail = 0;
+    alignas(64) std::atomic<size_t> tail = 0; // written by the producer
+    size_t producerHead = 0;
+};
+
 // i dont know if this works at all
 template <typename T, size_t N> requires std::is_move_constructible_v<T>
 class SmallVector {
@@ -85,6 +85,15 @@ namespace util::debug {
             );
             log::debug("Average bytes per packet: {}", format::formatBytes((uint64_t)bytesPerPacket));
 
+            if (playerDataEntries > 0) {
+                log::debug(
+                    "Player data: {} for {} players, average {:.2f} bytes per player",
+                    format::formatBytes(playerDataBytes),
+                    playerDataEntries,
+                    bytesPerPlayer
+                );
+            }
+
             // sort packets by the counts
             std::vector<std::pair<packetid_t, size_t>> pc(packetCounts.begin(), packetCounts.end());
             std::sort(pc.begin(), pc.end(), [](const auto& a, const auto& b) {
@@ -97,7 +106,7 @@ namespace util::debug {
         }
         log::debug("==== Packet summary end ====");
     }
-    void PacketLogger::record(packetid_t id, bool encrypted, bool outgoing, size_t bytes) {
+    void PacketLogger::record(packetid_t id, bool encrypted, bool outgoing, size_t bytes, size_t players) {
 #ifdef GLOBED_DEBUG_PACKETS
 # ifdef GLOBED_DEBUG_PACKETS_PRINT
         log::debug("{} packet {}, encrypted: {}, bytes: {}", outgoing ? "Sending" : "Receiving", id, encrypted ? "true" : "false", bytes);
@@ -106,7 +115,8 @@ namespace util::debug {
             .id = id,
             .encrypted = encrypted,
             .outgoing = outgoing,
-            .bytes = bytes
+            .bytes = bytes,
+            .players = players
         });
 #endif // GLOBED_DEBUG_PACKETS
     }
@@ -133,9 +143,15 @@ namespace util::debug {
             }
 
             summary.packetCounts[log.id]++;
+
+            if (log.players > 0) {
+                summary.playerDataBytes += log.bytes;
+                summary.playerDataEntries += log.players;
+            }
         }
 
         summary.bytesPerPacket = (float)summary.totalBytes / summary.total;
+        summary.bytesPerPlayer = summary.playerDataEntries == 0 ? 0.f : (float)summary.playerDataBytes / summary.playerDataEntries;
         summary.encryptedRatio = (float)summary.totalEncrypted / summary.total;
 
         return summary;
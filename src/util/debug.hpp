@@ -59,6 +59,7 @@ namespace util::debug {
         bool encrypted;
         bool outgoing;
         size_t bytes;
+        size_t players; // amount of players whose data is in the packet, 0 if not a level data packet
     };
 
     struct PacketLogSummary {
@@ -76,7 +77,11 @@ namespace util::debug {
 
         std::unordered_map<packetid_t, size_t> packetCounts;
 
+        uint64_t playerDataBytes;   // total bytes of packets carrying data of other players
+        size_t playerDataEntries;   // total amount of players in those packets
+
         float bytesPerPacket;
+        float bytesPerPlayer;
         float encryptedRatio;
 
         void print();
@@ -84,7 +89,7 @@ namespace util::debug {
 
     class PacketLogger : public SingletonBase<PacketLogger> {
     public:
-        void record(packetid_t id, bool encrypted, bool outgoing, size_t bytes);
+        void record(packetid_t id, bool encrypted, bool outgoing, size_t bytes, size_t players = 0);
         PacketLogSummary getSummary();
     private:
         collections::CappedQueue<PacketLog, 25000> queue;
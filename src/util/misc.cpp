@@ -7,12 +7,6 @@
 #include <util/lowlevel.hpp>
 
 namespace util::misc {
-    bool swapFlag(bool& target) {
-        bool state = target;
-        target = false;
-        return state;
-    }
-
     // IconType -> PlayerIconType
     template<> PlayerIconType convertEnum<PlayerIconType, IconType>(IconType value) {
         switch (value) {
@@ -76,6 +70,18 @@ namespace util::misc {
         return static_cast<float>(sum / static_cast<double>(samples));
     }
 
+    void pcmMixSlow(float* dest, const float* src, size_t samples, float gain) {
+        for (size_t i = 0; i < samples; i++) {
+            dest[i] += src[i] * gain;
+        }
+    }
+
+    void evalCubicSlow(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = ((c3[i] * t[i] + c2[i]) * t[i] + c1[i]) * t[i] + c0[i];
+        }
+    }
+
     bool compareName(const std::string_view nv1, const std::string_view nv2) {
         std::string name1(nv1);
         std::string name2(nv2);
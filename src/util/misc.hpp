@@ -86,7 +86,11 @@ namespace util::misc {
     struct IsEither<Either<T, Y>> : std::true_type {};
 
     // If `target` is false, returns false. If `target` is true, modifies `target` to false and returns true.
-    bool swapFlag(bool& target);
+    inline bool swapFlag(bool& target) {
+        bool state = target;
+        target = false;
+        return state;
+    }
 
     // Like `swapFlag` but for optional types
     template <typename T>
@@ -135,6 +139,10 @@ namespace util::misc {
 
     float pcmVolumeSlow(const float* pcm, size_t samples);
 
+    void pcmMixSlow(float* dest, const float* src, size_t samples, float gain);
+
+    void evalCubicSlow(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count);
+
     bool compareName(const std::string_view name1, const std::string_view name2);
 
     bool isEditorCollabLevel(LevelId levelId);
@@ -5,5 +5,11 @@
 namespace util::simd {
     float calcPcmVolume(const float* pcm, size_t samples);
 
+    // dest[i] += src[i] * gain
+    void mixPcm(float* dest, const float* src, size_t samples, float gain);
+
+    // out[i] = c0[i] + c1[i] * t[i] + c2[i] * t[i]^2 + c3[i] * t[i]^3
+    void evalCubic(float* out, const float* c0, const float* c1, const float* c2, const float* c3, const float* t, size_t count);
+
     uint32_t adler32(const uint8_t* data, size_t len);
 }
\ No newline at end of file
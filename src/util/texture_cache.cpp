@@ -0,0 +1,267 @@
+#include "texture_cache.hpp"
+
+#include <asp/sync.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace geode::prelude;
+
+namespace util::texcache {
+    constexpr uint32_t MAGIC = 0x31435447; // "GTC1"
+    constexpr uint16_t VERSION = 1;
+
+    namespace {
+        struct CacheConfig {
+            bool enabled = false;
+            uint64_t fingerprint = 0;
+            std::filesystem::path dir;
+        };
+
+        struct CacheState {
+            // `init` can run while pool workers are still loading, so they take a copy of the config under the lock
+            asp::Mutex<CacheConfig> config;
+            std::atomic_size_t size = 0;
+            std::atomic_size_t tempCounter = 0;
+        };
+
+        CacheState state;
+
+        // CCImage has no setter for this, and raw image data is always assumed to not be premultiplied
+        class RawImage : public CCImage {
+        public:
+            void setPremultipliedAlpha(bool state) {
+                m_bPreMulti = state;
+            }
+        };
+    }
+
+    static std::filesystem::path pathForEntry(const CacheConfig& config, const gd::string& path) {
+        return config.dir / fmt::format("{:016x}.bin", std::hash<std::string_view>{}(std::string_view(path)));
+    }
+
+    static CacheConfig getConfig() {
+        return *state.config.lock();
+    }
+
+    void init(bool enabled, uint64_t fingerprint) {
+        auto dir = Mod::get()->getSaveDir() / "texture-cache";
+
+        // workers see the cache as disabled until it's set up, so they don't touch files we are about to delete
+        *state.config.lock() = CacheConfig {
+            .enabled = false,
+            .fingerprint = fingerprint,
+            .dir = dir,
+        };
+        state.size = 0;
+
+        if (!enabled) return;
+
+        auto fingerprintPath = dir / "fingerprint";
+
+        uint64_t lastFingerprint = 0;
+        if (std::ifstream file(fingerprintPath); file) {
+            file >> std::hex >> lastFingerprint;
+        }
+
+        std::error_code ec;
+
+        if (lastFingerprint != fingerprint) {
+            log::info("Texture cache fingerprint changed, clearing the cache");
+
+            std::filesystem::remove_all(dir, ec);
+            std::filesystem::create_directories(dir, ec);
+
+            std::ofstream file(fingerprintPath);
+            file << std::hex << fingerprint;
+        } else {
+            size_t size = 0;
+            for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+                // leftovers of a store that never finished
+                if (entry.path().extension() == ".tmp") {
+                    std::filesystem::remove(entry.path(), ec);
+                    continue;
+                }
+
+                size += entry.file_size(ec);
+            }
+
+            state.size = size;
+
+            log::debug("texture cache size: {} KiB", size / 1024);
+        }
+
+        state.config.lock()->enabled = true;
+    }
+
+    bool isEnabled() {
+        return state.config.lock()->enabled;
+    }
+
+    // Transparent pixels are common in sprite sheets, so the pixels are stored as runs:
+    // amount of fully transparent pixels, amount of other pixels, and then the other pixels themselves.
+
+    static void writePixels(ByteBuffer& buf, const uint32_t* pixels, size_t count) {
+        size_t i = 0;
+
+        while (i < count) {
+            size_t transparent = 0;
+            while (i + transparent < count && pixels[i + transparent] == 0) transparent++;
+            i += transparent;
+
+            size_t opaque = 0;
+            while (i + opaque < count && pixels[i + opaque] != 0) opaque++;
+
+            buf.writeU32(transparent);
+            buf.writeU32(opaque);
+
+            size_t pos = buf.getPosition();
+            buf.grow(opaque * 4);
+            std::memcpy(buf.rawData() + pos, pixels + i, opaque * 4);
+            buf.setPosition(pos + opaque * 4);
+
+            i += opaque;
+        }
+    }
+
+    static ByteBuffer::DecodeResult<> readPixels(ByteBuffer& buf, uint8_t* out, size_t count) {
+        size_t i = 0;
+
+        while (i < count) {
+            GLOBED_UNWRAP_INTO(buf.readU32(), uint32_t transparent);
+            GLOBED_UNWRAP_INTO(buf.readU32(), uint32_t opaque);
+
+            if (i + transparent + opaque > count) {
+                return Err(ByteBuffer::DecodeError::DataTooLong);
+            }
+
+            // `out` is zeroed already
+            i += transparent;
+
+            GLOBED_UNWRAP(buf.readBytesInto(out + i * 4, opaque * 4));
+            i += opaque;
+        }
+
+        return Ok();
+    }
+
+    struct EntryHeader {
+        uint32_t width;
+        uint32_t height;
+        bool premultiplied;
+    };
+
+    static ByteBuffer::DecodeResult<EntryHeader> readHeader(ByteBuffer& buf, uint64_t expectedFingerprint, const gd::string& path) {
+        GLOBED_UNWRAP_INTO(buf.readU32(), uint32_t magic);
+        GLOBED_UNWRAP_INTO(buf.readU16(), uint16_t version);
+        GLOBED_UNWRAP_INTO(buf.readU64(), uint64_t fingerprint);
+        GLOBED_UNWRAP_INTO(buf.readValue<std::string>(), std::string sourcePath);
+
+        // outdated entries and different files with the same hash are treated like missing ones
+        if (magic != MAGIC || version != VERSION || fingerprint != expectedFingerprint || sourcePath != std::string_view(path)) {
+            return Err(ByteBuffer::DecodeError::InvalidEnumValue);
+        }
+
+        EntryHeader header;
+        GLOBED_UNWRAP_INTO(buf.readU32(), header.width);
+        GLOBED_UNWRAP_INTO(buf.readU32(), header.height);
+        GLOBED_UNWRAP_INTO(buf.readBool(), header.premultiplied);
+
+        return Ok(header);
+    }
+
+    std::optional<CachedImage> load(const gd::string& path) {
+        auto config = getConfig();
+        if (!config.enabled) return std::nullopt;
+
+        std::ifstream file(pathForEntry(config, path), std::ios::binary | std::ios::ate);
+        if (!file) return std::nullopt;
+
+        util::data::bytevector data(file.tellg());
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(data.data()), data.size())) return std::nullopt;
+
+        ByteBuffer buf(std::move(data));
+
+        auto header = readHeader(buf, config.fingerprint, path);
+        if (!header) return std::nullopt;
+
+        auto [width, height, premultiplied] = header.unwrap();
+
+        // bigger than any texture the game could load, the file must be corrupted
+        if (width > 16384 || height > 16384) return std::nullopt;
+
+        auto frames = buf.readValue<std::vector<SpriteFrameData>>();
+        if (!frames) return std::nullopt;
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+        if (!readPixels(buf, pixels.data(), static_cast<size_t>(width) * height)) {
+            log::warn("corrupted texture cache entry for {}", path);
+            return std::nullopt;
+        }
+
+        auto* image = new RawImage;
+        if (!image->initWithImageData(pixels.data(), pixels.size(), CCImage::kFmtRawData, width, height, 8)) {
+            delete image;
+            return std::nullopt;
+        }
+
+        image->setPremultipliedAlpha(premultiplied);
+
+        return CachedImage {
+            .image = image,
+            .frames = std::move(frames.unwrap()),
+        };
+    }
+
+    void store(const gd::string& path, CCImage* image, const std::vector<SpriteFrameData>& frames) {
+        auto config = getConfig();
+        if (!config.enabled) return;
+
+        // only 8-bit RGBA is cached, which is what every sprite sheet in the game is
+        if (!image->hasAlpha() || image->getBitsPerComponent() != 8) return;
+
+        size_t pixelCount = static_cast<size_t>(image->getWidth()) * image->getHeight();
+        if (state.size + pixelCount * 4 > MAX_SIZE) return;
+
+        ByteBuffer buf;
+        buf.writeU32(MAGIC);
+        buf.writeU16(VERSION);
+        buf.writeU64(config.fingerprint);
+        buf.writeValue(std::string(path));
+        buf.writeU32(image->getWidth());
+        buf.writeU32(image->getHeight());
+        buf.writeBool(image->isPremultipliedAlpha());
+        buf.writeValue(frames);
+
+        writePixels(buf, reinterpret_cast<const uint32_t*>(image->getData()), pixelCount);
+
+        // write into a temporary file first and move it into place once complete, so that a crash
+        // or a concurrent `load` never sees a truncated entry. each store gets its own temporary file
+        auto entryPath = pathForEntry(config, path);
+        auto tempPath = entryPath;
+        tempPath += fmt::format(".{}.tmp", state.tempCounter++);
+
+        {
+            std::ofstream file(tempPath, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(buf.data().data()), buf.size());
+            file.close();
+
+            if (!file) {
+                std::error_code ec;
+                std::filesystem::remove(tempPath, ec);
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, entryPath, ec);
+
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+
+        state.size += buf.size();
+    }
+}
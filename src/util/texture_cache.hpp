@@ -0,0 +1,47 @@
+#pragma once
+#include <defs/geode.hpp>
+
+#include <optional>
+
+#include <data/bytebuffer.hpp>
+
+// Sprite frame as described in a .plist file, in the same units cocos uses when creating the frame
+struct SpriteFrameData {
+    std::string name;
+    cocos2d::CCPoint origin;
+    cocos2d::CCSize size;
+    cocos2d::CCPoint offset;
+    cocos2d::CCSize sourceSize;
+    bool rotated;
+};
+
+GLOBED_SERIALIZABLE_STRUCT(SpriteFrameData, (name, origin, size, offset, sourceSize, rotated));
+
+/*
+* On-disk cache of decoded images together with their sprite frames, stored in the save directory of the mod.
+* Loading an image from it skips decoding the png and parsing the plist, the pixels only have to be copied.
+*
+* Every file is tagged with a fingerprint of the search paths, texture packs and texture quality.
+* When the fingerprint changes (i.e. a texture pack was added), the whole cache is thrown away.
+*/
+namespace util::texcache {
+    // the cache stops growing once it's this big
+    constexpr size_t MAX_SIZE = 256 * 1024 * 1024;
+
+    struct CachedImage {
+        cocos2d::CCImage* image;
+        std::vector<SpriteFrameData> frames;
+    };
+
+    // Sets up the cache for the given fingerprint, clearing it if the fingerprint is different from last time.
+    // Must be called on the main thread. Loads and stores that run at the same time see the cache as disabled.
+    void init(bool enabled, uint64_t fingerprint);
+
+    bool isEnabled();
+
+    // Loads the image at `path` from the cache, if it's there. Thread safe.
+    std::optional<CachedImage> load(const gd::string& path);
+
+    // Stores the decoded image and its sprite frames in the cache. Thread safe.
+    void store(const gd::string& path, cocos2d::CCImage* image, const std::vector<SpriteFrameData>& frames);
+}